@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""
+Converts a compressed ULog file (.ulgz, written by the logger with SDLOG_COMPRESS enabled) back to a .ulg file.
+
+The file consists of a header followed by independent blocks, each with its own header containing the
+block's offset in the decompressed file. Decompression continues after corrupted blocks by searching for
+the next block sync marker, the missing data is then reported.
+"""
+
+import argparse
+import struct
+import sys
+
+FILE_MAGIC = b'ULogLZ4'
+FILE_HEADER = struct.Struct('<7sBI')
+BLOCK_MAGIC = b'ULZB'
+BLOCK_HEADER = struct.Struct('<4sB3xIIQ')
+
+BLOCK_STORED = 0
+BLOCK_LZ4 = 1
+
+
+def lz4_block_decompress(src: bytes, uncompressed_size: int) -> bytes:
+    """ decompress data in the LZ4 block format """
+    dst = bytearray()
+    i = 0
+    n = len(src)
+
+    while i < n:
+        token = src[i]
+        i += 1
+
+        # literals
+        literal_length = token >> 4
+        if literal_length == 15:
+            while True:
+                b = src[i]
+                i += 1
+                literal_length += b
+                if b != 255:
+                    break
+        dst += src[i:i + literal_length]
+        i += literal_length
+
+        if i >= n:
+            break  # last sequence has no match
+
+        # match
+        offset = src[i] | (src[i + 1] << 8)
+        i += 2
+        match_length = token & 0xf
+        if match_length == 15:
+            while True:
+                b = src[i]
+                i += 1
+                match_length += b
+                if b != 255:
+                    break
+        match_length += 4
+
+        if offset == 0 or offset > len(dst):
+            raise ValueError('invalid match offset')
+
+        start = len(dst) - offset
+        if offset >= match_length:
+            dst += dst[start:start + match_length]
+        else:
+            # overlapping match
+            for k in range(match_length):
+                dst.append(dst[start + k])
+
+    if len(dst) != uncompressed_size:
+        raise ValueError('size mismatch')
+
+    return bytes(dst)
+
+
+def read_blocks(data: bytes):
+    """
+    iterate over the blocks of a compressed file
+    :return: generator of (file offset, block header tuple, block data)
+    """
+    if len(data) < FILE_HEADER.size or not data.startswith(FILE_MAGIC):
+        raise ValueError('not a compressed ULog file')
+
+    pos = FILE_HEADER.size
+
+    while pos + BLOCK_HEADER.size <= len(data):
+        header = BLOCK_HEADER.unpack_from(data, pos)
+        magic, block_type, compressed_size, uncompressed_size, uncompressed_offset = header
+        end = pos + BLOCK_HEADER.size + compressed_size
+
+        if magic != BLOCK_MAGIC or end > len(data):
+            # corrupted or truncated: resync on the next block marker
+            next_pos = data.find(BLOCK_MAGIC, pos + 1)
+            if next_pos < 0:
+                return
+            print('skipping {:d} corrupted bytes at offset {:d}'.format(next_pos - pos, pos))
+            pos = next_pos
+            continue
+
+        yield pos, header, data[pos + BLOCK_HEADER.size:end]
+        pos = end
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description='Decompress a compressed ULog file (.ulgz)')
+    parser.add_argument('ulog_file', help='.ulgz file')
+    parser.add_argument('-o', '--output', type=str, default=None,
+                        help='output file (default: input file name without the trailing \'z\')')
+    parser.add_argument('--list', action='store_true', help='only list the blocks')
+    args = parser.parse_args()
+
+    with open(args.ulog_file, 'rb') as f:
+        data = f.read()
+
+    try:
+        _, version, _ = FILE_HEADER.unpack_from(data, 0)
+        if not data.startswith(FILE_MAGIC) or version != 1:
+            raise ValueError()
+    except (struct.error, ValueError):
+        print('{:s}: not a compressed ULog file (version 1)'.format(args.ulog_file))
+        sys.exit(1)
+
+    if args.list:
+        print('{:>12s} {:>6s} {:>10s} {:>12s} {:>16s}'.format('file offset', 'type', 'size', 'uncompressed',
+                                                            'ulog offset'))
+        for pos, header, _ in read_blocks(data):
+            _, block_type, compressed_size, uncompressed_size, uncompressed_offset = header
+            print('{:12d} {:>6s} {:10d} {:12d} {:16d}'.format(pos, 'lz4' if block_type == BLOCK_LZ4 else 'stored',
+                                                            compressed_size, uncompressed_size,
+                                                            uncompressed_offset))
+        return
+
+    output_file = args.output
+    if output_file is None:
+        output_file = args.ulog_file[:-1] if args.ulog_file.endswith('z') else args.ulog_file + '.ulg'
+
+    num_errors = 0
+    expected_offset = 0
+
+    with open(output_file, 'wb') as out:
+        for pos, header, block in read_blocks(data):
+            _, block_type, compressed_size, uncompressed_size, uncompressed_offset = header
+
+            if uncompressed_offset != expected_offset:
+                print('missing {:d} bytes at ulog offset {:d}'.format(uncompressed_offset - expected_offset,
+                                                                     expected_offset))
+                num_errors += 1
+
+            expected_offset = uncompressed_offset + uncompressed_size
+
+            try:
+                if block_type == BLOCK_LZ4:
+                    out.write(lz4_block_decompress(block, uncompressed_size))
+                elif block_type == BLOCK_STORED:
+                    out.write(block)
+                else:
+                    raise ValueError('unknown block type {:d}'.format(block_type))
+            except (IndexError, ValueError) as e:
+                print('block at offset {:d}: {:s}'.format(pos, str(e)))
+                num_errors += 1
+
+        print('wrote {:s} ({:d} bytes)'.format(output_file, out.tell()))
+
+    if num_errors > 0:
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
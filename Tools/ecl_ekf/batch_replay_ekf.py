@@ -0,0 +1,162 @@
+#! /usr/bin/env python3
+"""
+Replays the .ulg files in the supplied directory through EKF2 as fast as possible, running several replays in
+parallel. Each log is replayed by a separate px4 process (built with 'make px4_sitl_replay') in its own working
+directory. A summary with the run time and the innovation test ratios of each log is written to summary.csv in the
+output directory.
+"""
+# -*- coding: utf-8 -*-
+
+import argparse
+import concurrent.futures
+import csv
+import glob
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+
+def get_arguments():
+    parser = argparse.ArgumentParser(description='Replay the .ulg files in the specified directory through EKF2')
+    parser.add_argument("directory_path")
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(),
+                        help='Number of replays to run in parallel (default: number of CPUs).')
+    parser.add_argument('-b', '--build-dir', type=str, default=None,
+                        help='PX4 replay build directory (default: build/px4_sitl_replay).')
+    parser.add_argument('-o', '--output-dir', type=str, default=None,
+                        help='Directory for the per-log working directories and the summary '
+                             '(default: <directory_path>/replay).')
+    parser.add_argument('--log', action='store_true',
+                        help='Whether to also write the replayed .ulg file for each log (slower).')
+    parser.add_argument('--timeout', type=float, default=3600.,
+                        help='Timeout for a single replay in seconds.')
+    return parser.parse_args()
+
+
+def replay_log(px4_binary: str, etc_dir: str, ulog_file: str, working_dir: str, instance: int, log: bool,
+               timeout: float) -> dict:
+    """
+    replays a single log file and returns its summary row
+    :param px4_binary:
+    :param etc_dir:
+    :param ulog_file:
+    :param working_dir:
+    :param instance: px4 instance id, must be unique across the concurrently running replays
+    :param log:
+    :param timeout:
+    :return:
+    """
+    if os.path.exists(working_dir):
+        shutil.rmtree(working_dir)
+    os.makedirs(working_dir)
+
+    summary_file = os.path.join(working_dir, 'summary.csv')
+
+    env = os.environ.copy()
+    env['replay'] = ulog_file
+    env['replay_mode'] = 'ekf2'
+    env['replay_summary'] = summary_file
+    env['replay_log'] = '1' if log else '0'
+
+    start = time.monotonic()
+
+    with open(os.path.join(working_dir, 'out.log'), 'w') as out:
+        try:
+            subprocess.run([px4_binary, '-d', '-i', str(instance), etc_dir], cwd=working_dir, env=env,
+                           stdout=out, stderr=subprocess.STDOUT, stdin=subprocess.DEVNULL, timeout=timeout)
+        except subprocess.TimeoutExpired:
+            pass
+
+    run_time = time.monotonic() - start
+
+    try:
+        with open(summary_file, 'r') as file:
+            rows = list(csv.DictReader(file))
+    except FileNotFoundError:
+        rows = []
+
+    if len(rows) == 0:
+        return {'log': ulog_file, 'process_time_s': '{:.3f}'.format(run_time), 'status': 'failed'}
+
+    row = rows[-1]
+    row['log'] = ulog_file
+    row['process_time_s'] = '{:.3f}'.format(run_time)
+    row['status'] = 'ok'
+    return row
+
+
+def main() -> None:
+
+    args = get_arguments()
+
+    if args.build_dir is not None:
+        build_dir = os.path.realpath(args.build_dir)
+    else:
+        file_dir = os.path.realpath(os.path.join(os.getcwd(), os.path.dirname(__file__)))
+        build_dir = os.path.realpath(os.path.join(file_dir, '../../build/px4_sitl_replay'))
+
+    px4_binary = os.path.join(build_dir, 'bin', 'px4')
+    etc_dir = os.path.join(build_dir, 'etc')
+
+    if not os.path.isfile(px4_binary):
+        print('{:s} not found, build it first with \'make px4_sitl_replay\''.format(px4_binary))
+        sys.exit(1)
+
+    ulog_directory = os.path.realpath(args.directory_path)
+    output_dir = os.path.realpath(args.output_dir) if args.output_dir is not None else \
+        os.path.join(ulog_directory, 'replay')
+
+    # get all the ulog files found in the specified directory and in subdirectories, except the replayed ones
+    ulog_files = sorted(f for f in glob.glob(os.path.join(ulog_directory, '**/*.ulg'), recursive=True)
+                        if not f.startswith(output_dir + os.sep))
+    n_files = len(ulog_files)
+    print("replaying {:d} .ulg files from {:s} with {:d} jobs".format(n_files, ulog_directory, args.jobs))
+
+    start = time.monotonic()
+    results = []
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(args.jobs, 1)) as executor:
+        futures = {}
+
+        for i, ulog_file in enumerate(ulog_files):
+            name = os.path.splitext(os.path.relpath(ulog_file, ulog_directory))[0].replace(os.sep, '_')
+            working_dir = os.path.join(output_dir, name)
+            futures[executor.submit(replay_log, px4_binary, etc_dir, ulog_file, working_dir, i, args.log,
+                                    args.timeout)] = ulog_file
+
+        for n, future in enumerate(concurrent.futures.as_completed(futures), 1):
+            row = future.result()
+            print('{:d}/{:d} {:s}: {:s} ({:s} s)'.format(n, n_files, row['status'], futures[future],
+                                                        row['process_time_s']))
+            results.append(row)
+
+    results.sort(key=lambda row: row['log'])
+
+    fieldnames = ['log', 'status', 'process_time_s']
+
+    for row in results:
+        for key in row:
+            if key not in fieldnames:
+                fieldnames.append(key)
+
+    os.makedirs(output_dir, exist_ok=True)
+    summary_file = os.path.join(output_dir, 'summary.csv')
+
+    with open(summary_file, 'w') as file:
+        writer = csv.DictWriter(file, fieldnames=fieldnames, restval='')
+        writer.writeheader()
+        writer.writerows(results)
+
+    n_failed = sum(1 for row in results if row['status'] != 'ok')
+
+    print('{:d}/{:d} files replayed, {:d} failed, {:.1f} s total. Summary written to {:s}'.format(
+        n_files - n_failed, n_files, n_failed, time.monotonic() - start, summary_file))
+
+    if n_failed > 0:
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
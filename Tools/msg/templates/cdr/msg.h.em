@@ -0,0 +1,190 @@
+@###############################################
+@#
+@# EmPy template
+@#
+@###############################################
+@# generates CDR serialization & deserialization methods for the cdrstream (XCDR2) encoding
+@#
+@# Context:
+@#  - file_name_in (String) Source file
+@#  - spec (msggen.MsgSpec) Parsed specification of the .msg file
+@#  - search_path (dict) search paths for genmsg
+@#  - topics (List of String) topic names
+@###############################################
+/****************************************************************************
+ *
+ *   Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+@{
+import genmsg.msgs
+import re
+from px_generate_uorb_topic_helper import * # this is in Tools/
+
+topic = name_snake_case
+uorb_struct = '%s_s'%name_snake_case
+
+def c_offsets(msg_fields):
+	"""
+	offsets of the fields in the uORB struct, which sorts the fields by size and adds explicit padding
+	"""
+	sorted_fields = sorted(msg_fields, key=sizeof_field_type, reverse=True)
+	add_padding_bytes(sorted_fields, search_path) # also sets field.sizeof_field_type for nested types
+	offsets = {}
+	offset = 0
+	for field in sorted_fields:
+		if not field.is_header:
+			offsets[field.name] = offset
+			offset += field.sizeof_field_type * (field.array_len if field.is_array else 1)
+	return offsets
+
+def flatten_fields(msg_fields, name_prefix='', base_offset=0):
+	"""
+	builtin fields in serialization (.msg) order: ('field', name, element size, number of bytes, struct offset),
+	arrays of nested messages are enclosed in ('array_begin', name) and ('array_end', name)
+	"""
+	offsets = c_offsets(msg_fields)
+	fields = []
+	for field in msg_fields:
+		if field.is_header:
+			continue
+		array_size = field.array_len if field.is_array else 1
+		if field.is_builtin:
+			element_size = sizeof_field_type(field)
+			assert element_size > 0
+			fields.append(('field', name_prefix + field.name, element_size, element_size * array_size, base_offset + offsets[field.name]))
+		else:
+			children_fields = get_children_fields(field.base_type, search_path)
+			if field.is_array:
+				fields.append(('array_begin', name_prefix + field.name))
+			for i in range(array_size):
+				sub_name_prefix = name_prefix + field.name
+				if field.is_array:
+					sub_name_prefix += '[' + str(i) + ']'
+				fields.extend(flatten_fields(children_fields, sub_name_prefix + '.',
+					base_offset + offsets[field.name] + i * field.sizeof_field_type))
+			if field.is_array:
+				fields.append(('array_end', name_prefix + field.name))
+	return fields
+
+# XCDR2 layout: elements are aligned to their size, but at most to 4 bytes.
+# Arrays of non-primitive elements (nested messages) are preceded by a 4 byte DHEADER with the
+# number of bytes of the array.
+# runs: consecutive fields that are contiguous in both the CDR stream and the uORB struct
+runs = [] # ['run', cdr offset, padding before, struct offset, number of bytes, first field, last field]
+          # or ['dheader', cdr offset, padding before, array length in bytes, array name]
+open_dheaders = []
+cdr_size = 0
+for entry in flatten_fields(spec.parsed_fields()):
+	if entry[0] == 'array_begin':
+		padding = (4 - (cdr_size % 4)) % 4
+		cdr_size += padding
+		runs.append(['dheader', cdr_size, padding, 0, entry[1]])
+		open_dheaders.append(runs[-1])
+		cdr_size += 4
+		continue
+	if entry[0] == 'array_end':
+		dheader = open_dheaders.pop()
+		dheader[3] = cdr_size - (dheader[1] + 4)
+		continue
+	_, name, element_size, num_bytes, struct_offset = entry
+	align = min(element_size, 4)
+	padding = (align - (cdr_size % align)) % align
+	cdr_size += padding
+	if padding == 0 and len(runs) > 0 and runs[-1][0] == 'run' and runs[-1][3] + runs[-1][4] == struct_offset:
+		runs[-1][4] += num_bytes
+		runs[-1][6] = name
+	else:
+		runs.append(['run', cdr_size, padding, struct_offset, num_bytes, name, name])
+	cdr_size += num_bytes
+assert len(open_dheaders) == 0
+
+}@
+
+// auto-generated file
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <uORB/topics/@(topic).h>
+
+// CDR (XCDR2, little endian) serialization of @(uorb_struct), without the 4 byte encapsulation header.
+// The fields are copied in runs that are contiguous in both the stream and the struct.
+
+static inline constexpr uint32_t cdr_topic_size_@(topic)()
+{
+	return @(cdr_size);
+}
+
+@{
+for run in runs:
+	if run[0] == 'run':
+		_, cdr_offset, padding, struct_offset, num_bytes, first, last = run
+		print('static_assert(offsetof({0}, {1}) == {2}, "{1}: offset mismatch");'.format(uorb_struct, first, struct_offset))
+		print('static_assert(offsetof({0}, {1}) + sizeof(static_cast<{0} *>(nullptr)->{1}) == {2}, "{1}: size mismatch");'.format(uorb_struct, last, struct_offset + num_bytes))
+}@
+
+// serialize into buf (at least cdr_topic_size bytes), returns the number of bytes written
+static inline uint32_t cdr_serialize_@(topic)(const void *data, uint8_t *buf)
+{
+	const uint8_t *src = static_cast<const uint8_t *>(data);
+@{
+for run in runs:
+	cdr_offset, padding = run[1], run[2]
+	if padding > 0:
+		print('\tmemset(buf + {:}, 0, {:}); // padding'.format(cdr_offset - padding, padding))
+	if run[0] == 'dheader':
+		print('\t{{\n\t\tconst uint32_t dheader = {:};\n\t\tmemcpy(buf + {:}, &dheader, 4); // {:} DHEADER\n\t}}'.format(run[3], cdr_offset, run[4]))
+	else:
+		_, cdr_offset, padding, struct_offset, num_bytes, first, last = run
+		print('\tmemcpy(buf + {:}, src + {:}, {:}); // {:}'.format(cdr_offset, struct_offset, num_bytes, first if first == last else first + ' .. ' + last))
+}@
+	return @(cdr_size);
+}
+
+// deserialize from buf, returns false if it is too short
+static inline bool cdr_deserialize_@(topic)(const uint8_t *buf, uint32_t len, void *data)
+{
+	if (len < @(cdr_size)) {
+		return false;
+	}
+
+	uint8_t *dst = static_cast<uint8_t *>(data);
+@{
+for run in runs:
+	if run[0] == 'run':
+		_, cdr_offset, padding, struct_offset, num_bytes, first, last = run
+		print('\tmemcpy(dst + {:}, buf + {:}, {:}); // {:}'.format(struct_offset, cdr_offset, num_bytes, first if first == last else first + ' .. ' + last))
+}@
+	return true;
+}
@@ -11,8 +11,6 @@
 @###############################################
 @{
 
-topic_dict = dict(zip(datatypes, full_base_names))
-
 topics_count = len(topics)
 topic_names_all = list(set(topics)) # set() filters duplicates
 topic_names_all.sort()
@@ -68,8 +66,10 @@ full_base_names.sort()
 
 #include <publishers/uorb_publisher.hpp>
 #include <uORB/topics/uORBTopics.hpp>
-@[for idx, topic_name in enumerate(full_base_names)]@
-#include <px4/msg/@(topic_name).h>
+@[for idx, topic_name in enumerate(datatypes)]@
+#ifdef CONFIG_ZENOH_PUBSUB_@(topic_name.upper())
+#include <uORB/cdr/@(topic_name).h>
+#endif
 @[end for]
 
 @[for idx, topic_name in enumerate(datatypes)]@
@@ -89,7 +89,7 @@ type_topic_count = len([e for e in topic_names_all if e.startswith(topic_name)])
 @[end for]        0
 
 typedef struct {
-	const uint32_t *ops;
+	UorbCdrSerializer cdr;
 	const orb_metadata* orb_meta;
 } UorbPubSubTopicBinder;
 
@@ -104,7 +104,7 @@ topic_names = [e for e in topic_names_all if e.startswith(topic_name)]
 }@
 @[for topic_name_inst in topic_names]@
 		{
-		  px4_msg_@(topic_dict[topic_name])_cdrstream_desc.ops.ops,
+		  { &cdr_serialize_@(topic_name), &cdr_deserialize_@(topic_name), cdr_topic_size_@(topic_name)() },
 		  ORB_ID(@(topic_name_inst))
 		},
 @{
@@ -117,7 +117,7 @@ uorb_id_idx += 1
 uORB_Zenoh_Publisher* genPublisher(const orb_metadata *meta) {
     for (auto &pub : _topics) {
         if(pub.orb_meta->o_id == meta->o_id) {
-            return new uORB_Zenoh_Publisher(meta, pub.ops);
+            return new uORB_Zenoh_Publisher(meta, pub.cdr);
         }
     }
     return NULL;
@@ -127,7 +127,7 @@ uORB_Zenoh_Publisher* genPublisher(const orb_metadata *meta) {
 uORB_Zenoh_Publisher* genPublisher(const char *name) {
     for (auto &pub : _topics) {
         if(strcmp(pub.orb_meta->o_name, name) == 0) {
-            return new uORB_Zenoh_Publisher(pub.orb_meta, pub.ops);
+            return new uORB_Zenoh_Publisher(pub.orb_meta, pub.cdr);
         }
     }
     return NULL;
@@ -137,7 +137,7 @@ uORB_Zenoh_Publisher* genPublisher(const char *name) {
 Zenoh_Subscriber* genSubscriber(const orb_metadata *meta) {
     for (auto &sub : _topics) {
         if(sub.orb_meta->o_id == meta->o_id) {
-            return new uORB_Zenoh_Subscriber(meta, sub.ops);
+            return new uORB_Zenoh_Subscriber(meta, sub.cdr);
         }
     }
     return NULL;
@@ -147,7 +147,7 @@ Zenoh_Subscriber* genSubscriber(const orb_metadata *meta) {
 Zenoh_Subscriber* genSubscriber(const char *name) {
     for (auto &sub : _topics) {
         if(strcmp(sub.orb_meta->o_name, name) == 0) {
-            return new uORB_Zenoh_Subscriber(sub.orb_meta, sub.ops);
+            return new uORB_Zenoh_Subscriber(sub.orb_meta, sub.cdr);
         }
     }
     return NULL;
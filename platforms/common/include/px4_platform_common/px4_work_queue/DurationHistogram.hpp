@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file DurationHistogram.hpp
+ *
+ * Compact log2 histogram of durations, used for work item profiling.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace px4
+{
+
+class DurationHistogram
+{
+public:
+	static constexpr int NUM_BUCKETS = 16; ///< bucket i counts durations in [2^(i-1), 2^i) us, the last one is open ended
+
+	void add(uint64_t duration_us)
+	{
+		const uint32_t us = (duration_us < UINT32_MAX) ? duration_us : UINT32_MAX;
+
+		int bucket = (us == 0) ? 0 : (32 - __builtin_clz(us));
+
+		if (bucket >= NUM_BUCKETS) {
+			bucket = NUM_BUCKETS - 1;
+		}
+
+		if (_buckets[bucket] == UINT16_MAX) {
+			// halve all buckets: keeps the shape of the distribution, and favors recent samples
+			for (auto &b : _buckets) {
+				b /= 2;
+			}
+		}
+
+		_buckets[bucket]++;
+
+		if (us > _max) {
+			_max = us;
+		}
+	}
+
+	/**
+	 * Get a percentile, rounded up to the upper bound of its bucket (and limited to the maximum)
+	 * @param percent percentile in [0, 100]
+	 * @return duration in microseconds, 0 if empty
+	 */
+	uint32_t percentile(uint8_t percent) const
+	{
+		uint32_t total = 0;
+
+		for (auto b : _buckets) {
+			total += b;
+		}
+
+		if (total == 0) {
+			return 0;
+		}
+
+		const uint32_t rank = (total * percent + 99) / 100;
+		uint32_t count = 0;
+
+		for (int i = 0; i < NUM_BUCKETS; i++) {
+			count += _buckets[i];
+
+			if ((count >= rank) && (i < NUM_BUCKETS - 1)) {
+				const uint32_t upper = 1u << i;
+				return (upper < _max) ? upper : _max;
+			}
+		}
+
+		return _max;
+	}
+
+	uint32_t max() const { return _max; }
+
+	void reset()
+	{
+		for (auto &b : _buckets) {
+			b = 0;
+		}
+
+		_max = 0;
+	}
+
+private:
+	uint16_t _buckets[NUM_BUCKETS] {};
+	uint32_t _max{0};
+};
+
+} // namespace px4
@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include "DurationHistogram.hpp"
 #include "WorkQueueManager.hpp"
 #include "WorkQueue.hpp"
 
@@ -83,6 +84,29 @@ public:
 
 	const char *ItemName() const { return _item_name; }
 
+	/**
+	 * Set the deadline of each run relative to the time the item is scheduled.
+	 * On work queues configured with deadline_ordered, queued items are run earliest
+	 * deadline first (items without deadline last, in FIFO order). Ignored otherwise.
+	 *
+	 * @param deadline_us		The relative deadline in microseconds, 0 to disable.
+	 */
+	void SetRelativeDeadline(uint32_t deadline_us)
+	{
+		_relative_deadline_us = deadline_us;
+		_relative_deadline_set = true;
+	}
+
+	uint32_t RelativeDeadline() const { return _relative_deadline_us; }
+
+#if defined(WORK_ITEM_PROFILING)
+	/** Scheduling latency (from ScheduleNow() until Run() starts) */
+	const DurationHistogram &latency_histogram() const { return _latency_histogram; }
+
+	/** Execution time of Run() */
+	const DurationHistogram &runtime_histogram() const { return _runtime_histogram; }
+#endif // WORK_ITEM_PROFILING
+
 protected:
 
 	explicit WorkItem(const char *name, const wq_config_t &config);
@@ -108,7 +132,7 @@ protected:
 		}
 	}
 
-	friend void WorkQueue::Run();
+	friend class WorkQueue;
 	virtual void Run() = 0;
 
 	/**
@@ -126,12 +150,26 @@ protected:
 	float average_rate() const;
 	float average_interval() const;
 
+	/** print the profiling columns of the run status (if enabled) */
+	void print_profile_status() const;
+
 	hrt_abstime	_time_first_run{0};
 	const char 	*_item_name;
 	uint32_t	_run_count{0};
 
+	uint32_t	_relative_deadline_us{0};
+	bool		_relative_deadline_set{false}; ///< set explicitly (otherwise ScheduledWorkItem uses its interval)
+
 private:
 
+	hrt_abstime	_deadline{0}; ///< absolute deadline while queued on a deadline ordered WorkQueue
+
+#if defined(WORK_ITEM_PROFILING)
+	hrt_abstime		_time_queued {0};
+	DurationHistogram	_latency_histogram;
+	DurationHistogram	_runtime_histogram;
+#endif // WORK_ITEM_PROFILING
+
 	WorkQueue	*_wq{nullptr};
 
 };
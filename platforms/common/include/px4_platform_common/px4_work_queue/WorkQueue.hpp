@@ -67,12 +67,41 @@ public:
 
 	void Clear();
 
-	void Run();
+	/**
+	 * Process queued work until requested to stop.
+	 * @param worker	Index of the calling thread for queues with multiple threads (see add_worker()).
+	 */
+	void Run(unsigned worker = 0);
+
+	/**
+	 * Add the calling thread as additional worker of a queue configured with multiple threads.
+	 * @param worker	The index to pass to Run().
+	 * @return		false if the queue is stopping or has all its threads.
+	 */
+	bool add_worker(unsigned &worker);
+	void remove_worker() { _workers.fetch_sub(1); }
+	int workers() const { return _workers.load(); }
+
+	static constexpr uint8_t MAX_THREADS = 4;
 
 	void request_stop() { _should_exit.store(true); }
 
 	void print_status(bool last = false);
 
+	/**
+	 * Get the profiling statistics of a work item of this queue.
+	 * @param index		Index of the work item in this queue, decremented by the number of items if not found.
+	 */
+	bool item_profile(unsigned &index, work_item_profile_t &profile);
+
+#if defined(__PX4_LINUX)
+	/**
+	 * Pin the work queue thread to a set of CPU cores.
+	 * @param cpu_mask	Bitmask of the allowed cores, 0 for all cores.
+	 */
+	int set_cpu_affinity(uint32_t cpu_mask);
+#endif // __PX4_LINUX
+
 	// WorkQueues sorted numerically by relative priority (-1 to -255)
 	bool operator<=(const WorkQueue &rhs) const { return _config.relative_priority >= rhs.get_config().relative_priority; }
 
@@ -82,6 +111,8 @@ private:
 
 	inline void SignalWorkerThread();
 
+	void Enqueue(WorkItem *item); ///< add to the queue (call with work_lock() held)
+
 #ifdef __PX4_NUTTX
 	// In NuttX work can be enqueued from an ISR
 	void work_lock() { _flags = enter_critical_section(); }
@@ -101,10 +132,21 @@ private:
 	BlockingList<WorkItem *>	_work_items;
 	px4::atomic_bool		_should_exit{false};
 
+	px4::atomic<int>		_workers{1};
+	WorkItem			*_running_items[MAX_THREADS] {}; ///< item each worker is running, cleared if detached meanwhile
+	bool				_run_again[MAX_THREADS] {}; ///< item was scheduled again while running
+
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	int _lockstep_component {-1};
 #endif // ENABLE_LOCKSTEP_SCHEDULER
 
+#if defined(__PX4_LINUX)
+	pthread_t			_threads[MAX_THREADS] {};
+	px4::atomic<uint32_t>		_cpu_affinity{0};
+	px4::atomic<int>		_last_cpu{-1};		///< core the thread last woke up on
+	px4::atomic<uint32_t>		_cpu_migrations{0};	///< number of wakeups on a different core than the previous one
+#endif // __PX4_LINUX
+
 };
 
 } // namespace px4
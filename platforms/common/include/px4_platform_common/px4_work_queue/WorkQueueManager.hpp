@@ -35,6 +35,11 @@
 
 #include <stdint.h>
 
+#if !defined(CONSTRAINED_MEMORY)
+// per work item scheduling latency and run time histograms
+# define WORK_ITEM_PROFILING
+#endif
+
 namespace px4
 {
 
@@ -44,6 +49,9 @@ struct wq_config_t {
 	const char *name;
 	uint16_t stacksize;
 	int8_t relative_priority; // relative to max
+	bool deadline_ordered{false}; // run queued items earliest deadline first (see WorkItem::SetRelativeDeadline())
+	uint32_t cpu_affinity{0}; // (Linux only) bitmask of the CPU cores the thread may run on, 0 for no restriction
+	uint8_t threads{1}; // (posix only) number of threads sharing the queue, any idle thread runs the next pending item
 };
 
 namespace wq_configurations
@@ -71,6 +79,7 @@ static constexpr wq_config_t INS0{"wq:INS0", 6000, -14};
 static constexpr wq_config_t INS1{"wq:INS1", 6000, -15};
 static constexpr wq_config_t INS2{"wq:INS2", 6000, -16};
 static constexpr wq_config_t INS3{"wq:INS3", 6000, -17};
+static constexpr wq_config_t INS_pool{"wq:INS_pool", 6000, -14, false, 0, 4}; // shared by all multi-EKF instances (EKF2_MULTI_POOL)
 
 static constexpr wq_config_t hp_default{"wq:hp_default", 2392, -18};
 
@@ -93,6 +102,7 @@ static constexpr wq_config_t lp_default{"wq:lp_default", 1920, -50};
 
 static constexpr wq_config_t test1{"wq:test1", 2000, 0};
 static constexpr wq_config_t test2{"wq:test2", 2000, 0};
+static constexpr wq_config_t test_deadline{"wq:test_deadline", 2000, 0, true};
 
 } // namespace wq_configurations
 
@@ -111,6 +121,16 @@ int WorkQueueManagerStop();
  */
 int WorkQueueManagerStatus();
 
+/**
+ * Override the CPU affinity of a work queue (Linux only).
+ * Applied immediately if the work queue is running and whenever it is (re)created.
+ *
+ * @param name		The work queue name (eg "wq:rate_ctrl").
+ * @param cpu_mask	Bitmask of the CPU cores the thread may run on, 0 restores the configured affinity.
+ * @return		PX4_OK on success, PX4_ERROR otherwise.
+ */
+int WorkQueueManagerSetAffinity(const char *name, uint32_t cpu_mask);
+
 /**
  * Create (or find) a work queue with a particular configuration.
  *
@@ -137,5 +157,21 @@ const wq_config_t &serial_port_to_wq(const char *serial);
 
 const wq_config_t &ins_instance_to_wq(uint8_t instance);
 
+struct work_item_profile_t {
+	char item_name[24];
+	char wq_name[24];
+	uint32_t latency_us[3]; // p50, p99, max
+	uint32_t runtime_us[3]; // p50, p99, max
+};
+
+/**
+ * Get the profiling statistics of a work item.
+ *
+ * @param index		Index of the work item, counted over all work queues.
+ * @param profile		Filled with the statistics.
+ * @return		false if there is no work item at index (or profiling is disabled).
+ */
+bool WorkQueueManagerItemProfile(unsigned index, work_item_profile_t &profile);
+
 
 } // namespace px4
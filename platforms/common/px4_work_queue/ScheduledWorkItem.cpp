@@ -57,6 +57,11 @@ void ScheduledWorkItem::ScheduleDelayed(uint32_t delay_us)
 
 void ScheduledWorkItem::ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us)
 {
+	if (!_relative_deadline_set) {
+		// implicit deadline: the run has to complete before the next one is due
+		_relative_deadline_us = interval_us;
+	}
+
 	hrt_call_every(&_call, delay_us, interval_us, (hrt_callout)&ScheduledWorkItem::schedule_trampoline, this);
 }
 
@@ -75,8 +80,9 @@ void ScheduledWorkItem::ScheduleClear()
 void ScheduledWorkItem::print_run_status()
 {
 	if (_call.period > 0) {
-		PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us (%" PRId64 " us)\n", _item_name, (double)average_rate(),
-			     (double)average_interval(), _call.period);
+		PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us", _item_name, (double)average_rate(), (double)average_interval());
+		print_profile_status();
+		PX4_INFO_RAW(" (%" PRId64 " us)\n", _call.period);
 
 	} else {
 		WorkItem::print_run_status();
@@ -132,9 +132,20 @@ float WorkItem::average_interval() const
 	return 0.f;
 }
 
+void WorkItem::print_profile_status() const
+{
+#if defined(WORK_ITEM_PROFILING)
+	PX4_INFO_RAW(" %5" PRIu32 " %5" PRIu32 " %6" PRIu32 " us %5" PRIu32 " %5" PRIu32 " %6" PRIu32 " us",
+		     _latency_histogram.percentile(50), _latency_histogram.percentile(99), _latency_histogram.max(),
+		     _runtime_histogram.percentile(50), _runtime_histogram.percentile(99), _runtime_histogram.max());
+#endif // WORK_ITEM_PROFILING
+}
+
 void WorkItem::print_run_status()
 {
-	PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us\n", _item_name, (double)average_rate(), (double)average_interval());
+	PX4_INFO_RAW("%-29s %8.1f Hz %12.0f us", _item_name, (double)average_rate(), (double)average_interval());
+	print_profile_status();
+	PX4_INFO_RAW("\n");
 
 	// reset statistics
 	_run_count = 0;
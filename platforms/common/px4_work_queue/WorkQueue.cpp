@@ -35,11 +35,17 @@
 #include <px4_platform_common/px4_work_queue/WorkItem.hpp>
 
 #include <string.h>
+#include <inttypes.h>
+
+#if defined(__PX4_LINUX)
+#include <sched.h>
+#endif // __PX4_LINUX
 
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/time.h>
 #include <drivers/drv_hrt.h>
+#include <lib/mathlib/mathlib.h>
 
 namespace px4
 {
@@ -54,6 +60,10 @@ WorkQueue::WorkQueue(const wq_config_t &config) :
 	pthread_setname_np(pthread_self(), _config.name);
 #endif
 
+#if defined(__PX4_LINUX)
+	_threads[0] = pthread_self();
+#endif // __PX4_LINUX
+
 #ifndef __PX4_NUTTX
 	px4_sem_init(&_qlock, 0, 1);
 #endif /* __PX4_NUTTX */
@@ -105,6 +115,14 @@ void WorkQueue::Detach(WorkItem *item)
 
 	_work_items.remove(item);
 
+	for (unsigned worker = 0; worker < MAX_THREADS; worker++) {
+		if (_running_items[worker] == item) {
+			// the item might be deleted before Run() returns
+			_running_items[worker] = nullptr;
+			_run_again[worker] = false;
+		}
+	}
+
 	if (_work_items.size() == 0) {
 		// shutdown, no active WorkItems
 		PX4_DEBUG("stopping: %s, last active WorkItem closing", _config.name);
@@ -138,12 +156,45 @@ void WorkQueue::Add(WorkItem *item)
 
 #endif // ENABLE_LOCKSTEP_SCHEDULER
 
-	_q.push(item);
+	Enqueue(item);
+
 	work_unlock();
 
 	SignalWorkerThread();
 }
 
+void WorkQueue::Enqueue(WorkItem *item)
+{
+	bool queued = false;
+
+	if (_config.deadline_ordered) {
+		const hrt_abstime now = hrt_absolute_time();
+		const uint32_t relative_deadline = item->RelativeDeadline();
+		const hrt_abstime deadline = (relative_deadline > 0) ? (now + relative_deadline) : UINT64_MAX;
+
+		queued = _q.insert_sorted(item, [deadline](const WorkItem * queued_item, const WorkItem *) {
+			return queued_item->_deadline > deadline;
+		});
+
+		if (queued) {
+			item->_deadline = deadline;
+		}
+
+	} else {
+		queued = _q.push(item);
+	}
+
+#if defined(WORK_ITEM_PROFILING)
+
+	if (queued) {
+		item->_time_queued = hrt_absolute_time();
+	}
+
+#else
+	(void)queued;
+#endif // WORK_ITEM_PROFILING
+}
+
 void WorkQueue::SignalWorkerThread()
 {
 	int sem_val;
@@ -171,28 +222,128 @@ void WorkQueue::Clear()
 	work_unlock();
 }
 
-void WorkQueue::Run()
+bool WorkQueue::add_worker(unsigned &worker)
+{
+	work_lock();
+
+	const int workers = _workers.load();
+
+	if (should_exit() || (workers >= math::min(_config.threads, MAX_THREADS))) {
+		work_unlock();
+		return false;
+	}
+
+	worker = workers;
+#if defined(__PX4_LINUX)
+	_threads[worker] = pthread_self();
+#endif // __PX4_LINUX
+	_workers.store(workers + 1);
+
+	work_unlock();
+
+#ifdef __PX4_DARWIN
+	pthread_setname_np(_config.name);
+#else
+	pthread_setname_np(pthread_self(), _config.name);
+#endif
+
+#if defined(__PX4_LINUX)
+
+	if (_cpu_affinity.load() != 0) {
+		set_cpu_affinity(_cpu_affinity.load());
+	}
+
+#endif // __PX4_LINUX
+
+	return true;
+}
+
+void WorkQueue::Run(unsigned worker)
 {
 	while (!should_exit()) {
 		// loop as the wait may be interrupted by a signal
 		do {} while (px4_sem_wait(&_process_lock) != 0);
 
+#if defined(__PX4_LINUX)
+
+		if (worker == 0) {
+			const int cpu = sched_getcpu();
+
+			if (cpu != _last_cpu.load()) {
+				if (_last_cpu.load() >= 0) {
+					_cpu_migrations.fetch_add(1);
+				}
+
+				_last_cpu.store(cpu);
+			}
+		}
+
+#endif // __PX4_LINUX
+
 		work_lock();
 
 		// process queued work
 		while (!_q.empty()) {
 			WorkItem *work = _q.pop();
 
+			// never run an item concurrently, the worker running it picks it up again when done
+			bool running = false;
+
+			for (unsigned i = 0; i < MAX_THREADS; i++) {
+				if (_running_items[i] == work) {
+					_run_again[i] = true;
+					running = true;
+				}
+			}
+
+			if (running) {
+				continue;
+			}
+
+			_running_items[worker] = work;
+
+			if (!_q.empty() && (_config.threads > 1)) {
+				// hand the remaining work to an idle worker
+				SignalWorkerThread();
+			}
+
+#if defined(WORK_ITEM_PROFILING)
+			const hrt_abstime time_started = hrt_absolute_time();
+			work->_latency_histogram.add(time_started - work->_time_queued);
+#endif // WORK_ITEM_PROFILING
+
 			work_unlock(); // unlock work queue to run (item may requeue itself)
 			work->RunPreamble();
 			work->Run();
 			// Note: after Run() we cannot access work anymore, as it might have been deleted
 			work_lock(); // re-lock
+
+			// still attached (Detach() clears it), so the item is guaranteed to exist
+			if (_running_items[worker] == work) {
+#if defined(WORK_ITEM_PROFILING)
+				work->_runtime_histogram.add(hrt_absolute_time() - time_started);
+#endif // WORK_ITEM_PROFILING
+
+				if (_run_again[worker]) {
+					_run_again[worker] = false;
+					Enqueue(work);
+				}
+			}
+
+			_running_items[worker] = nullptr;
 		}
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 
-		if (_q.empty()) {
+		bool idle = true;
+
+		for (unsigned i = 0; i < MAX_THREADS; i++) {
+			if (_running_items[i] != nullptr) {
+				idle = false;
+			}
+		}
+
+		if (_q.empty() && idle) {
 			px4_lockstep_unregister_component(_lockstep_component);
 			_lockstep_component = -1;
 		}
@@ -202,13 +353,36 @@ void WorkQueue::Run()
 		work_unlock();
 	}
 
+	if (_config.threads > 1) {
+		// pass the stop request on to the next waiting worker
+		px4_sem_post(&_process_lock);
+	}
+
 	PX4_DEBUG("%s: exiting", _config.name);
 }
 
 void WorkQueue::print_status(bool last)
 {
 	const size_t num_items = _work_items.size();
-	PX4_INFO_RAW("%-16s\n", get_name());
+	PX4_INFO_RAW("%-16s", get_name());
+
+	if (_config.threads > 1) {
+		PX4_INFO_RAW("  threads: %d", _workers.load());
+	}
+
+#if defined(__PX4_LINUX)
+	PX4_INFO_RAW("  CPU: %2d", _last_cpu.load());
+
+	const uint32_t cpu_affinity = _cpu_affinity.load();
+
+	if (cpu_affinity != 0) {
+		PX4_INFO_RAW(" (affinity 0x%02" PRIx32 ")", cpu_affinity);
+	}
+
+	PX4_INFO_RAW("  migrations: %" PRIu32, _cpu_migrations.load());
+#endif // __PX4_LINUX
+
+	PX4_INFO_RAW("\n");
 	unsigned i = 0;
 
 	for (WorkItem *item : _work_items) {
@@ -232,4 +406,69 @@ void WorkQueue::print_status(bool last)
 	}
 }
 
+#if defined(__PX4_LINUX)
+int WorkQueue::set_cpu_affinity(uint32_t cpu_mask)
+{
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+
+	const int num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+
+	for (int cpu = 0; cpu < num_cpus; cpu++) {
+		if ((cpu_mask == 0) || ((cpu < 32) && (cpu_mask & (1u << cpu)))) {
+			CPU_SET(cpu, &cpuset);
+		}
+	}
+
+	if (CPU_COUNT(&cpuset) == 0) {
+		PX4_ERR("%s: no valid CPU in affinity mask 0x%" PRIx32, get_name(), cpu_mask);
+		return PX4_ERROR;
+	}
+
+	for (int worker = 0; worker < _workers.load(); worker++) {
+		int ret = pthread_setaffinity_np(_threads[worker], sizeof(cpuset), &cpuset);
+
+		if (ret != 0) {
+			PX4_ERR("%s: setting CPU affinity 0x%" PRIx32 " failed (%i)", get_name(), cpu_mask, ret);
+			return PX4_ERROR;
+		}
+	}
+
+	_cpu_affinity.store(cpu_mask);
+	return PX4_OK;
+}
+#endif // __PX4_LINUX
+
+bool WorkQueue::item_profile(unsigned &index, work_item_profile_t &profile)
+{
+#if defined(WORK_ITEM_PROFILING)
+	LockGuard lg{_work_items.mutex()};
+
+	for (WorkItem *item : _work_items) {
+		if (index == 0) {
+			strncpy(profile.item_name, item->ItemName(), sizeof(profile.item_name) - 1);
+			profile.item_name[sizeof(profile.item_name) - 1] = '\0';
+			strncpy(profile.wq_name, get_name(), sizeof(profile.wq_name) - 1);
+			profile.wq_name[sizeof(profile.wq_name) - 1] = '\0';
+
+			const DurationHistogram &latency = item->latency_histogram();
+			profile.latency_us[0] = latency.percentile(50);
+			profile.latency_us[1] = latency.percentile(99);
+			profile.latency_us[2] = latency.max();
+
+			const DurationHistogram &runtime = item->runtime_histogram();
+			profile.runtime_us[0] = runtime.percentile(50);
+			profile.runtime_us[1] = runtime.percentile(99);
+			profile.runtime_us[2] = runtime.max();
+			return true;
+		}
+
+		index--;
+	}
+
+#endif // WORK_ITEM_PROFILING
+
+	return false;
+}
+
 } // namespace px4
@@ -63,6 +63,30 @@ static BlockingQueue<const wq_config_t *, 1> *_wq_manager_create_queue{nullptr};
 static px4::atomic_bool _wq_manager_should_exit{true};
 static px4::atomic_bool _wq_manager_running{false};
 
+#if defined(__PX4_LINUX)
+// runtime CPU affinity overrides (work_queue affinity), taking precedence over wq_config_t::cpu_affinity
+struct wq_affinity_override_t {
+	char name[24];
+	uint32_t cpu_mask;
+};
+
+static wq_affinity_override_t _wq_affinity_overrides[8] {};
+static pthread_mutex_t _wq_affinity_overrides_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t
+WorkQueueCpuAffinity(const wq_config_t &config)
+{
+	LockGuard lg{_wq_affinity_overrides_mutex};
+
+	for (const auto &entry : _wq_affinity_overrides) {
+		if (strcmp(entry.name, config.name) == 0) {
+			return entry.cpu_mask;
+		}
+	}
+
+	return config.cpu_affinity;
+}
+#endif // __PX4_LINUX
 
 static WorkQueue *
 FindWorkQueueByName(const char *name)
@@ -232,6 +256,15 @@ WorkQueueRunner(void *context)
 	wq_config_t *config = static_cast<wq_config_t *>(context);
 	WorkQueue wq(*config);
 
+#if defined(__PX4_LINUX)
+	const uint32_t cpu_affinity = WorkQueueCpuAffinity(*config);
+
+	if (cpu_affinity != 0) {
+		wq.set_cpu_affinity(cpu_affinity);
+	}
+
+#endif // __PX4_LINUX
+
 	// add to work queue list
 	_wq_manager_wqs_list->add(&wq);
 
@@ -240,8 +273,59 @@ WorkQueueRunner(void *context)
 	// remove from work queue list
 	_wq_manager_wqs_list->remove(&wq);
 
+	// wait for the other threads of the queue to finish
+	while (wq.workers() > 1) {
+		px4_usleep(1000);
+	}
+
+	return nullptr;
+}
+
+#if defined(__PX4_POSIX)
+static void *
+WorkQueueWorkerRunner(void *context)
+{
+	const wq_config_t *config = static_cast<const wq_config_t *>(context);
+
+	// wait for the first thread to create the work queue, then join it
+	for (int i = 0; i < 1000; i++) {
+		WorkQueue *wq = nullptr;
+		unsigned worker = 0;
+		bool found = false;
+
+		{
+			LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+			for (WorkQueue *q : *_wq_manager_wqs_list) {
+				if (strcmp(q->get_name(), config->name) == 0) {
+					found = true;
+
+					if (q->add_worker(worker)) {
+						wq = q;
+					}
+
+					break;
+				}
+			}
+		}
+
+		if (wq != nullptr) {
+			wq->Run(worker);
+			wq->remove_worker();
+			return nullptr;
+
+		} else if (found) {
+			break;
+		}
+
+		px4_usleep(1000);
+	}
+
+	PX4_ERR("%s: failed to add worker thread", config->name);
+
 	return nullptr;
 }
+#endif // __PX4_POSIX
 
 #if defined(__PX4_NUTTX) && !defined(CONFIG_BUILD_FLAT)
 // Wrapper for px4_task_spawn_cmd interface
@@ -304,6 +388,16 @@ WorkQueueManagerRun(int, char **)
 				PX4_ERR("getting sched param for %s failed (%i)", wq->name, ret_getschedparam);
 			}
 
+#if defined(__PX4_LINUX)
+			// the default is to inherit the scheduling of the wq:manager thread and ignore policy & priority below
+			int ret_setinheritsched = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+
+			if (ret_setinheritsched != 0) {
+				PX4_ERR("setting explicit sched for %s failed (%i)", wq->name, ret_setinheritsched);
+			}
+
+#endif // __PX4_LINUX
+
 			// schedule policy FIFO
 			int ret_setschedpolicy = pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
 
@@ -323,6 +417,16 @@ WorkQueueManagerRun(int, char **)
 			pthread_t thread;
 			int ret_create = pthread_create(&thread, &attr, WorkQueueRunner, (void *)wq);
 
+#if defined(__PX4_LINUX)
+
+			if (ret_create == EPERM) {
+				// not permitted to use realtime scheduling (not running as root), fall back to inheriting it
+				pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+				ret_create = pthread_create(&thread, &attr, WorkQueueRunner, (void *)wq);
+			}
+
+#endif // __PX4_LINUX
+
 			if (ret_create == 0) {
 				PX4_DEBUG("starting: %s, priority: %d, stack: %zu bytes", wq->name, param.sched_priority, stacksize);
 
@@ -330,6 +434,20 @@ WorkQueueManagerRun(int, char **)
 				PX4_ERR("failed to create thread for %s (%i): %s", wq->name, ret_create, strerror(ret_create));
 			}
 
+#if defined(__PX4_POSIX)
+
+			// additional threads sharing the queue
+			for (int worker = 1; (ret_create == 0) && (worker < math::min(wq->threads, WorkQueue::MAX_THREADS)); worker++) {
+				pthread_t worker_thread;
+				ret_create = pthread_create(&worker_thread, &attr, WorkQueueWorkerRunner, (void *)wq);
+
+				if (ret_create != 0) {
+					PX4_ERR("failed to create worker thread %d for %s (%i): %s", worker, wq->name, ret_create, strerror(ret_create));
+				}
+			}
+
+#endif // __PX4_POSIX
+
 			// destroy thread attributes
 			int ret_destroy = pthread_attr_destroy(&attr);
 
@@ -467,7 +585,12 @@ WorkQueueManagerStatus()
 	if (!_wq_manager_should_exit.load() && _wq_manager_running.load()) {
 
 		const size_t num_wqs = _wq_manager_wqs_list->size();
+#if defined(WORK_ITEM_PROFILING)
+		PX4_INFO_RAW("\nWork Queue: %-2zu threads                          RATE        INTERVAL"
+			     "   LATENCY p50/p99/max   RUNTIME p50/p99/max\n", num_wqs);
+#else
 		PX4_INFO_RAW("\nWork Queue: %-2zu threads                          RATE        INTERVAL\n", num_wqs);
+#endif // WORK_ITEM_PROFILING
 
 		LockGuard lg{_wq_manager_wqs_list->mutex()};
 		size_t i = 0;
@@ -494,4 +617,76 @@ WorkQueueManagerStatus()
 	return PX4_OK;
 }
 
+int
+WorkQueueManagerSetAffinity(const char *name, uint32_t cpu_mask)
+{
+#if defined(__PX4_LINUX)
+	{
+		LockGuard lg{_wq_affinity_overrides_mutex};
+
+		wq_affinity_override_t *override_entry = nullptr;
+
+		for (auto &entry : _wq_affinity_overrides) {
+			if (strcmp(entry.name, name) == 0) {
+				override_entry = &entry;
+				break;
+
+			} else if ((override_entry == nullptr) && (entry.name[0] == '\0')) {
+				override_entry = &entry;
+			}
+		}
+
+		if (override_entry == nullptr) {
+			PX4_ERR("too many affinity overrides");
+			return PX4_ERROR;
+		}
+
+		if (cpu_mask != 0) {
+			strncpy(override_entry->name, name, sizeof(override_entry->name) - 1);
+			override_entry->name[sizeof(override_entry->name) - 1] = '\0';
+			override_entry->cpu_mask = cpu_mask;
+
+		} else {
+			override_entry->name[0] = '\0';
+			override_entry->cpu_mask = 0;
+		}
+	}
+
+	if (!_wq_manager_should_exit.load() && _wq_manager_running.load()) {
+		LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+		for (WorkQueue *wq : *_wq_manager_wqs_list) {
+			if (strcmp(wq->get_name(), name) == 0) {
+				return wq->set_cpu_affinity((cpu_mask != 0) ? cpu_mask : wq->get_config().cpu_affinity);
+			}
+		}
+	}
+
+	return PX4_OK;
+#else
+	PX4_ERR("CPU affinity not supported");
+	return PX4_ERROR;
+#endif // __PX4_LINUX
+}
+
+bool
+WorkQueueManagerItemProfile(unsigned index, work_item_profile_t &profile)
+{
+#if defined(WORK_ITEM_PROFILING)
+
+	if (!_wq_manager_should_exit.load() && _wq_manager_running.load()) {
+		LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+		for (WorkQueue *wq : *_wq_manager_wqs_list) {
+			if (wq->item_profile(index, profile)) {
+				return true;
+			}
+		}
+	}
+
+#endif // WORK_ITEM_PROFILING
+
+	return false;
+}
+
 } // namespace px4
@@ -0,0 +1,128 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "wqueue_deadline_test.h"
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/time.h>
+
+#include <inttypes.h>
+
+using namespace px4;
+
+void WQueueDeadlineTest::TestItem::Run()
+{
+	_time_started = hrt_absolute_time();
+	_order = _parent._run_counter.fetch_add(1);
+
+	if (_gate) {
+		while (!_parent._gate_open.load()) {
+			px4_usleep(1000);
+		}
+
+	} else if (_busy_us > 0) {
+		px4_usleep(_busy_us);
+	}
+}
+
+bool WQueueDeadlineTest::run_once(const wq_config_t &config, hrt_abstime &critical_latency)
+{
+	TestItem gate{"wqueue_deadline_gate", config, *this, 0, true};
+	TestItem critical{"wqueue_deadline_critical", config, *this, 0};
+	TestItem bulk[BULK_ITEMS] {
+		{"wqueue_deadline_bulk", config, *this, BULK_RUNTIME_US},
+		{"wqueue_deadline_bulk", config, *this, BULK_RUNTIME_US},
+		{"wqueue_deadline_bulk", config, *this, BULK_RUNTIME_US},
+		{"wqueue_deadline_bulk", config, *this, BULK_RUNTIME_US},
+	};
+
+	critical.SetRelativeDeadline(CRITICAL_DEADLINE_US);
+
+	_gate_open.store(false);
+	_run_counter.store(0);
+
+	// occupy the worker thread, then queue the bulk work ahead of the critical item
+	gate.Schedule();
+
+	while (gate.order() < 0) {
+		px4_usleep(1000);
+	}
+
+	for (auto &item : bulk) {
+		item.Schedule();
+	}
+
+	critical.Schedule();
+
+	_gate_open.store(true);
+
+	// gate + bulk + critical
+	while (_run_counter.load() < BULK_ITEMS + 2) {
+		px4_usleep(1000);
+	}
+
+	critical_latency = critical.latency();
+
+	for (auto &item : bulk) {
+		if (item.order() < critical.order()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int WQueueDeadlineTest::main()
+{
+	hrt_abstime latency_fifo = 0;
+	hrt_abstime latency_edf = 0;
+
+	const bool first_fifo = run_once(wq_configurations::test1, latency_fifo);
+	const bool first_edf = run_once(wq_configurations::test_deadline, latency_edf);
+
+	PX4_INFO("deadline item latency FIFO: %" PRIu64 " us, EDF: %" PRIu64 " us", latency_fifo, latency_edf);
+
+	if (first_fifo) {
+		PX4_ERR("FIFO queue ran deadline item ahead of earlier bulk items");
+		return 1;
+	}
+
+	if (!first_edf) {
+		PX4_ERR("deadline ordered queue did not run deadline item first");
+		return 1;
+	}
+
+	PX4_INFO("WQueueDeadlineTest finished");
+
+	return 0;
+}
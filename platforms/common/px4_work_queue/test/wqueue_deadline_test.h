@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <drivers/drv_hrt.h>
+
+/**
+ * Compares dispatch order and scheduling latency of a deadline constrained item
+ * queued behind bulk work, on a FIFO and on a deadline ordered work queue.
+ */
+class WQueueDeadlineTest
+{
+public:
+	WQueueDeadlineTest() = default;
+	~WQueueDeadlineTest() = default;
+
+	int main();
+
+private:
+
+	class TestItem : public px4::WorkItem
+	{
+	public:
+		TestItem(const char *name, const px4::wq_config_t &config, WQueueDeadlineTest &parent, uint32_t busy_us,
+			 bool gate = false) :
+			px4::WorkItem(name, config), _parent(parent), _busy_us(busy_us), _gate(gate) {}
+
+		void Schedule()
+		{
+			_time_scheduled = hrt_absolute_time();
+			ScheduleNow();
+		}
+
+		hrt_abstime latency() const { return _time_started - _time_scheduled; }
+		int order() const { return _order; }
+
+	private:
+		void Run() override;
+
+		WQueueDeadlineTest &_parent;
+		const uint32_t _busy_us;
+		const bool _gate; ///< block the queue until the test opens the gate
+
+		hrt_abstime _time_scheduled{0};
+		hrt_abstime _time_started{0};
+		int _order{-1};
+	};
+
+	/**
+	 * Queue bulk items and one item with a deadline behind a blocking item.
+	 * @return true if the deadline item ran before all bulk items
+	 */
+	bool run_once(const px4::wq_config_t &config, hrt_abstime &critical_latency);
+
+	static constexpr int BULK_ITEMS = 4;
+	static constexpr uint32_t BULK_RUNTIME_US = 2000;
+	static constexpr uint32_t CRITICAL_DEADLINE_US = 1000;
+
+	px4::atomic_bool _gate_open{false};
+	px4::atomic<int> _run_counter{0};
+};
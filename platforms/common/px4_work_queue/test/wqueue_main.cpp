@@ -33,6 +33,7 @@
 
 #include "wqueue_test.h"
 #include "wqueue_scheduled_test.h"
+#include "wqueue_deadline_test.h"
 
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/app.h>
@@ -51,6 +52,13 @@ int PX4_MAIN(int argc, char **argv)
 	WQueueScheduledTest wq2;
 	wq2.main();
 
+	PX4_INFO("wqueue test 3 (deadline ordered)");
+	WQueueDeadlineTest wq3;
+
+	if (wq3.main() != 0) {
+		return 1;
+	}
+
 	PX4_INFO("wqueue test complete, exiting");
 
 	return 0;
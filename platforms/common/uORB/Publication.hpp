@@ -113,6 +113,30 @@ public:
 
 		return (Manager::orb_publish(get_topic(), _handle, &data) == PX4_OK);
 	}
+
+	/**
+	 * Loan the buffer of the next publication to fill the message in place, instead of copying it with publish().
+	 * Every successful loan must be completed with commit(), and loans must not be mixed with other
+	 * publishers of the same topic instance.
+	 * @return the message to fill, nullptr if no loan is possible (use publish() instead)
+	 */
+	T *loan()
+	{
+		if (!advertised()) {
+			advertise();
+		}
+
+		return static_cast<T *>(Manager::orb_loan(_handle));
+	}
+
+	/**
+	 * Publish a message obtained with loan()
+	 * @param data The loaned message.
+	 */
+	bool commit(T *data)
+	{
+		return (Manager::orb_commit_loan(get_topic(), _handle, data) == PX4_OK);
+	}
 };
 
 /**
@@ -171,6 +171,26 @@ public:
 		return valid() ? Manager::orb_data_copy(_node, dst, _last_generation, false) : false;
 	}
 
+	/**
+	 * Borrow a read-only view of the next update instead of copying it.
+	 * Publications can overwrite the data at any time, so it must only be trusted
+	 * if borrow_valid() still returns true after it has been used.
+	 * @return pointer to the message, nullptr if there is no update or borrowing is not available (protected build)
+	 */
+	const void *borrow()
+	{
+		if (!valid()) {
+			subscribe();
+		}
+
+		return valid() ? Manager::orb_data_borrow(_node, _last_generation, true) : nullptr;
+	}
+
+	/**
+	 * Check that the data returned by the last borrow() has not been overwritten since.
+	 */
+	bool borrow_valid() { return valid() ? Manager::orb_data_borrow_valid(_node, _last_generation) : false; }
+
 	/**
 	 * Change subscription instance
 	 * @param instance The new multi-Subscription instance
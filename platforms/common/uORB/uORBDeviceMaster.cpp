@@ -95,62 +95,64 @@ int uORB::DeviceMaster::advertise(const struct orb_metadata *meta, bool is_adver
 			*instance = group_tries;
 		}
 
-		/* construct the new node, passing the ownership of path to it */
-		uORB::DeviceNode *node = new uORB::DeviceNode(meta, group_tries, nodepath);
-
-		/* if we didn't get a device, that's bad */
-		if (node == nullptr) {
-			return -ENOMEM;
-		}
-
-		/* initialise the node - this may fail if e.g. a node with this name already exists */
-		ret = node->init();
-
-		/* if init failed, discard the node and its name */
-		if (ret != PX4_OK) {
-			delete node;
-
-			if (ret == -EEXIST) {
-				/* if the node exists already, get the existing one and check if it's advertised. */
-				uORB::DeviceNode *existing_node = getDeviceNodeLocked(meta, group_tries);
-
-				/*
-				 * We can claim an existing node in these cases:
-				 * - The node is not advertised (yet). It means there is already one or more subscribers or it was
-				 *   unadvertised.
-				 * - We are a single-instance advertiser requesting the first instance.
-				 *   (Usually we don't end up here, but we might in case of a race condition between 2
-				 *   advertisers).
-				 * - We are a subscriber requesting a certain instance.
-				 *   (Also we usually don't end up in that case, but we might in case of a race condtion
-				 *   between an advertiser and subscriber).
-				 */
-				bool is_single_instance_advertiser = is_advertiser && !instance;
-
-				if (existing_node != nullptr &&
-				    (!existing_node->is_advertised() || is_single_instance_advertiser || !is_advertiser)) {
-					if (is_advertiser) {
-						/* Set as advertised to avoid race conditions (otherwise 2 multi-instance advertisers
-						 * could get the same instance).
-						 */
-						existing_node->mark_as_advertised();
-					}
+		/* look up an existing node first, which avoids constructing and registering a throw-away node */
+		uORB::DeviceNode *existing_node = getDeviceNodeLocked(meta, group_tries);
+
+		if (existing_node != nullptr) {
+			/*
+			 * We can claim an existing node in these cases:
+			 * - The node is not advertised (yet). It means there is already one or more subscribers or it was
+			 *   unadvertised.
+			 * - We are a single-instance advertiser requesting the first instance.
+			 *   (Usually we don't end up here, but we might in case of a race condition between 2
+			 *   advertisers).
+			 * - We are a subscriber requesting a certain instance.
+			 *   (Also we usually don't end up in that case, but we might in case of a race condtion
+			 *   between an advertiser and subscriber).
+			 */
+			bool is_single_instance_advertiser = is_advertiser && !instance;
+
+			if (!existing_node->is_advertised() || is_single_instance_advertiser || !is_advertiser) {
+				if (is_advertiser) {
+					/* Set as advertised to avoid race conditions (otherwise 2 multi-instance advertisers
+					 * could get the same instance).
+					 */
+					existing_node->mark_as_advertised();
+				}
 
-					ret = PX4_OK;
+				ret = PX4_OK;
 
-				} else {
-					/* otherwise: already advertised, keep looking */
-				}
+			} else {
+				/* otherwise: already advertised, keep looking */
+				ret = -EEXIST;
 			}
 
 		} else {
-			if (is_advertiser) {
-				node->mark_as_advertised();
+			/* construct the new node, passing the ownership of path to it */
+			uORB::DeviceNode *node = new uORB::DeviceNode(meta, group_tries, nodepath);
+
+			/* if we didn't get a device, that's bad */
+			if (node == nullptr) {
+				return -ENOMEM;
 			}
 
-			// add to the node map.
-			_node_list.add(node);
-			_node_exists[node->get_instance()].set((orb_id_size_t)node->id(), true);
+			/* initialise the node - this may fail if e.g. a node with this name already exists */
+			ret = node->init();
+
+			/* if init failed, discard the node and its name */
+			if (ret != PX4_OK) {
+				delete node;
+
+			} else {
+				if (is_advertiser) {
+					node->mark_as_advertised();
+				}
+
+				// add to the node map.
+				_node_list.add(node);
+				addToIndexLocked(node);
+				_node_exists[node->get_instance()].set((orb_id_size_t)node->id(), true);
+			}
 		}
 
 		group_tries++;
@@ -449,11 +451,37 @@ uORB::DeviceNode *uORB::DeviceMaster::getDeviceNode(const char *nodepath)
 
 uORB::DeviceNode *uORB::DeviceMaster::getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance)
 {
-	for (uORB::DeviceNode *node : _node_list) {
-		if ((strcmp(node->get_name(), meta->o_name) == 0) && (node->get_instance() == instance)) {
+	if ((meta == nullptr) || (meta->o_id >= ORB_TOPICS_COUNT)) {
+		return nullptr;
+	}
+
+	// instances of a topic are chained in ascending order, so this is bounded by ORB_MULTI_MAX_INSTANCES
+	for (uORB::DeviceNode *node = _node_index[meta->o_id]; node != nullptr; node = node->_next_instance) {
+		if (node->get_instance() == instance) {
 			return node;
+
+		} else if (node->get_instance() > instance) {
+			break;
 		}
 	}
 
 	return nullptr;
 }
+
+void uORB::DeviceMaster::addToIndexLocked(uORB::DeviceNode *node)
+{
+	const orb_id_size_t id = (orb_id_size_t)node->id();
+
+	if (id >= ORB_TOPICS_COUNT) {
+		return;
+	}
+
+	uORB::DeviceNode **insert = &_node_index[id];
+
+	while ((*insert != nullptr) && ((*insert)->get_instance() < node->get_instance())) {
+		insert = &(*insert)->_next_instance;
+	}
+
+	node->_next_instance = *insert;
+	*insert = node;
+}
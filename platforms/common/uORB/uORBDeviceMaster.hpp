@@ -133,13 +133,20 @@ private:
 	friend class uORB::Manager;
 
 	/**
-	 * Find a node give its name.
+	 * Find a node given its topic and instance, in constant time through _node_index.
 	 * _lock must already be held when calling this.
 	 * @return node if exists, nullptr otherwise
 	 */
 	uORB::DeviceNode *getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance);
 
+	/**
+	 * Insert a newly created node into _node_index.
+	 * _lock must already be held when calling this.
+	 */
+	void addToIndexLocked(uORB::DeviceNode *node);
+
 	IntrusiveSortedList<uORB::DeviceNode *> _node_list;
+	uORB::DeviceNode *_node_index[ORB_TOPICS_COUNT] {}; ///< lowest instance node per ORB_ID, further instances chained by instance
 	AtomicBitset<ORB_TOPICS_COUNT> _node_exists[ORB_MULTI_MAX_INSTANCES];
 
 	px4_sem_t	_lock; /**< lock to protect access to all class members (also for derived classes) */
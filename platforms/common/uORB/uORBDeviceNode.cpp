@@ -58,6 +58,7 @@ uORB::DeviceNode::DeviceNode(const struct orb_metadata *meta, const uint8_t inst
 uORB::DeviceNode::~DeviceNode()
 {
 	free(_data);
+	free(_loan_data);
 
 	const char *devname = get_devname();
 
@@ -187,11 +188,27 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 
 	/* Perform an atomic copy. */
 	ATOMIC_ENTER;
+
+	if (_loaned && (_meta->o_queue > 1)) {
+		/* the next slot is being written in place by the loan holder */
+		ATOMIC_LEAVE;
+		return -EBUSY;
+	}
+
+#if defined(CONFIG_ORB_SEQLOCK)
+	/* publishers are still serialized, readers retry if they overlap with this window */
+	_sequence.fetch_add(1);
+#endif // CONFIG_ORB_SEQLOCK
+
 	/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
 	unsigned generation = _generation.fetch_add(1);
 
 	memcpy(_data + (_meta->o_size * (generation % _meta->o_queue)), buffer, _meta->o_size);
 
+#if defined(CONFIG_ORB_SEQLOCK)
+	_sequence.fetch_add(1);
+#endif // CONFIG_ORB_SEQLOCK
+
 	// callbacks
 	for (auto item : _callbacks) {
 		item->call();
@@ -492,3 +509,122 @@ uORB::DeviceNode::unregister_callback(uORB::SubscriptionCallback *callback_sub)
 	_callbacks.remove(callback_sub);
 	ATOMIC_LEAVE;
 }
+
+void *
+uORB::DeviceNode::loan()
+{
+	if ((nullptr == _data) || ((_meta->o_queue == 1) && (nullptr == _loan_data))) {
+		lock();
+
+		if (nullptr == _data) {
+			const size_t data_size = _meta->o_size * _meta->o_queue;
+			_data = (uint8_t *) px4_cache_aligned_alloc(data_size);
+
+			if (_data) {
+				memset(_data, 0, data_size);
+			}
+		}
+
+		/* without a queue the loan goes to a spare buffer, as the only slot can be read at any time */
+		if ((_meta->o_queue == 1) && (nullptr == _loan_data)) {
+			_loan_data = (uint8_t *) px4_cache_aligned_alloc(_meta->o_size);
+		}
+
+		unlock();
+
+		if ((nullptr == _data) || ((_meta->o_queue == 1) && (nullptr == _loan_data))) {
+			return nullptr;
+		}
+	}
+
+	ATOMIC_ENTER;
+
+	if (_loaned) {
+		ATOMIC_LEAVE;
+		return nullptr;
+	}
+
+	_loaned = true;
+
+	uint8_t *buffer = _loan_data;
+
+	if (_meta->o_queue > 1) {
+#if defined(CONFIG_ORB_SEQLOCK)
+		/* the slot of the oldest message is overwritten until the commit: invalidate reads in flight,
+		 * but keep the sequence even, later readers skip the loaned slot (see select_slot()) */
+		_sequence.fetch_add(2);
+#endif // CONFIG_ORB_SEQLOCK
+
+		buffer = _data + (_meta->o_size * (_generation.load() % _meta->o_queue));
+	}
+
+	ATOMIC_LEAVE;
+
+	return buffer;
+}
+
+ssize_t
+uORB::DeviceNode::commit_loan()
+{
+	ATOMIC_ENTER;
+
+	if (!_loaned) {
+		ATOMIC_LEAVE;
+		return -EINVAL;
+	}
+
+	if (_meta->o_queue == 1) {
+		uint8_t *published = _loan_data;
+		_loan_data = _data;
+		_data = published;
+	}
+
+	_generation.fetch_add(1);
+	_loaned = false;
+
+#if defined(CONFIG_ORB_SEQLOCK)
+	/* invalidate reads in flight, which may have combined the previous buffer or generation with the new one */
+	_sequence.fetch_add(2);
+#endif // CONFIG_ORB_SEQLOCK
+
+	// callbacks
+	for (auto item : _callbacks) {
+		item->call();
+	}
+
+	/* Mark at least one data has been published */
+	_data_valid = true;
+
+	ATOMIC_LEAVE;
+
+	/* notify any poll waiters */
+	poll_notify(POLLIN);
+
+	return _meta->o_size;
+}
+
+const void *
+uORB::DeviceNode::borrow(unsigned &generation)
+{
+	if (nullptr == _data) {
+		return nullptr;
+	}
+
+	ATOMIC_ENTER;
+	const void *data = select_slot(generation);
+	ATOMIC_LEAVE;
+
+	return data;
+}
+
+bool
+uORB::DeviceNode::borrow_valid(unsigned generation)
+{
+	ATOMIC_ENTER;
+	/* number of publications that started writing, including a loan in progress */
+	const unsigned started = _generation.load() + (_loaned ? 1 : 0);
+	ATOMIC_LEAVE;
+
+	/* the borrowed message (generation - 1) is overwritten by the publication started 'queue' messages later */
+	return (started - (generation - 1)) <= _meta->o_queue;
+}
@@ -225,37 +225,32 @@ public:
 	bool copy(void *dst, unsigned &generation)
 	{
 		if ((dst != nullptr) && (_data != nullptr)) {
-			if (_meta->o_queue == 1) {
-				ATOMIC_ENTER;
-				memcpy(dst, _data, _meta->o_size);
-				generation = _generation.load();
-				ATOMIC_LEAVE;
-				return true;
-
-			} else {
-				ATOMIC_ENTER;
-				const unsigned current_generation = _generation.load();
-
-				if (current_generation == generation) {
-					/* The subscriber already read the latest message, but nothing new was published yet.
-					* Return the previous message
-					*/
-					--generation;
-				}
+#if defined(CONFIG_ORB_SEQLOCK)
 
-				// Compatible with normal and overflow conditions
-				if (!is_in_range(current_generation - _meta->o_queue, generation, current_generation - 1)) {
-					// Reader is too far behind: some messages are lost
-					generation = current_generation - _meta->o_queue;
-				}
+			// optimistic read, retried if a publisher was writing at the same time
+			for (int attempt = 0; attempt < SEQLOCK_READ_ATTEMPTS; attempt++) {
+				const unsigned sequence = _sequence.load();
 
-				memcpy(dst, _data + (_meta->o_size * (generation % _meta->o_queue)), _meta->o_size);
-				ATOMIC_LEAVE;
+				if ((sequence & 1) == 0) {
+					const unsigned next_generation = copy_unlocked(dst, generation);
 
-				++generation;
+					// order the data reads before re-checking the sequence
+					__atomic_thread_fence(__ATOMIC_ACQUIRE);
 
-				return true;
+					if (_sequence.load() == sequence) {
+						generation = next_generation;
+						return true;
+					}
+				}
 			}
+
+			// a publisher holds the node (e.g. a preempted lower priority thread): wait for it
+#endif // CONFIG_ORB_SEQLOCK
+			ATOMIC_ENTER;
+			generation = copy_unlocked(dst, generation);
+			ATOMIC_LEAVE;
+
+			return true;
 		}
 
 		return false;
@@ -268,6 +263,35 @@ public:
 	// remove item from list of work items
 	void unregister_callback(SubscriptionCallback *callback_sub);
 
+	/**
+	 * Loan the buffer of the next publication, so that the publisher can write it in place.
+	 * Only one loan can be outstanding per node, and it must always be completed with commit_loan().
+	 * Not callable from interrupt context.
+	 * @return pointer to o_size bytes to be filled, nullptr if a loan is already outstanding or allocation failed.
+	 */
+	void *loan();
+
+	/**
+	 * Publish the message written into the buffer returned by loan().
+	 * @return o_size on success, negative errno otherwise.
+	 */
+	ssize_t commit_loan();
+
+	/**
+	 * Borrow a read-only view of the message a subscriber reads next, instead of copying it.
+	 * The data can be overwritten by later publications at any time, so the view must be checked
+	 * with borrow_valid() after it has been used.
+	 * @param generation The generation of the subscriber, updated like with copy().
+	 * @return pointer to the message data, nullptr if no data is available.
+	 */
+	const void *borrow(unsigned &generation);
+
+	/**
+	 * Check that a view returned by borrow() has not been overwritten in the meantime.
+	 * @param generation The generation of the subscriber right after borrow().
+	 */
+	bool borrow_valid(unsigned generation);
+
 protected:
 
 	px4_pollevent_t poll_state(cdev::file_t *filp) override;
@@ -276,6 +300,7 @@ protected:
 
 private:
 	friend uORBTest::UnitTest;
+	friend uORB::DeviceMaster;
 
 	const orb_metadata *_meta; /**< object metadata information */
 
@@ -286,9 +311,68 @@ private:
 
 	const uint8_t _instance; /**< orb multi instance identifier */
 	bool _advertised{false};  /**< has ever been advertised (not necessarily published data yet) */
+	bool _loaned{false};      /**< a publisher is writing the next message in place (see loan()) */
+	uint8_t *_loan_data{nullptr}; /**< spare buffer loaned for topics without a queue, swapped with _data on commit */
 
 	int8_t _subscriber_count{0};
 
+	uORB::DeviceNode *_next_instance{nullptr}; /**< next instance of the same topic, maintained by DeviceMaster */
+
+
+	/**
+	 * Select the buffer slot of the message a subscriber reads next, without any synchronization.
+	 * @param generation generation the subscriber last read, updated to the generation after the read.
+	 * @return pointer to the message data.
+	 */
+	const uint8_t *select_slot(unsigned &generation) const
+	{
+		if (_meta->o_queue == 1) {
+			generation = _generation.load();
+			return _data;
+		}
+
+		const unsigned current_generation = _generation.load();
+
+		if (current_generation == generation) {
+			/* The subscriber already read the latest message, but nothing new was published yet.
+			* Return the previous message
+			*/
+			--generation;
+		}
+
+		// the oldest slot is being written by an outstanding loan
+		const unsigned oldest_generation = current_generation - _meta->o_queue + (_loaned ? 1 : 0);
+
+		// Compatible with normal and overflow conditions
+		if (!is_in_range(oldest_generation, generation, current_generation - 1)) {
+			// Reader is too far behind: some messages are lost
+			generation = oldest_generation;
+		}
+
+		const uint8_t *slot = _data + (_meta->o_size * (generation % _meta->o_queue));
+
+		++generation;
+
+		return slot;
+	}
+
+	/**
+	 * Copy one message from the buffer without any synchronization.
+	 * @param dst buffer into which the data is copied.
+	 * @param generation generation the subscriber last read.
+	 * @return the generation of the subscriber after the copy.
+	 */
+	unsigned copy_unlocked(void *dst, unsigned generation) const
+	{
+		memcpy(dst, select_slot(generation), _meta->o_size);
+		return generation;
+	}
+
+#if defined(CONFIG_ORB_SEQLOCK)
+	static constexpr int SEQLOCK_READ_ATTEMPTS = 4;
+
+	px4::atomic<unsigned> _sequence{0}; /**< seqlock sequence, odd while a publisher is writing */
+#endif // CONFIG_ORB_SEQLOCK
 
 // Determine the data range
 	static inline bool is_in_range(unsigned left, unsigned value, unsigned right)
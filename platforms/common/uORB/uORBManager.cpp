@@ -375,6 +375,59 @@ int uORB::Manager::orb_publish(const struct orb_metadata *meta, orb_advert_t han
 	return uORB::DeviceNode::publish(meta, handle, data);
 }
 
+void *uORB::Manager::orb_loan(orb_advert_t handle)
+{
+#ifdef ORB_USE_PUBLISHER_RULES
+
+	if (handle == _Instance) {
+		return nullptr;
+	}
+
+#endif /* ORB_USE_PUBLISHER_RULES */
+
+	if (handle == nullptr) {
+		return nullptr;
+	}
+
+	return static_cast<uORB::DeviceNode *>(handle)->loan();
+}
+
+int uORB::Manager::orb_commit_loan(const struct orb_metadata *meta, orb_advert_t handle, const void *data)
+{
+	uORB::DeviceNode *devnode = static_cast<uORB::DeviceNode *>(handle);
+
+	if ((devnode == nullptr) || (meta == nullptr) || (data == nullptr)) {
+		errno = EFAULT;
+		return PX4_ERROR;
+	}
+
+	if (devnode->get_meta()->o_id != meta->o_id) {
+		errno = EINVAL;
+		return PX4_ERROR;
+	}
+
+	const ssize_t ret = devnode->commit_loan();
+
+	if (ret < 0) {
+		errno = -ret;
+		return PX4_ERROR;
+	}
+
+#ifdef CONFIG_ORB_COMMUNICATOR
+	uORBCommunicator::IChannel *ch = get_instance()->get_uorb_communicator();
+
+	if (ch != nullptr) {
+		if (ch->send_message(meta->o_name, meta->o_size, (uint8_t *)data) != 0) {
+			PX4_ERR("Error Sending [%s] topic data over comm_channel", meta->o_name);
+			return PX4_ERROR;
+		}
+	}
+
+#endif /* CONFIG_ORB_COMMUNICATOR */
+
+	return PX4_OK;
+}
+
 int uORB::Manager::orb_copy(const struct orb_metadata *meta, int handle, void *buffer)
 {
 	int ret;
@@ -458,6 +511,24 @@ bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &genera
 	return static_cast<DeviceNode *>(node_handle)->copy(dst, generation);
 }
 
+const void *uORB::Manager::orb_data_borrow(void *node_handle, unsigned &generation, bool only_if_updated)
+{
+	if (!is_advertised(node_handle)) {
+		return nullptr;
+	}
+
+	if (only_if_updated && !static_cast<const uORB::DeviceNode *>(node_handle)->updates_available(generation)) {
+		return nullptr;
+	}
+
+	return static_cast<DeviceNode *>(node_handle)->borrow(generation);
+}
+
+bool uORB::Manager::orb_data_borrow_valid(void *node_handle, unsigned generation)
+{
+	return static_cast<DeviceNode *>(node_handle)->borrow_valid(generation);
+}
+
 // add item to list of work items to schedule on node update
 bool uORB::Manager::register_callback(void *node_handle, SubscriptionCallback *callback_sub)
 {
@@ -279,6 +279,29 @@ public:
 	 */
 	static int  orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void *data);
 
+	/**
+	 * Loan the buffer of the next publication of a topic, so that it can be written in place
+	 * instead of being copied by orb_publish(). Every successful loan must be followed by
+	 * orb_commit_loan(). Only one loan can be outstanding per topic instance.
+	 *
+	 * Not available in protected builds (the buffer lives in kernel memory).
+	 *
+	 * @handle    The handle returned from orb_advertise.
+	 * @return    pointer to the message buffer, nullptr if no loan is possible (use orb_publish() instead).
+	 */
+	static void *orb_loan(orb_advert_t handle);
+
+	/**
+	 * Publish the message written into a buffer obtained by orb_loan().
+	 *
+	 * @param meta    The uORB metadata (usually from the ORB_ID() macro)
+	 *      for the topic.
+	 * @handle    The handle returned from orb_advertise.
+	 * @param data    The buffer returned by orb_loan().
+	 * @return    OK on success, PX4_ERROR otherwise with errno set accordingly.
+	 */
+	static int  orb_commit_loan(const struct orb_metadata *meta, orb_advert_t handle, const void *data);
+
 	/**
 	 * Subscribe to a topic.
 	 *
@@ -442,6 +465,10 @@ public:
 
 	static bool orb_data_copy(void *node_handle, void *dst, unsigned &generation, bool only_if_updated);
 
+	static const void *orb_data_borrow(void *node_handle, unsigned &generation, bool only_if_updated);
+
+	static bool orb_data_borrow_valid(void *node_handle, unsigned generation);
+
 	static bool register_callback(void *node_handle, SubscriptionCallback *callback_sub);
 
 	static void unregister_callback(void *node_handle, SubscriptionCallback *callback_sub);
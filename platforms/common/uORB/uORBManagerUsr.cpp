@@ -155,6 +155,18 @@ int uORB::Manager::orb_publish(const struct orb_metadata *meta, orb_advert_t han
 	return d.ret;
 }
 
+void *uORB::Manager::orb_loan(orb_advert_t handle)
+{
+	// the topic buffers are not accessible from user space
+	return nullptr;
+}
+
+int uORB::Manager::orb_commit_loan(const struct orb_metadata *meta, orb_advert_t handle, const void *data)
+{
+	errno = ENOTSUP;
+	return PX4_ERROR;
+}
+
 int uORB::Manager::orb_copy(const struct orb_metadata *meta, int handle, void *buffer)
 {
 	int ret;
@@ -302,6 +314,17 @@ bool uORB::Manager::orb_data_copy(void *node_handle, void *dst, unsigned &genera
 	return data.ret;
 }
 
+const void *uORB::Manager::orb_data_borrow(void *node_handle, unsigned &generation, bool only_if_updated)
+{
+	// the topic buffers are not accessible from user space
+	return nullptr;
+}
+
+bool uORB::Manager::orb_data_borrow_valid(void *node_handle, unsigned generation)
+{
+	return false;
+}
+
 bool uORB::Manager::register_callback(void *node_handle, SubscriptionCallback *callback_sub)
 {
 	orbiocdevregcallback_t data = {node_handle, callback_sub, false};
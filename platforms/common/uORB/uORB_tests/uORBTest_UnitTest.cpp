@@ -39,7 +39,9 @@
 #include <errno.h>
 #include <math.h>
 #include <lib/cdev/CDev.hpp>
+#include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
+#include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionMultiArray.hpp>
 
 uORBTest::UnitTest &uORBTest::UnitTest::instance()
@@ -206,6 +208,12 @@ int uORBTest::UnitTest::test()
 		return ret;
 	}
 
+	ret = test_loan();
+
+	if (ret != OK) {
+		return ret;
+	}
+
 	return test_queue_poll_notify();
 }
 
@@ -925,6 +933,133 @@ int uORBTest::UnitTest::test_queue()
 }
 
 
+int uORBTest::UnitTest::test_loan()
+{
+	test_note("Testing loaned publications and borrowed subscriptions");
+
+	{
+		// without a queue: the loan is a spare buffer, swapped in on commit
+		uORB::Publication<orb_test_large_s> pub{ORB_ID(orb_test_large)};
+		uORB::Subscription sub{ORB_ID(orb_test_large)};
+		const orb_test_large_s *view = nullptr;
+
+		for (int i = 0; i < 3; ++i) {
+			orb_test_large_s *msg = pub.loan();
+
+			if (msg == nullptr) {
+				return test_fail("loan %d failed", i);
+			}
+
+			if (pub.loan() != nullptr) {
+				return test_fail("second outstanding loan granted");
+			}
+
+			msg->timestamp = hrt_absolute_time();
+			msg->val = i;
+			msg->junk[0] = i;
+
+			if (!pub.commit(msg)) {
+				return test_fail("commit %d failed", i);
+			}
+
+			view = static_cast<const orb_test_large_s *>(sub.borrow());
+
+			if (view == nullptr) {
+				return test_fail("borrow %d failed", i);
+			}
+
+			if ((view->val != i) || (view->junk[0] != i)) {
+				return test_fail("borrow %d mismatch: %d", i, view->val);
+			}
+
+			if (!sub.borrow_valid()) {
+				return test_fail("borrow %d invalid", i);
+			}
+
+			if (sub.borrow() != nullptr) {
+				return test_fail("spurious borrow without update");
+			}
+		}
+
+		// starting the next publication invalidates the view
+		orb_test_large_s *msg = pub.loan();
+
+		if ((msg == nullptr) || sub.borrow_valid()) {
+			return test_fail("borrow not invalidated by loan");
+		}
+
+		msg->val = 3;
+		pub.commit(msg);
+
+		orb_test_large_s u{};
+
+		if (!sub.copy(&u) || (u.val != 3)) {
+			return test_fail("copy after loan mismatch: %d", u.val);
+		}
+	}
+
+	{
+		// queued: the loan is the next slot of the queue
+		uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium_queue)};
+		uORB::Subscription sub{ORB_ID(orb_test_medium_queue)};
+		const int queue_size = orb_get_queue_size(ORB_ID(orb_test_medium_queue));
+		orb_test_medium_s u{};
+
+		while (sub.update(&u)) {}
+
+		for (int i = 0; i < queue_size; ++i) {
+			orb_test_medium_s *msg = pub.loan();
+
+			if (msg == nullptr) {
+				return test_fail("queued loan %d failed", i);
+			}
+
+			if (i == 0) {
+				orb_test_medium_s t{};
+
+				if (pub.publish(t)) {
+					return test_fail("publish succeeded during loan");
+				}
+			}
+
+			msg->val = 100 + i;
+			pub.commit(msg);
+		}
+
+		for (int i = 0; i < queue_size; ++i) {
+			const orb_test_medium_s *view = static_cast<const orb_test_medium_s *>(sub.borrow());
+
+			if ((view == nullptr) || (view->val != 100 + i)) {
+				return test_fail("queued borrow %d mismatch", i);
+			}
+
+			if (!sub.borrow_valid()) {
+				return test_fail("queued borrow %d invalid", i);
+			}
+
+			if (i == 0) {
+				// the oldest message is overwritten by the next loan
+				orb_test_medium_s *msg = pub.loan();
+
+				if ((msg == nullptr) || sub.borrow_valid()) {
+					return test_fail("queued borrow not invalidated by loan");
+				}
+
+				msg->val = 100 + queue_size;
+				pub.commit(msg);
+			}
+		}
+
+		const orb_test_medium_s *view = static_cast<const orb_test_medium_s *>(sub.borrow());
+
+		if ((view == nullptr) || (view->val != 100 + queue_size)) {
+			return test_fail("queued borrow after overwrite mismatch");
+		}
+	}
+
+	return test_note("PASS orb loan");
+}
+
 int uORBTest::UnitTest::pub_test_queue_entry(int argc, char *argv[])
 {
 	uORBTest::UnitTest &t = uORBTest::UnitTest::instance();
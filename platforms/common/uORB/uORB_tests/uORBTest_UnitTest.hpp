@@ -108,6 +108,8 @@ private:
 
 	int test_SubscriptionMulti();
 
+	int test_loan();
+
 	/* queuing tests */
 	int test_queue();
 	static int pub_test_queue_entry(int argc, char *argv[]);
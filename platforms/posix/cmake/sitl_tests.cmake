@@ -100,6 +100,19 @@ set_tests_properties(sitl-imu_filtering PROPERTIES FAIL_REGULAR_EXPRESSION "FAIL
 set_tests_properties(sitl-imu_filtering PROPERTIES PASS_REGULAR_EXPRESSION "ALL TESTS PASSED")
 sanitizer_fail_test_on_error(sitl-imu_filtering)
 
+# Multi-EKF benchmark (per IMU threads vs shared thread pool)
+add_test(NAME sitl-ekf2_multi_pool
+	COMMAND $<TARGET_FILE:px4>
+		-s ${PX4_SOURCE_DIR}/posix-configs/SITL/init/test/test_ekf2_multi_pool
+		-t ${PX4_SOURCE_DIR}/test_data
+		${PX4_SOURCE_DIR}/ROMFS/px4fmu_test
+	WORKING_DIRECTORY ${SITL_WORKING_DIR}
+)
+
+set_tests_properties(sitl-ekf2_multi_pool PROPERTIES FAIL_REGULAR_EXPRESSION "FAIL")
+set_tests_properties(sitl-ekf2_multi_pool PROPERTIES PASS_REGULAR_EXPRESSION "ALL TESTS PASSED")
+sanitizer_fail_test_on_error(sitl-ekf2_multi_pool)
+
 
 
 # # Shutdown test
@@ -35,19 +35,35 @@
 
 using namespace time_literals;
 
-FakeImu::FakeImu() :
+FakeImu::FakeImu(int instances) :
 	ModuleParams(nullptr),
 	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::hp_default),
-	_px4_accel(1310988), // 1310988: DRV_IMU_DEVTYPE_SIM, BUS: 1, ADDR: 1, TYPE: SIMULATION
-	_px4_gyro(1310988)   // 1310988: DRV_IMU_DEVTYPE_SIM, BUS: 1, ADDR: 1, TYPE: SIMULATION
+	_instances(math::constrain(instances, 1, MAX_INSTANCES))
 {
-	_sensor_interval_us = roundf(1.e6f / _px4_gyro.get_max_rate_hz());
+	for (int i = 0; i < _instances; i++) {
+		// 1310988: DRV_IMU_DEVTYPE_SIM, BUS: 1, ADDR: 1, TYPE: SIMULATION (ADDR incremented per instance)
+		const uint32_t device_id = 1310988 + (i << 8);
 
-	PX4_INFO("Rate %.3f, Interval: %" PRId32 " us", (double)_px4_gyro.get_max_rate_hz(), _sensor_interval_us);
+		_px4_accel[i] = new PX4Accelerometer(device_id);
+		_px4_gyro[i] = new PX4Gyroscope(device_id);
 
-	_px4_accel.set_range(2000.f); // don't care
+		_px4_accel[i]->set_range(2000.f); // don't care
 
-	_px4_gyro.set_scale(math::radians(2000.f) / static_cast<float>(INT16_MAX - 1)); // 2000 degrees/second max
+		_px4_gyro[i]->set_scale(math::radians(2000.f) / static_cast<float>(INT16_MAX - 1)); // 2000 degrees/second max
+	}
+
+	_sensor_interval_us = roundf(1.e6f / _px4_gyro[0]->get_max_rate_hz());
+
+	PX4_INFO("Rate %.3f, Interval: %" PRId32 " us, instances: %d", (double)_px4_gyro[0]->get_max_rate_hz(),
+		 _sensor_interval_us, _instances);
+}
+
+FakeImu::~FakeImu()
+{
+	for (int i = 0; i < _instances; i++) {
+		delete _px4_accel[i];
+		delete _px4_gyro[i];
+	}
 }
 
 bool FakeImu::init()
@@ -114,11 +130,16 @@ void FakeImu::Run()
 			y_freq = (y_f1 - y_f0) * (t / T) + y_f0;
 			z_freq = (z_f1 - z_f0) * (t / T) + z_f0;
 
-			_px4_accel.update(gyro.timestamp_sample, x_freq, y_freq, z_freq);
+			for (int i = 0; i < _instances; i++) {
+				_px4_accel[i]->update(gyro.timestamp_sample, x_freq, y_freq, z_freq);
+			}
 		}
 	}
 
-	_px4_gyro.updateFIFO(gyro);
+	for (int i = 0; i < _instances; i++) {
+		sensor_gyro_fifo_s gyro_fifo{gyro}; // updated in place (rotation)
+		_px4_gyro[i]->updateFIFO(gyro_fifo);
+	}
 
 #if defined(FAKE_IMU_FAKE_ESC_STATUS)
 
@@ -165,7 +186,23 @@ void FakeImu::Run()
 
 int FakeImu::task_spawn(int argc, char *argv[])
 {
-	FakeImu *instance = new FakeImu();
+	int instances = 1;
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "n:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'n':
+			instances = strtol(myoptarg, nullptr, 10);
+			break;
+
+		default:
+			return print_usage("unrecognized flag");
+		}
+	}
+
+	FakeImu *instance = new FakeImu(instances);
 
 	if (instance) {
 		_object.store(instance);
@@ -205,6 +242,7 @@ int FakeImu::print_usage(const char *reason)
 
 	PRINT_MODULE_USAGE_NAME("fake_imu", "driver");
 	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_PARAM_INT('n', 1, 1, 4, "Number of IMUs", true);
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 	return 0;
 }
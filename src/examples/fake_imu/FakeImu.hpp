@@ -34,6 +34,7 @@
 #pragma once
 
 #include <px4_platform_common/defines.h>
+#include <px4_platform_common/getopt.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/posix.h>
@@ -54,8 +55,8 @@
 class FakeImu : public ModuleBase<FakeImu>, public ModuleParams, public px4::ScheduledWorkItem
 {
 public:
-	FakeImu();
-	~FakeImu() override = default;
+	explicit FakeImu(int instances = 1);
+	~FakeImu() override;
 
 	/** @see ModuleBase */
 	static int task_spawn(int argc, char *argv[]);
@@ -70,11 +71,14 @@ public:
 
 private:
 	static constexpr double IMU_RATE_HZ = 8000;
+	static constexpr int MAX_INSTANCES = 4;
 
 	void Run() override;
 
-	PX4Accelerometer _px4_accel;
-	PX4Gyroscope _px4_gyro;
+	const int _instances;
+
+	PX4Accelerometer *_px4_accel[MAX_INSTANCES] {};
+	PX4Gyroscope *_px4_gyro[MAX_INSTANCES] {};
 
 	hrt_abstime _time_start_us{0};
 
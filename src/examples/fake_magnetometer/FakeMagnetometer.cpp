@@ -33,17 +33,29 @@
 
 #include "FakeMagnetometer.hpp"
 
+#include <lib/mathlib/mathlib.h>
 #include <lib/world_magnetic_model/geo_mag_declination.h>
 
 using namespace matrix;
 using namespace time_literals;
 
-FakeMagnetometer::FakeMagnetometer() :
+FakeMagnetometer::FakeMagnetometer(int instances) :
 	ModuleParams(nullptr),
 	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::hp_default),
-	_px4_mag(0, ROTATION_NONE)
+	_instances(math::constrain(instances, 1, MAX_INSTANCES))
 {
-	_px4_mag.set_device_type(DRV_MAG_DEVTYPE_MAGSIM);
+	for (int i = 0; i < _instances; i++) {
+		// distinct address per instance
+		_px4_mag[i] = new PX4Magnetometer(i << 8, ROTATION_NONE);
+		_px4_mag[i]->set_device_type(DRV_MAG_DEVTYPE_MAGSIM);
+	}
+}
+
+FakeMagnetometer::~FakeMagnetometer()
+{
+	for (int i = 0; i < _instances; i++) {
+		delete _px4_mag[i];
+	}
 }
 
 bool FakeMagnetometer::init()
@@ -87,14 +99,32 @@ void FakeMagnetometer::Run()
 		if (_vehicle_attitude_sub.update(&attitude)) {
 			Vector3f expected_field = Dcmf{Quatf{attitude.q}} .transpose() * _mag_earth_pred;
 
-			_px4_mag.update(hrt_absolute_time(), expected_field(0), expected_field(1), expected_field(2));
+			for (int i = 0; i < _instances; i++) {
+				_px4_mag[i]->update(hrt_absolute_time(), expected_field(0), expected_field(1), expected_field(2));
+			}
 		}
 	}
 }
 
 int FakeMagnetometer::task_spawn(int argc, char *argv[])
 {
-	FakeMagnetometer *instance = new FakeMagnetometer();
+	int instances = 1;
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "n:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'n':
+			instances = strtol(myoptarg, nullptr, 10);
+			break;
+
+		default:
+			return print_usage("unrecognized flag");
+		}
+	}
+
+	FakeMagnetometer *instance = new FakeMagnetometer(instances);
 
 	if (instance) {
 		_object.store(instance);
@@ -135,6 +165,7 @@ Requires vehicle_attitude and vehicle_gps_position.
 
 	PRINT_MODULE_USAGE_NAME("fake_magnetometer", "driver");
 	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_PARAM_INT('n', 1, 1, 4, "Number of magnetometers", true);
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 	return 0;
 }
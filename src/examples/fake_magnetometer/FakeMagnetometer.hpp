@@ -42,6 +42,7 @@
 #pragma once
 
 #include <px4_platform_common/defines.h>
+#include <px4_platform_common/getopt.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/posix.h>
@@ -55,8 +56,8 @@
 class FakeMagnetometer : public ModuleBase<FakeMagnetometer>, public ModuleParams, public px4::ScheduledWorkItem
 {
 public:
-	FakeMagnetometer();
-	~FakeMagnetometer() override = default;
+	explicit FakeMagnetometer(int instances = 1);
+	~FakeMagnetometer() override;
 
 	/** @see ModuleBase */
 	static int task_spawn(int argc, char *argv[]);
@@ -70,9 +71,13 @@ public:
 	bool init();
 
 private:
+	static constexpr int MAX_INSTANCES = 4;
+
 	void Run() override;
 
-	PX4Magnetometer _px4_mag;
+	const int _instances;
+
+	PX4Magnetometer *_px4_mag[MAX_INSTANCES] {};
 
 	bool _mag_earth_available{false};
 
@@ -56,11 +56,14 @@ public:
 		return sz;
 	}
 
-	void push(T newNode)
+	/**
+	 * @return false if the node was already queued
+	 */
+	bool push(T newNode)
 	{
 		// error, node already queued or already inserted
 		if ((newNode->next_intrusive_queue_node() != nullptr) || (newNode == _tail)) {
-			return;
+			return false;
 		}
 
 		if (_head == nullptr) {
@@ -72,6 +75,43 @@ public:
 		}
 
 		_tail = newNode;
+
+		return true;
+	}
+
+	/**
+	 * Insert a node in front of the first queued node ranked after it, nodes ranked equal stay in FIFO order.
+	 * @param after callable, after(a, b) returns true if node a is to be dequeued after node b
+	 * @return false if the node was already queued
+	 */
+	template<typename After>
+	bool insert_sorted(T newNode, After after)
+	{
+		// error, node already queued or already inserted
+		if ((newNode->next_intrusive_queue_node() != nullptr) || (newNode == _tail)) {
+			return false;
+		}
+
+		T prev = nullptr;
+
+		for (T node = _head; node != nullptr; node = node->next_intrusive_queue_node()) {
+			if (after(node, newNode)) {
+				newNode->set_next_intrusive_queue_node(node);
+
+				if (prev == nullptr) {
+					_head = newNode;
+
+				} else {
+					prev->set_next_intrusive_queue_node(newNode);
+				}
+
+				return true;
+			}
+
+			prev = node;
+		}
+
+		return push(newNode);
 	}
 
 	T pop()
@@ -0,0 +1,170 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Validates the generated CDR serializers (uORB/cdr) against the cdrstream interpreter
+ * and compares their speed.
+ * Run this test only using make tests TESTFILTER=CdrSerializer
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+
+#include <dds_serializer.h>
+#include <px4/msg/EscStatus.h>
+#include <px4/msg/SensorCombined.h>
+#include <px4/msg/VehicleOdometry.h>
+#include <uORB/cdr/esc_status.h>
+#include <uORB/cdr/sensor_combined.h>
+#include <uORB/cdr/vehicle_odometry.h>
+
+struct CdrTopic {
+	const char *name;
+	size_t o_size;
+	const uint32_t *ops;
+	uint32_t (*serialize)(const void *data, uint8_t *buf);
+	bool (*deserialize)(const uint8_t *buf, uint32_t len, void *data);
+	uint32_t cdr_size;
+};
+
+static const CdrTopic cdr_topics[] = {
+	{ "vehicle_odometry", sizeof(vehicle_odometry_s), px4_msg_VehicleOdometry_cdrstream_desc.ops.ops, &cdr_serialize_vehicle_odometry, &cdr_deserialize_vehicle_odometry, cdr_topic_size_vehicle_odometry() },
+	{ "sensor_combined", sizeof(sensor_combined_s), px4_msg_SensorCombined_cdrstream_desc.ops.ops, &cdr_serialize_sensor_combined, &cdr_deserialize_sensor_combined, cdr_topic_size_sensor_combined() },
+	{ "esc_status", sizeof(esc_status_s), px4_msg_EscStatus_cdrstream_desc.ops.ops, &cdr_serialize_esc_status, &cdr_deserialize_esc_status, cdr_topic_size_esc_status() },
+};
+
+static constexpr size_t max_size = 1024;
+
+// the topics above contain no bool fields, so any byte pattern is valid
+static void fill(uint8_t *data, size_t size, uint32_t seed)
+{
+	for (size_t i = 0; i < size; ++i) {
+		seed = seed * 1664525u + 1013904223u;
+		data[i] = seed >> 24;
+	}
+}
+
+// serialize with the interpreter, returns the size without the encapsulation header
+static uint32_t interpreterSerialize(const CdrTopic &topic, const void *data, uint8_t *buf)
+{
+	dds_ostream_t os;
+	os.m_buffer = buf;
+	os.m_index = 4;
+	os.m_size = max_size;
+	os.m_xcdr_version = DDSI_RTPS_CDR_ENC_VERSION_2;
+
+	if (!dds_stream_write(&os, &dds_allocator, (const char *)data, topic.ops) || os.m_buffer != buf) {
+		return 0;
+	}
+
+	return os.m_index - 4;
+}
+
+static void interpreterDeserialize(const CdrTopic &topic, uint8_t *buf, uint32_t len, void *data)
+{
+	dds_istream_t is = {.m_buffer = buf, .m_size = len + 4, .m_index = 4, .m_xcdr_version = DDSI_RTPS_CDR_ENC_VERSION_2};
+	dds_stream_read(&is, (char *)data, &dds_allocator, topic.ops);
+}
+
+TEST(CdrSerializer, MatchesInterpreter)
+{
+	for (const CdrTopic &topic : cdr_topics) {
+		SCOPED_TRACE(topic.name);
+		ASSERT_LE(topic.o_size, max_size);
+
+		for (uint32_t seed = 0; seed < 10; ++seed) {
+			uint8_t data[max_size];
+			fill(data, topic.o_size, seed);
+
+			uint8_t expected[max_size] {};
+			const uint32_t expected_len = interpreterSerialize(topic, data, expected);
+			ASSERT_EQ(expected_len, topic.cdr_size);
+
+			uint8_t buf[max_size + 4] {};
+			ASSERT_EQ(topic.serialize(data, buf + 4), topic.cdr_size);
+			EXPECT_EQ(memcmp(buf + 4, expected + 4, topic.cdr_size), 0);
+
+			// round trip: both deserializers must produce a message that serializes to the same stream
+			uint8_t generated_data[max_size] {};
+			ASSERT_TRUE(topic.deserialize(buf + 4, topic.cdr_size, generated_data));
+			EXPECT_FALSE(topic.deserialize(buf + 4, topic.cdr_size - 1, generated_data));
+
+			uint8_t interpreted_data[max_size] {};
+			interpreterDeserialize(topic, buf, topic.cdr_size, interpreted_data);
+
+			uint8_t round_trip[max_size] {};
+			topic.serialize(generated_data, round_trip);
+			EXPECT_EQ(memcmp(round_trip, expected + 4, topic.cdr_size), 0);
+
+			topic.serialize(interpreted_data, round_trip);
+			EXPECT_EQ(memcmp(round_trip, expected + 4, topic.cdr_size), 0);
+		}
+	}
+}
+
+TEST(CdrSerializer, Benchmark)
+{
+	static constexpr int iterations = 100000;
+
+	for (const CdrTopic &topic : cdr_topics) {
+		uint8_t data[max_size];
+		fill(data, topic.o_size, 1);
+		uint8_t buf[max_size] {};
+		uint32_t check = 0;
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < iterations; ++i) {
+			data[0] = i;
+			check += interpreterSerialize(topic, data, buf) + buf[4];
+		}
+
+		const std::chrono::duration<double, std::nano> interpreter = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < iterations; ++i) {
+			data[0] = i;
+			check -= topic.serialize(data, buf + 4) + buf[4];
+		}
+
+		const std::chrono::duration<double, std::nano> generated = std::chrono::steady_clock::now() - start;
+
+		printf("%-18s interpreter: %6.1f ns, generated: %6.1f ns per message\n", topic.name,
+		       interpreter.count() / iterations, generated.count() / iterations);
+
+		EXPECT_EQ(check, 0u);
+	}
+}
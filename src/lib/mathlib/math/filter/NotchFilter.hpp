@@ -90,7 +90,6 @@ public:
 	float getNotchFreq() const { return _notch_freq; }
 	float getBandwidth() const { return _bandwidth; }
 
-	// Used in unit test only
 	void getCoefficients(float a[3], float b[3]) const
 	{
 		a[0] = 1.f;
@@ -128,6 +127,26 @@ public:
 		_b2 = b[2];
 	}
 
+	/**
+	 * Direct Form I delay elements, used by NotchFilterBank to run the filter outside of this class
+	 */
+	void getState(T &input_1, T &input_2, T &output_1, T &output_2) const
+	{
+		input_1 = _delay_element_1;
+		input_2 = _delay_element_2;
+		output_1 = _delay_element_output_1;
+		output_2 = _delay_element_output_2;
+	}
+
+	void setState(const T &input_1, const T &input_2, const T &output_1, const T &output_2)
+	{
+		_delay_element_1 = input_1;
+		_delay_element_2 = input_2;
+		_delay_element_output_1 = output_1;
+		_delay_element_output_2 = output_2;
+		_initialized = true;
+	}
+
 	bool initialized() const { return _initialized; }
 
 	void reset() { _initialized = false; }
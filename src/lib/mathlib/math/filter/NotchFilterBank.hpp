@@ -0,0 +1,222 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/*
+ * @file NotchFilterBank.hpp
+ *
+ * @brief Cascades of notch filters applied to the 3 axes of a signal at once.
+ */
+
+#pragma once
+
+#include "NotchFilter.hpp"
+
+#include <stdint.h>
+
+namespace math
+{
+
+/**
+ * Applies per axis cascades of NotchFilter<float> to a 3 axis signal.
+ *
+ * The filters keep owning their parameters and state. For each applyArray() call the bank gathers the
+ * coefficients and delay elements of all stages into a structure of arrays with one lane per axis,
+ * runs the whole cascade of all axes sample by sample with 4-wide vector arithmetic (SSE/NEON where
+ * the compiler supports it, plain scalar code otherwise) and writes the state back.
+ * Axes with fewer stages are padded with pass-through stages.
+ */
+class NotchFilterBank
+{
+public:
+	NotchFilterBank() = default;
+	~NotchFilterBank() { delete[] _stages; delete[] _filters; }
+
+	NotchFilterBank(const NotchFilterBank &) = delete;
+	NotchFilterBank &operator=(const NotchFilterBank &) = delete;
+
+	/**
+	 * Allocate space for up to max_stages filters per axis. Clears the bank.
+	 * @return false on allocation failure
+	 */
+	bool reserve(int max_stages)
+	{
+		clear();
+
+		if (max_stages == _max_stages) {
+			return true;
+		}
+
+		delete[] _stages;
+		delete[] _filters;
+		_stages = new Stage[max_stages];
+		_filters = new NotchFilter<float> *[max_stages * AXES];
+
+		if (_stages == nullptr || _filters == nullptr) {
+			delete[] _stages;
+			delete[] _filters;
+			_stages = nullptr;
+			_filters = nullptr;
+			_max_stages = 0;
+			return false;
+		}
+
+		_max_stages = max_stages;
+		return true;
+	}
+
+	/**
+	 * Remove all filters, to be called before adding the filters for the next applyArray()
+	 */
+	void clear()
+	{
+		for (int axis = 0; axis < AXES; axis++) {
+			_num_stages[axis] = 0;
+		}
+	}
+
+	/**
+	 * Append a filter to the cascade of an axis
+	 * @return false if the bank is full
+	 */
+	bool add(int axis, NotchFilter<float> &filter)
+	{
+		if (_num_stages[axis] >= _max_stages) {
+			return false;
+		}
+
+		_filters[_num_stages[axis] * AXES + axis] = &filter;
+		_num_stages[axis]++;
+		return true;
+	}
+
+	/**
+	 * Filter the samples of all axes in place, with the same result as calling
+	 * NotchFilter::applyArray() for each filter in the order they were added.
+	 */
+	void applyArray(float *data[3], int num_samples)
+	{
+		const int num_stages = max(max(_num_stages[0], _num_stages[1]), _num_stages[2]);
+
+		if (num_stages == 0 || num_samples <= 0) {
+			return;
+		}
+
+		// the first sample goes through the filters themselves, which handles their (re)initialization
+		for (int axis = 0; axis < AXES; axis++) {
+			for (int stage = 0; stage < _num_stages[axis]; stage++) {
+				data[axis][0] = _filters[stage * AXES + axis]->apply(data[axis][0]);
+			}
+		}
+
+		if (num_samples == 1) {
+			return;
+		}
+
+		// gather
+		for (int stage = 0; stage < num_stages; stage++) {
+			Stage &s = _stages[stage];
+
+			for (int axis = 0; axis < LANES; axis++) {
+				if (axis < AXES && stage < _num_stages[axis]) {
+					const NotchFilter<float> &filter = *_filters[stage * AXES + axis];
+					float a[3];
+					float b[3];
+					filter.getCoefficients(a, b);
+					s.b0[axis] = b[0];
+					s.b1[axis] = b[1];
+					s.b2[axis] = b[2];
+					s.a1[axis] = a[1];
+					s.a2[axis] = a[2];
+					filter.getState(s.x1[axis], s.x2[axis], s.y1[axis], s.y2[axis]);
+
+				} else {
+					// pass-through
+					s.b0[axis] = 1.f;
+					s.b1[axis] = s.b2[axis] = s.a1[axis] = s.a2[axis] = 0.f;
+					s.x1[axis] = s.x2[axis] = s.y1[axis] = s.y2[axis] = 0.f;
+				}
+			}
+		}
+
+		// filter, Direct Form I
+		for (int n = 1; n < num_samples; n++) {
+			float4 sample{data[0][n], data[1][n], data[2][n], 0.f};
+
+			for (int stage = 0; stage < num_stages; stage++) {
+				Stage &s = _stages[stage];
+				const float4 output = s.b0 * sample + s.b1 * s.x1 + s.b2 * s.x2 - s.a1 * s.y1 - s.a2 * s.y2;
+
+				s.x2 = s.x1;
+				s.x1 = sample;
+				s.y2 = s.y1;
+				s.y1 = output;
+
+				sample = output;
+			}
+
+			data[0][n] = sample[0];
+			data[1][n] = sample[1];
+			data[2][n] = sample[2];
+		}
+
+		// scatter
+		for (int axis = 0; axis < AXES; axis++) {
+			for (int stage = 0; stage < _num_stages[axis]; stage++) {
+				const Stage &s = _stages[stage];
+				_filters[stage * AXES + axis]->setState(s.x1[axis], s.x2[axis], s.y1[axis], s.y2[axis]);
+			}
+		}
+	}
+
+	int maxStages() const { return _max_stages; }
+
+private:
+	static constexpr int AXES = 3;
+	static constexpr int LANES = 4;
+
+	// GCC/Clang vector extension: maps to SSE/NEON registers, or to scalar code on targets without SIMD.
+	// The alignment is relaxed so that heap allocated stages don't need over-aligned new.
+	typedef float float4 __attribute__((vector_size(LANES * sizeof(float)), aligned(sizeof(float))));
+
+	struct Stage {
+		float4 b0, b1, b2, a1, a2;
+		float4 x1, x2, y1, y2;
+	};
+
+	Stage *_stages{nullptr};
+	NotchFilter<float> **_filters{nullptr}; ///< [stage][axis]
+	int _max_stages{0};
+	int _num_stages[AXES] {};
+};
+
+} // namespace math
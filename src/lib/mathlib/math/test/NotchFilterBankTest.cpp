@@ -0,0 +1,161 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the Notch filter bank
+ * Run this test only using make tests TESTFILTER=NotchFilterBank
+ */
+
+#include <gtest/gtest.h>
+
+#include <lib/mathlib/math/filter/NotchFilter.hpp>
+#include <lib/mathlib/math/filter/NotchFilterBank.hpp>
+
+#include <stdlib.h>
+
+using namespace math;
+
+class NotchFilterBankTest : public ::testing::Test
+{
+public:
+	static constexpr int MAX_STAGES = 6;
+	static constexpr int MAX_SAMPLES = 16;
+	const float _sample_freq = 8000.f;
+
+	void SetUp() override
+	{
+		srand(0);
+
+		for (int axis = 0; axis < 3; axis++) {
+			for (int stage = 0; stage < MAX_STAGES; stage++) {
+				const float notch_freq = 100.f + 150.f * stage + 10.f * axis;
+				_notch[axis][stage].setParameters(_sample_freq, notch_freq, 20.f);
+				_notch_reference[axis][stage].setParameters(_sample_freq, notch_freq, 20.f);
+			}
+		}
+
+		ASSERT_TRUE(_bank.reserve(MAX_STAGES));
+	}
+
+	float random() const { return 2.f * (rand() / (float)RAND_MAX) - 1.f; }
+
+	NotchFilter<float> _notch[3][MAX_STAGES];
+	NotchFilter<float> _notch_reference[3][MAX_STAGES];
+	NotchFilterBank _bank;
+};
+
+TEST_F(NotchFilterBankTest, sameAsSeparateFilters)
+{
+	// different number of stages per axis and varying FIFO lengths
+	const int num_stages[3] {MAX_STAGES, 2, 0};
+
+	for (int iteration = 0; iteration < 200; iteration++) {
+		const int num_samples = 1 + iteration % MAX_SAMPLES;
+
+		float data[3][MAX_SAMPLES];
+		float data_reference[3][MAX_SAMPLES];
+		float *data_array[3] {data[0], data[1], data[2]};
+
+		for (int axis = 0; axis < 3; axis++) {
+			for (int n = 0; n < num_samples; n++) {
+				data[axis][n] = data_reference[axis][n] = random();
+			}
+		}
+
+		_bank.clear();
+
+		for (int axis = 0; axis < 3; axis++) {
+			for (int stage = 0; stage < num_stages[axis]; stage++) {
+				EXPECT_TRUE(_bank.add(axis, _notch[axis][stage]));
+				_notch_reference[axis][stage].applyArray(data_reference[axis], num_samples);
+			}
+		}
+
+		_bank.applyArray(data_array, num_samples);
+
+		for (int axis = 0; axis < 3; axis++) {
+			for (int n = 0; n < num_samples; n++) {
+				EXPECT_NEAR(data[axis][n], data_reference[axis][n], 1e-5f);
+			}
+		}
+	}
+}
+
+TEST_F(NotchFilterBankTest, stagesChangingBetweenCalls)
+{
+	// filters enabled and disabled between calls keep their own state, like the dynamic notch filters
+	for (int iteration = 0; iteration < 100; iteration++) {
+		const int num_samples = 8;
+		const int num_stages = 1 + (iteration / 10) % MAX_STAGES;
+
+		float data[3][num_samples];
+		float data_reference[3][num_samples];
+		float *data_array[3] {data[0], data[1], data[2]};
+
+		for (int axis = 0; axis < 3; axis++) {
+			for (int n = 0; n < num_samples; n++) {
+				data[axis][n] = data_reference[axis][n] = random();
+			}
+		}
+
+		_bank.clear();
+
+		for (int axis = 0; axis < 3; axis++) {
+			for (int stage = 0; stage < num_stages; stage++) {
+				_bank.add(axis, _notch[axis][stage]);
+				_notch_reference[axis][stage].applyArray(data_reference[axis], num_samples);
+			}
+		}
+
+		_bank.applyArray(data_array, num_samples);
+
+		for (int axis = 0; axis < 3; axis++) {
+			for (int n = 0; n < num_samples; n++) {
+				EXPECT_NEAR(data[axis][n], data_reference[axis][n], 1e-5f);
+			}
+		}
+	}
+}
+
+TEST_F(NotchFilterBankTest, full)
+{
+	for (int stage = 0; stage < MAX_STAGES; stage++) {
+		EXPECT_TRUE(_bank.add(0, _notch[0][stage]));
+	}
+
+	EXPECT_FALSE(_bank.add(0, _notch[1][0]));
+	EXPECT_TRUE(_bank.add(1, _notch[1][0]));
+
+	_bank.clear();
+	EXPECT_TRUE(_bank.add(0, _notch[0][0]));
+}
@@ -13,6 +13,7 @@
 #include <cstring>
 
 #include "helper_functions.hpp"
+#include "simd.hpp"
 #include "Slice.hpp"
 
 namespace matrix
@@ -151,6 +152,11 @@ public:
 		const Matrix<Type, M, N> &self = *this;
 		Matrix<Type, M, P> res{};
 
+		if (simd::Multiply<Type, M, N, P>::supported) {
+			simd::Multiply<Type, M, N, P>::apply(&self(0, 0), &other(0, 0), &res(0, 0));
+			return res;
+		}
+
 		for (size_t i = 0; i < M; i++) {
 			for (size_t k = 0; k < P; k++) {
 				for (size_t j = 0; j < N; j++) {
@@ -164,11 +170,16 @@ public:
 
 	// Using this function reduces the number of temporary variables needed to compute A * B.T
 	template<size_t P>
-	Matrix<Type, M, M> multiplyByTranspose(const Matrix<Type, P, N> &other) const
+	Matrix<Type, M, P> multiplyByTranspose(const Matrix<Type, P, N> &other) const
 	{
 		Matrix<Type, M, P> res;
 		const Matrix<Type, M, N> &self = *this;
 
+		if (simd::MultiplyByTranspose<Type, M, N, P>::supported) {
+			simd::MultiplyByTranspose<Type, M, N, P>::apply(&self(0, 0), &other(0, 0), &res(0, 0));
+			return res;
+		}
+
 		for (size_t i = 0; i < M; i++) {
 			for (size_t k = 0; k < P; k++) {
 				for (size_t j = 0; j < N; j++) {
@@ -440,6 +451,11 @@ public:
 		Matrix<Type, N, M> res;
 		const Matrix<Type, M, N> &self = *this;
 
+		if (simd::Transpose<Type, M, N>::supported) {
+			simd::Transpose<Type, M, N>::apply(&self(0, 0), &res(0, 0));
+			return res;
+		}
+
 		for (size_t i = 0; i < M; i++) {
 			for (size_t j = 0; j < N; j++) {
 				res(j, i) = self(i, j);
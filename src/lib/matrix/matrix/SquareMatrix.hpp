@@ -10,6 +10,7 @@
 
 #include <float.h> // FLT_EPSILON
 
+#include "simd.hpp"
 #include "Slice.hpp"
 
 namespace matrix
@@ -424,9 +425,7 @@ bool inv(const SquareMatrix<Type, M> &A, SquareMatrix<Type, M> &inv, size_t rank
 
 			// add i-th row and n-th row
 			// multiplied by: -a(i,n)/a(n,n)
-			for (size_t k = n; k < rank; k++) {
-				U(i, k) -= L(i, n) * U(n, k);
-			}
+			simd::RowOps<Type>::subtractScaled(&U(i, n), &U(n, n), L(i, n), rank - n);
 		}
 	}
 
@@ -436,24 +435,22 @@ bool inv(const SquareMatrix<Type, M> &A, SquareMatrix<Type, M> &inv, size_t rank
 	// solve LY=P*I for Y by forward subst
 	//SquareMatrix<Type, M> Y = P;
 
-	// for all columns of Y
-	for (size_t c = 0; c < rank; c++) {
-		// for all rows of L
-		for (size_t i = 0; i < rank; i++) {
-			// for all columns of L
-			for (size_t j = 0; j < i; j++) {
-				// for all existing y
-				// subtract the component they
-				// contribute to the solution
-				P(i, c) -= L(i, j) * P(j, c);
-			}
-
-			// divide by the factor
-			// on current
-			// term to be solved
-			// Y(i,c) /= L(i,i);
-			// but L(i,i) = 1.0
+	// for all rows of L
+	// (the columns of Y are independent, solve them together row by row)
+	for (size_t i = 0; i < rank; i++) {
+		// for all columns of L
+		for (size_t j = 0; j < i; j++) {
+			// for all existing y
+			// subtract the component they
+			// contribute to the solution
+			simd::RowOps<Type>::subtractScaled(&P(i, 0), &P(j, 0), L(i, j), rank);
 		}
+
+		// divide by the factor
+		// on current
+		// term to be solved
+		// Y(i,:) /= L(i,i);
+		// but L(i,i) = 1.0
 	}
 
 	//printf("Y:\n"); Y.print();
@@ -461,28 +458,25 @@ bool inv(const SquareMatrix<Type, M> &A, SquareMatrix<Type, M> &inv, size_t rank
 	// solve Ux=y for x by back subst
 	//SquareMatrix<Type, M> X = Y;
 
-	// for all columns of X
-	for (size_t c = 0; c < rank; c++) {
-		// for all rows of U
-		for (size_t k = 0; k < rank; k++) {
-			// have to go in reverse order
-			size_t i = rank - 1 - k;
-
-			// for all columns of U
-			for (size_t j = i + 1; j < rank; j++) {
-				// for all existing x
-				// subtract the component they
-				// contribute to the solution
-				P(i, c) -= U(i, j) * P(j, c);
-			}
-
-			// divide by the factor
-			// on current
-			// term to be solved
-			//
-			// we know that U(i, i) != 0 from above
-			P(i, c) /= U(i, i);
+	// for all rows of U
+	for (size_t k = 0; k < rank; k++) {
+		// have to go in reverse order
+		size_t i = rank - 1 - k;
+
+		// for all columns of U
+		for (size_t j = i + 1; j < rank; j++) {
+			// for all existing x
+			// subtract the component they
+			// contribute to the solution
+			simd::RowOps<Type>::subtractScaled(&P(i, 0), &P(j, 0), U(i, j), rank);
 		}
+
+		// divide by the factor
+		// on current
+		// term to be solved
+		//
+		// we know that U(i, i) != 0 from above
+		simd::RowOps<Type>::divide(&P(i, 0), U(i, i), rank);
 	}
 
 	//check sanity of results
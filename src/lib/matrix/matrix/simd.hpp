@@ -0,0 +1,360 @@
+/**
+ * @file simd.hpp
+ *
+ * SIMD kernels for the hot float matrix operations (SSE/AVX on x86, NEON on ARM).
+ *
+ * Each kernel is a class template with a `supported` flag. The primary templates
+ * are not supported, in which case Matrix and SquareMatrix use their generic loops.
+ * The kernels accumulate every result element in the same order as the generic
+ * loops, so results only differ by floating point contraction (FMA), if at all.
+ *
+ * Define MATRIX_NO_SIMD to disable all kernels.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#if !defined(MATRIX_NO_SIMD)
+# if defined(__SSE2__) || defined(_M_X64)
+#  define MATRIX_SIMD_SSE 1
+#  include <immintrin.h>
+#  if defined(__AVX__)
+#   define MATRIX_SIMD_AVX 1
+#  endif
+# elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  define MATRIX_SIMD_NEON 1
+#  include <arm_neon.h>
+# endif
+#endif
+
+#if defined(MATRIX_SIMD_SSE) || defined(MATRIX_SIMD_NEON)
+# define MATRIX_SIMD 1
+#endif
+
+namespace matrix
+{
+
+namespace simd
+{
+
+/**
+ * res (MxP) = a (MxN) * b (NxP), all row-major
+ */
+template<typename Type, size_t M, size_t N, size_t P>
+struct Multiply {
+	static constexpr bool supported = false;
+	static void apply(const Type *, const Type *, Type *) {}
+};
+
+/**
+ * res (MxP) = a (MxN) * b^T, b is PxN, all row-major
+ */
+template<typename Type, size_t M, size_t N, size_t P>
+struct MultiplyByTranspose {
+	static constexpr bool supported = false;
+	static void apply(const Type *, const Type *, Type *) {}
+};
+
+/**
+ * res (NxM) = a^T, a is MxN, both row-major
+ */
+template<typename Type, size_t M, size_t N>
+struct Transpose {
+	static constexpr bool supported = false;
+	static void apply(const Type *, Type *) {}
+};
+
+/**
+ * Row operations used by the LU inversion
+ */
+template<typename Type>
+struct RowOps {
+	// dst[k] -= scale * src[k] for k in [0, count)
+	static void subtractScaled(Type *dst, const Type *src, Type scale, size_t count)
+	{
+		for (size_t k = 0; k < count; k++) {
+			dst[k] -= scale * src[k];
+		}
+	}
+
+	// dst[k] /= divisor for k in [0, count)
+	static void divide(Type *dst, Type divisor, size_t count)
+	{
+		for (size_t k = 0; k < count; k++) {
+			dst[k] /= divisor;
+		}
+	}
+};
+
+#if defined(MATRIX_SIMD)
+
+namespace detail
+{
+
+#if defined(MATRIX_SIMD_SSE)
+typedef __m128 f32x4;
+
+static inline f32x4 load(const float *p) { return _mm_loadu_ps(p); }
+static inline void store(float *p, f32x4 v) { _mm_storeu_ps(p, v); }
+static inline f32x4 dup(float x) { return _mm_set1_ps(x); }
+static inline f32x4 zero() { return _mm_setzero_ps(); }
+static inline f32x4 madd(f32x4 acc, f32x4 a, f32x4 b) { return _mm_add_ps(acc, _mm_mul_ps(a, b)); }
+static inline f32x4 msub(f32x4 acc, f32x4 a, f32x4 b) { return _mm_sub_ps(acc, _mm_mul_ps(a, b)); }
+static inline f32x4 div(f32x4 a, f32x4 b) { return _mm_div_ps(a, b); }
+
+static inline f32x4 load3(const float *p) { return _mm_setr_ps(p[0], p[1], p[2], 0.f); }
+static inline void store3(float *p, f32x4 v)
+{
+	_mm_storel_pi(reinterpret_cast<__m64 *>(p), v);
+	_mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+static inline void transpose4x4(const float *a, size_t a_stride, float *res, size_t res_stride)
+{
+	f32x4 r0 = load(a);
+	f32x4 r1 = load(a + a_stride);
+	f32x4 r2 = load(a + 2 * a_stride);
+	f32x4 r3 = load(a + 3 * a_stride);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	store(res, r0);
+	store(res + res_stride, r1);
+	store(res + 2 * res_stride, r2);
+	store(res + 3 * res_stride, r3);
+}
+
+#elif defined(MATRIX_SIMD_NEON)
+typedef float32x4_t f32x4;
+
+static inline f32x4 load(const float *p) { return vld1q_f32(p); }
+static inline void store(float *p, f32x4 v) { vst1q_f32(p, v); }
+static inline f32x4 dup(float x) { return vdupq_n_f32(x); }
+static inline f32x4 zero() { return vdupq_n_f32(0.f); }
+static inline f32x4 madd(f32x4 acc, f32x4 a, f32x4 b) { return vaddq_f32(acc, vmulq_f32(a, b)); }
+static inline f32x4 msub(f32x4 acc, f32x4 a, f32x4 b) { return vsubq_f32(acc, vmulq_f32(a, b)); }
+
+static inline f32x4 div(f32x4 a, f32x4 b)
+{
+#if defined(__aarch64__)
+	return vdivq_f32(a, b);
+#else
+	// no vector division on ARMv7, keep it exact
+	float ta[4], tb[4];
+	vst1q_f32(ta, a);
+	vst1q_f32(tb, b);
+
+	for (int i = 0; i < 4; i++) {
+		ta[i] /= tb[i];
+	}
+
+	return vld1q_f32(ta);
+#endif
+}
+
+static inline f32x4 load3(const float *p)
+{
+	return vcombine_f32(vld1_f32(p), vld1_lane_f32(p + 2, vdup_n_f32(0.f), 0));
+}
+
+static inline void store3(float *p, f32x4 v)
+{
+	vst1_f32(p, vget_low_f32(v));
+	vst1q_lane_f32(p + 2, v, 2);
+}
+
+static inline void transpose4x4(const float *a, size_t a_stride, float *res, size_t res_stride)
+{
+	const float32x4x2_t t01 = vtrnq_f32(load(a), load(a + a_stride));
+	const float32x4x2_t t23 = vtrnq_f32(load(a + 2 * a_stride), load(a + 3 * a_stride));
+	store(res, vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])));
+	store(res + res_stride, vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])));
+	store(res + 2 * res_stride, vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+	store(res + 3 * res_stride, vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+}
+#endif
+
+/**
+ * One row of a matrix product: res_row[k] = sum_j a_row[j] * b(j, k).
+ * Columns are processed in blocks of 8 (two accumulators, or one with AVX),
+ * then 4, then the remainder with scalar code.
+ */
+template<size_t N, size_t P>
+static inline void multiplyRow(const float *a_row, const float *b, float *res_row)
+{
+	size_t k = 0;
+
+#if defined(MATRIX_SIMD_AVX)
+
+	for (; k + 8 <= P; k += 8) {
+		__m256 acc = _mm256_setzero_ps();
+
+		for (size_t j = 0; j < N; j++) {
+			acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(a_row[j]), _mm256_loadu_ps(&b[j * P + k])));
+		}
+
+		_mm256_storeu_ps(&res_row[k], acc);
+	}
+
+#else
+
+	for (; k + 8 <= P; k += 8) {
+		f32x4 acc0 = zero();
+		f32x4 acc1 = zero();
+
+		for (size_t j = 0; j < N; j++) {
+			const f32x4 a_j = dup(a_row[j]);
+			acc0 = madd(acc0, a_j, load(&b[j * P + k]));
+			acc1 = madd(acc1, a_j, load(&b[j * P + k + 4]));
+		}
+
+		store(&res_row[k], acc0);
+		store(&res_row[k + 4], acc1);
+	}
+
+#endif
+
+	for (; k + 4 <= P; k += 4) {
+		f32x4 acc = zero();
+
+		for (size_t j = 0; j < N; j++) {
+			acc = madd(acc, dup(a_row[j]), load(&b[j * P + k]));
+		}
+
+		store(&res_row[k], acc);
+	}
+
+	for (; k < P; k++) {
+		float acc = 0.f;
+
+		for (size_t j = 0; j < N; j++) {
+			acc += a_row[j] * b[j * P + k];
+		}
+
+		res_row[k] = acc;
+	}
+}
+
+} // namespace detail
+
+template<size_t M, size_t N, size_t P>
+struct Multiply<float, M, N, P> {
+	// vectorized along the rows of the result, which needs at least 4 columns
+	static constexpr bool supported = (P >= 4);
+
+	static void apply(const float *a, const float *b, float *res)
+	{
+		for (size_t i = 0; i < M; i++) {
+			detail::multiplyRow<N, P>(&a[i * N], b, &res[i * P]);
+		}
+	}
+};
+
+template<>
+struct Multiply<float, 3, 3, 3> {
+	static constexpr bool supported = true;
+
+	static void apply(const float *a, const float *b, float *res)
+	{
+		const detail::f32x4 b0 = detail::load3(&b[0]);
+		const detail::f32x4 b1 = detail::load3(&b[3]);
+		const detail::f32x4 b2 = detail::load3(&b[6]);
+
+		for (size_t i = 0; i < 3; i++) {
+			detail::f32x4 acc = detail::madd(detail::zero(), detail::dup(a[i * 3]), b0);
+			acc = detail::madd(acc, detail::dup(a[i * 3 + 1]), b1);
+			acc = detail::madd(acc, detail::dup(a[i * 3 + 2]), b2);
+			detail::store3(&res[i * 3], acc);
+		}
+	}
+};
+
+template<size_t M, size_t N>
+struct Transpose<float, M, N> {
+	static constexpr bool supported = (M >= 4) && (N >= 4);
+
+	static void apply(const float *a, float *res)
+	{
+		// 4x4 blocks, then the remaining columns and rows
+		constexpr size_t M4 = M - M % 4;
+		constexpr size_t N4 = N - N % 4;
+
+		for (size_t i = 0; i < M4; i += 4) {
+			for (size_t j = 0; j < N4; j += 4) {
+				detail::transpose4x4(&a[i * N + j], N, &res[j * M + i], M);
+			}
+
+			for (size_t j = N4; j < N; j++) {
+				for (size_t r = i; r < i + 4; r++) {
+					res[j * M + r] = a[r * N + j];
+				}
+			}
+		}
+
+		for (size_t i = M4; i < M; i++) {
+			for (size_t j = 0; j < N; j++) {
+				res[j * M + i] = a[i * N + j];
+			}
+		}
+	}
+};
+
+template<size_t M, size_t N, size_t P>
+struct MultiplyByTranspose<float, M, N, P> {
+	static constexpr bool supported = Multiply<float, M, N, P>::supported;
+
+	// transposing b first turns the row dot products into the row-broadcast product
+	static void apply(const float *a, const float *b, float *res)
+	{
+		float b_t[N * P];
+
+		if (Transpose<float, P, N>::supported) {
+			Transpose<float, P, N>::apply(b, b_t);
+
+		} else {
+			for (size_t k = 0; k < P; k++) {
+				for (size_t j = 0; j < N; j++) {
+					b_t[j * P + k] = b[k * N + j];
+				}
+			}
+		}
+
+		Multiply<float, M, N, P>::apply(a, b_t, res);
+	}
+};
+
+template<>
+struct RowOps<float> {
+	static void subtractScaled(float *dst, const float *src, float scale, size_t count)
+	{
+		const detail::f32x4 s = detail::dup(scale);
+		const size_t count4 = count - count % 4;
+
+		for (size_t k = 0; k < count4; k += 4) {
+			detail::store(&dst[k], detail::msub(detail::load(&dst[k]), s, detail::load(&src[k])));
+		}
+
+		for (size_t k = count4; k < count; k++) {
+			dst[k] -= scale * src[k];
+		}
+	}
+
+	static void divide(float *dst, float divisor, size_t count)
+	{
+		const detail::f32x4 d = detail::dup(divisor);
+		const size_t count4 = count - count % 4;
+
+		for (size_t k = 0; k < count4; k += 4) {
+			detail::store(&dst[k], detail::div(detail::load(&dst[k]), d));
+		}
+
+		for (size_t k = count4; k < count; k++) {
+			dst[k] /= divisor;
+		}
+	}
+};
+
+#endif // MATRIX_SIMD
+
+} // namespace simd
+
+} // namespace matrix
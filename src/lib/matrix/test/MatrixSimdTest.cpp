@@ -0,0 +1,157 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <matrix/math.hpp>
+
+#include <cstdlib>
+
+using namespace matrix;
+
+namespace
+{
+
+template<size_t M, size_t N>
+Matrix<float, M, N> randomMatrix()
+{
+	Matrix<float, M, N> A;
+
+	for (size_t i = 0; i < M; i++) {
+		for (size_t j = 0; j < N; j++) {
+			A(i, j) = 2.f * static_cast<float>(rand()) / static_cast<float>(RAND_MAX) - 1.f;
+		}
+	}
+
+	return A;
+}
+
+// reference product with the generic loops
+template<size_t M, size_t N, size_t P>
+Matrix<float, M, P> multiplyReference(const Matrix<float, M, N> &A, const Matrix<float, N, P> &B)
+{
+	Matrix<float, M, P> res{};
+
+	for (size_t i = 0; i < M; i++) {
+		for (size_t k = 0; k < P; k++) {
+			for (size_t j = 0; j < N; j++) {
+				res(i, k) += A(i, j) * B(j, k);
+			}
+		}
+	}
+
+	return res;
+}
+
+template<size_t M, size_t N, size_t P>
+void checkMultiply()
+{
+	const Matrix<float, M, N> A = randomMatrix<M, N>();
+	const Matrix<float, N, P> B = randomMatrix<N, P>();
+	const Matrix<float, M, P> ref = multiplyReference(A, B);
+
+	EXPECT_TRUE(isEqual(A * B, ref, 1e-5f)) << M << "x" << N << " * " << N << "x" << P;
+
+	// A * B^T with B^T given as PxN
+	const Matrix<float, P, N> B_T = B.transpose();
+	EXPECT_TRUE(isEqual(A.multiplyByTranspose(B_T), ref, 1e-5f)) << M << "x" << N << " * (" << P << "x" << N << ")^T";
+}
+
+template<size_t M, size_t N>
+void checkTranspose()
+{
+	const Matrix<float, M, N> A = randomMatrix<M, N>();
+	const Matrix<float, N, M> A_T = A.transpose();
+
+	for (size_t i = 0; i < M; i++) {
+		for (size_t j = 0; j < N; j++) {
+			EXPECT_EQ(A_T(j, i), A(i, j));
+		}
+	}
+}
+
+template<size_t M>
+void checkInverse()
+{
+	// diagonally dominant, well conditioned
+	SquareMatrix<float, M> A = randomMatrix<M, M>();
+
+	for (size_t i = 0; i < M; i++) {
+		A(i, i) += static_cast<float>(M);
+	}
+
+	SquareMatrix<float, M> A_I;
+	ASSERT_TRUE(inv(A, A_I));
+
+	SquareMatrix<float, M> I;
+	I.setIdentity();
+	EXPECT_TRUE(isEqual(SquareMatrix<float, M>(A * A_I), I, 1e-5f)) << M << "x" << M;
+}
+
+} // namespace
+
+TEST(MatrixSimdTest, Multiplication)
+{
+	srand(1);
+
+	checkMultiply<3, 3, 3>();
+	checkMultiply<4, 4, 4>();
+	checkMultiply<6, 6, 6>();
+	checkMultiply<24, 24, 24>();
+	checkMultiply<24, 24, 6>();
+	checkMultiply<24, 24, 5>();
+	checkMultiply<6, 24, 24>();
+	checkMultiply<5, 7, 13>();
+}
+
+TEST(MatrixSimdTest, Transpose)
+{
+	srand(2);
+
+	checkTranspose<3, 3>();
+	checkTranspose<4, 4>();
+	checkTranspose<6, 6>();
+	checkTranspose<24, 24>();
+	checkTranspose<24, 6>();
+	checkTranspose<7, 13>();
+}
+
+TEST(MatrixSimdTest, Inverse)
+{
+	srand(3);
+
+	checkInverse<4>();
+	checkInverse<6>();
+	checkInverse<9>();
+	checkInverse<24>();
+}
@@ -36,6 +36,10 @@
 #include <uORB/topics/obstacle_distance.h>
 #include <uORB/uORBManager.hpp>
 
+#include <crc32.h>
+#include <string.h>
+
+#include <chrono>
 #include <gtest/gtest.h>
 
 class ParameterTest : public ::testing::Test
@@ -46,6 +50,26 @@ public:
 		param_control_autosave(false);
 		param_reset_all();
 	}
+
+	// reference implementation of param_hash_check(), walking all params
+	static uint32_t bruteForceHash()
+	{
+		uint32_t hash = 0;
+
+		for (param_t param = 0; param < param_count(); param++) {
+			if (!param_used(param) || param_is_volatile(param)) {
+				continue;
+			}
+
+			const char *name = param_name(param);
+			int32_t value = 0;
+			param_get(param, &value);
+			hash = crc32part((const uint8_t *)name, strlen(name), hash);
+			hash = crc32part((const uint8_t *)&value, param_size(param), hash);
+		}
+
+		return hash;
+	}
 };
 
 
@@ -106,3 +130,112 @@ TEST_F(ParameterTest, testUorbSendReceive)
 	// AND: all the bytes should be equal
 	EXPECT_EQ(0, memcmp(&message, &obstacle_distance, sizeof(message)));
 }
+
+TEST_F(ParameterTest, testUsedIndex)
+{
+	// GIVEN: a few more used params, spread over the whole list
+	for (param_t param = 0; param < param_count(); param += 7) {
+		param_set_used(param);
+	}
+
+	// WHEN: we walk all params
+	unsigned used_count = 0;
+
+	for (param_t param = 0; param < param_count(); param++) {
+		// THEN: the used index should be the number of used params before
+		if (param_used(param)) {
+			EXPECT_EQ((int)used_count, param_get_used_index(param));
+			EXPECT_EQ(param, param_for_used_index(used_count));
+			used_count++;
+
+		} else {
+			EXPECT_EQ(-1, param_get_used_index(param));
+		}
+	}
+
+	// AND: the used count should match
+	EXPECT_EQ(used_count, param_count_used());
+	EXPECT_EQ(PARAM_INVALID, param_for_used_index(used_count));
+
+	// WHEN: we look up the used params many times
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < 100; i++) {
+		for (unsigned index = 0; index < used_count; index++) {
+			param_t param = param_for_used_index(index);
+			EXPECT_EQ((int)index, param_get_used_index(param));
+		}
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	printf("%u used of %u params: %.1f ns per used index lookup\n", used_count, param_count(),
+	       std::chrono::duration<double, std::nano>(end - start).count() / (100. * used_count * 2.));
+}
+
+TEST_F(ParameterTest, testHashCheck)
+{
+	// GIVEN: a used param
+	param_t param = param_find("CP_DIST");
+	ASSERT_NE(PARAM_INVALID, param);
+
+	const uint32_t hash = param_hash_check();
+	EXPECT_EQ(bruteForceHash(), hash);
+
+	// WHEN: we check it again without changes
+	// THEN: it should not change
+	EXPECT_EQ(hash, param_hash_check());
+
+	// WHEN: we set the param
+	float value = 42.f;
+	EXPECT_EQ(0, param_set(param, &value));
+
+	// THEN: the hash should change
+	const uint32_t hash_set = param_hash_check();
+	EXPECT_NE(hash, hash_set);
+	EXPECT_EQ(bruteForceHash(), hash_set);
+
+	// WHEN: we reset it
+	param_reset(param);
+
+	// THEN: it should be back to the previous hash
+	EXPECT_EQ(hash, param_hash_check());
+
+	// WHEN: another param gets used
+	param_t param_unused = PARAM_INVALID;
+
+	for (param_t p = 0; p < param_count(); p++) {
+		if (!param_used(p) && !param_is_volatile(p)) {
+			param_unused = p;
+			break;
+		}
+	}
+
+	if (param_unused != PARAM_INVALID) {
+		param_set_used(param_unused);
+
+		// THEN: it should be part of the hash
+		EXPECT_NE(hash, param_hash_check());
+		EXPECT_EQ(bruteForceHash(), param_hash_check());
+	}
+
+	// WHEN: we compare the cost of the cached and the full hash
+	const uint32_t expected_hash = param_hash_check();
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < 1000; i++) {
+		EXPECT_EQ(expected_hash, param_hash_check());
+	}
+
+	const auto middle = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < 10; i++) {
+		EXPECT_EQ(expected_hash, bruteForceHash());
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+
+	// THEN: the cached hash should be much cheaper
+	printf("param hash: %.1f ns cached, %.1f ns full computation (%u used params)\n",
+	       std::chrono::duration<double, std::nano>(middle - start).count() / 1000.,
+	       std::chrono::duration<double, std::nano>(end - middle).count() / 10., param_count_used());
+}
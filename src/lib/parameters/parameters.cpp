@@ -100,6 +100,31 @@ static ParamAutosave *autosave_instance {nullptr};
 static px4::AtomicBitset<param_info_count> params_active;  // params found
 static px4::AtomicBitset<param_info_count> params_unsaved;
 
+/**
+ * Rank index of params_active: number of used params before each block of params, the last entry is the total.
+ * It is updated when a param gets used (mostly during boot), so that mapping between used index and param
+ * does not need to walk all params.
+ */
+static constexpr int PARAMS_ACTIVE_BLOCK_SIZE = 32;
+static constexpr int params_active_blocks = (param_info_count + PARAMS_ACTIVE_BLOCK_SIZE - 1) /
+		PARAMS_ACTIVE_BLOCK_SIZE;
+static uint16_t params_active_rank[params_active_blocks + 1] {};
+static pthread_mutex_t params_active_mutex = PTHREAD_MUTEX_INITIALIZER; ///< protects params_active_rank
+
+/**
+ * param_hash_check() result, recomputed only after params_changed() was called.
+ * A CRC over the ordered list cannot be updated in place, but it only changes with the used values.
+ */
+static px4::atomic<uint32_t> params_change_count{1};
+static uint32_t param_hash_change_count{0}; ///< params_change_count at the time param_hash was computed
+static uint32_t param_hash{0};
+static pthread_mutex_t param_hash_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * invalidate the cached param hash, call after a value or the used state of a param changed
+ */
+static inline void params_changed() { params_change_count.fetch_add(1); }
+
 static ConstLayer firmware_defaults;
 static DynamicSparseLayer runtime_defaults{&firmware_defaults};
 DynamicSparseLayer user_config{&runtime_defaults};
@@ -164,7 +189,7 @@ param_notify_changes()
 	pup.set_count = perf_event_count(param_set_perf);
 	pup.find_count = perf_event_count(param_find_perf);
 	pup.export_count = perf_event_count(param_export_perf);
-	pup.active = params_active.count();
+	pup.active = param_count_used();
 	pup.changed = user_config.size();
 	pup.custom_default = runtime_defaults.size();
 	pup.timestamp = hrt_absolute_time();
@@ -228,21 +253,43 @@ param_t param_find_no_notification(const char *name)
 
 unsigned param_count_used()
 {
-	return params_active.count();
+	pthread_mutex_lock(&params_active_mutex);
+	const unsigned count = params_active_rank[params_active_blocks];
+	pthread_mutex_unlock(&params_active_mutex);
+	return count;
 }
 
 param_t param_for_used_index(unsigned index)
 {
-	// walk all params and count used params
-	if (index < param_info_count) {
-		unsigned used_count = 0;
+	param_t param = PARAM_INVALID;
+
+	pthread_mutex_lock(&params_active_mutex);
+
+	if (index < params_active_rank[params_active_blocks]) {
+		// binary search for the last block that starts at or before the used index
+		int front = 0;
+		int last = params_active_blocks;
 
-		for (int i = 0; i < params_active.size(); i++) {
+		while (last - front > 1) {
+			const int middle = front + (last - front) / 2;
+
+			if (params_active_rank[middle] <= index) {
+				front = middle;
+
+			} else {
+				last = middle;
+			}
+		}
+
+		// then count the used params within the block
+		unsigned used_count = params_active_rank[front];
+
+		for (int i = front * PARAMS_ACTIVE_BLOCK_SIZE; i < (front + 1) * PARAMS_ACTIVE_BLOCK_SIZE
+		     && handle_in_range(i); i++) {
 			if (params_active[i]) {
-				// we found the right used count,
-				//  return the param value
 				if (index == used_count) {
-					return static_cast<param_t>(i);
+					param = static_cast<param_t>(i);
+					break;
 				}
 
 				used_count++;
@@ -250,7 +297,9 @@ param_t param_for_used_index(unsigned index)
 		}
 	}
 
-	return PARAM_INVALID;
+	pthread_mutex_unlock(&params_active_mutex);
+
+	return param;
 }
 
 int param_get_used_index(param_t param)
@@ -260,21 +309,22 @@ int param_get_used_index(param_t param)
 		return -1;
 	}
 
-	/* walk all params and count, now knowing that it has a valid index */
-	int used_count = 0;
+	/* count the used params before it within its block */
+	const int block = param / PARAMS_ACTIVE_BLOCK_SIZE;
 
-	for (int i = 0; i < params_active.size(); i++) {
-		if (params_active[i]) {
+	pthread_mutex_lock(&params_active_mutex);
 
-			if (param == i) {
-				return used_count;
-			}
+	int used_count = params_active_rank[block];
 
+	for (int i = block * PARAMS_ACTIVE_BLOCK_SIZE; i < param; i++) {
+		if (params_active[i]) {
 			used_count++;
 		}
 	}
 
-	return -1;
+	pthread_mutex_unlock(&params_active_mutex);
+
+	return used_count;
 }
 
 bool
@@ -435,6 +485,7 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 
 	if (user_config.store(param, new_value)) {
 		params_unsaved.set(param, !mark_saved);
+		params_changed();
 		result = PX4_OK;
 
 	} else {
@@ -524,7 +575,22 @@ void param_set_used(param_t param)
 
 #endif
 
-		params_active.set(param, true);
+		if (!params_active[param]) {
+			pthread_mutex_lock(&params_active_mutex);
+
+			// check again, another thread might have set it in the meantime
+			if (!params_active[param]) {
+				params_active.set(param, true);
+
+				for (int block = param / PARAMS_ACTIVE_BLOCK_SIZE + 1; block <= params_active_blocks; block++) {
+					params_active_rank[block]++;
+				}
+
+				params_changed();
+			}
+
+			pthread_mutex_unlock(&params_active_mutex);
+		}
 	}
 }
 
@@ -559,6 +625,7 @@ int param_set_default_value(param_t param, const void *val)
 
 	if (setting_to_static_default) {
 		runtime_defaults.reset(param);
+		params_changed();
 
 		result = PX4_OK;
 
@@ -582,6 +649,7 @@ int param_set_default_value(param_t param, const void *val)
 
 		if (runtime_defaults.store(param, new_value)) {
 			user_config.refresh(param);
+			params_changed();
 			result = PX4_OK;
 
 		} else {
@@ -609,6 +677,7 @@ static int param_reset_internal(param_t param, bool notify = true, bool autosave
 
 	if (handle_in_range(param)) {
 		user_config.reset(param);
+		params_changed();
 	}
 
 	if (autosave) {
@@ -1298,22 +1367,36 @@ param_foreach(void (*func)(void *arg, param_t param), void *arg, bool only_chang
 
 uint32_t param_hash_check()
 {
-	uint32_t param_hash = 0;
+	pthread_mutex_lock(&param_hash_mutex);
 
-	/* compute the CRC32 over all string param names and 4 byte values */
-	for (param_t param = 0; handle_in_range(param); param++) {
-		if (!param_used(param) || param_is_volatile(param)) {
-			continue;
+	// any change after this point increments the count again and invalidates the result
+	const uint32_t change_count = params_change_count.load();
+
+	if (change_count != param_hash_change_count) {
+		uint32_t hash = 0;
+
+		/* compute the CRC32 over all string param names and 4 byte values */
+		for (param_t param = 0; handle_in_range(param); param++) {
+			if (!param_used(param) || param_is_volatile(param)) {
+				continue;
+			}
+
+			const char *name = param_name(param);
+			auto value = user_config.get(param).i;
+			const void *val = (void *)&value;
+			hash = crc32part((const uint8_t *)name, strlen(name), hash);
+			hash = crc32part((const uint8_t *)val, param_size(param), hash);
 		}
 
-		const char *name = param_name(param);
-		auto value = user_config.get(param).i;
-		const void *val = (void *)&value;
-		param_hash = crc32part((const uint8_t *)name, strlen(name), param_hash);
-		param_hash = crc32part((const uint8_t *)val, param_size(param), param_hash);
+		param_hash = hash;
+		param_hash_change_count = change_count;
 	}
 
-	return param_hash;
+	const uint32_t hash = param_hash;
+
+	pthread_mutex_unlock(&param_hash_mutex);
+
+	return hash;
 }
 
 void param_print_status()
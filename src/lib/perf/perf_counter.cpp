@@ -91,6 +91,27 @@ struct perf_ctr_interval : public perf_ctr_header {
 	float			M2{0.0f};
 };
 
+/**
+ * PC_HISTOGRAM counter.
+ *
+ * Elapsed times are sorted into fixed log-scaled buckets: the values 0-3us have their own bucket, above that
+ * each octave is split into 4 buckets, up to PERF_HISTOGRAM_MAX_US. The bucket counts and the max are updated
+ * with relaxed atomics, so concurrent updates are not lost and printing reads untorn values. The event count
+ * is the sum of a snapshot of the buckets, so the printed percentiles are always consistent with it.
+ */
+static constexpr int PERF_HISTOGRAM_SUB_BUCKETS_LOG2 = 2;
+static constexpr int PERF_HISTOGRAM_SUB_BUCKETS = 1 << PERF_HISTOGRAM_SUB_BUCKETS_LOG2;
+static constexpr int PERF_HISTOGRAM_MAX_LOG2 = 20;
+static constexpr uint32_t PERF_HISTOGRAM_MAX_US = 1u << PERF_HISTOGRAM_MAX_LOG2; ///< larger values go to the last bucket
+static constexpr int PERF_HISTOGRAM_BUCKETS = PERF_HISTOGRAM_SUB_BUCKETS
+		+ (PERF_HISTOGRAM_MAX_LOG2 - PERF_HISTOGRAM_SUB_BUCKETS_LOG2) * PERF_HISTOGRAM_SUB_BUCKETS + 1;
+
+struct perf_ctr_histogram : public perf_ctr_header {
+	uint64_t		time_start{0};
+	uint32_t		time_most{0};
+	uint32_t		buckets[PERF_HISTOGRAM_BUCKETS] {};
+};
+
 /**
  * List of all known counters.
  */
@@ -106,6 +127,7 @@ pthread_mutex_t perf_counters_mutex = PTHREAD_MUTEX_INITIALIZER;
 // (especially the 64bit values which are in general not atomically updated).
 // The same holds for shared perf counters (perf_alloc_once), that can be updated
 // concurrently (this affects the 'ctrl_latency' counter).
+// PC_HISTOGRAM counters are not affected, their printed data is only updated atomically.
 
 
 perf_counter_t
@@ -126,6 +148,10 @@ perf_alloc(enum perf_counter_type type, const char *name)
 		ctr = new perf_ctr_interval();
 		break;
 
+	case PC_HISTOGRAM:
+		ctr = new perf_ctr_histogram();
+		break;
+
 	default:
 		break;
 	}
@@ -194,11 +220,101 @@ perf_free(perf_counter_t handle)
 		delete (struct perf_ctr_interval *)handle;
 		break;
 
+	case PC_HISTOGRAM:
+		delete (struct perf_ctr_histogram *)handle;
+		break;
+
 	default:
 		break;
 	}
 }
 
+static int
+perf_histogram_bucket(uint32_t elapsed)
+{
+	if (elapsed >= PERF_HISTOGRAM_MAX_US) {
+		return PERF_HISTOGRAM_BUCKETS - 1;
+	}
+
+	if (elapsed < PERF_HISTOGRAM_SUB_BUCKETS) {
+		return elapsed;
+	}
+
+	const int octave = 31 - __builtin_clz(elapsed);
+	const int sub_bucket = (elapsed >> (octave - PERF_HISTOGRAM_SUB_BUCKETS_LOG2)) & (PERF_HISTOGRAM_SUB_BUCKETS - 1);
+	return PERF_HISTOGRAM_SUB_BUCKETS + (octave - PERF_HISTOGRAM_SUB_BUCKETS_LOG2) * PERF_HISTOGRAM_SUB_BUCKETS + sub_bucket;
+}
+
+/** lower bound of a bucket in us */
+static uint32_t
+perf_histogram_bucket_min(int bucket)
+{
+	if (bucket < PERF_HISTOGRAM_SUB_BUCKETS) {
+		return bucket;
+	}
+
+	const int octave = (bucket - PERF_HISTOGRAM_SUB_BUCKETS) / PERF_HISTOGRAM_SUB_BUCKETS + PERF_HISTOGRAM_SUB_BUCKETS_LOG2;
+	const uint32_t sub_bucket = (bucket - PERF_HISTOGRAM_SUB_BUCKETS) % PERF_HISTOGRAM_SUB_BUCKETS;
+	return (PERF_HISTOGRAM_SUB_BUCKETS + sub_bucket) << (octave - PERF_HISTOGRAM_SUB_BUCKETS_LOG2);
+}
+
+/**
+ * Consistent copy of a histogram counter for printing
+ */
+struct perf_histogram_snapshot {
+	uint32_t buckets[PERF_HISTOGRAM_BUCKETS];
+	uint32_t event_count;
+	uint32_t time_most;
+
+	explicit perf_histogram_snapshot(const perf_ctr_histogram *pch)
+	{
+		event_count = 0;
+
+		for (int i = 0; i < PERF_HISTOGRAM_BUCKETS; i++) {
+			buckets[i] = __atomic_load_n(&pch->buckets[i], __ATOMIC_RELAXED);
+			event_count += buckets[i];
+		}
+
+		time_most = __atomic_load_n(&pch->time_most, __ATOMIC_RELAXED);
+	}
+
+	/** upper bound in us of the bucket containing the given percentile, limited by the max */
+	uint32_t percentile(float p) const
+	{
+		const uint32_t rank = (uint32_t)ceilf(p * event_count);
+		uint32_t count = 0;
+
+		for (int i = 0; i < PERF_HISTOGRAM_BUCKETS - 1; i++) {
+			count += buckets[i];
+
+			if (count >= rank && count > 0) {
+				const uint32_t upper = perf_histogram_bucket_min(i + 1) - 1;
+				return upper < time_most ? upper : time_most;
+			}
+		}
+
+		return time_most;
+	}
+
+	/** mean in seconds, using the bucket centers */
+	float mean() const
+	{
+		if (event_count == 0) {
+			return 0.f;
+		}
+
+		double sum = 0.;
+
+		for (int i = 0; i < PERF_HISTOGRAM_BUCKETS - 1; i++) {
+			sum += (double)buckets[i] * 0.5 * (perf_histogram_bucket_min(i) + perf_histogram_bucket_min(i + 1) - 1);
+		}
+
+		sum += (double)buckets[PERF_HISTOGRAM_BUCKETS - 1] * time_most;
+
+		return (float)(sum / event_count / 1e6);
+	}
+};
+
 void
 perf_count(perf_counter_t handle)
 {
@@ -232,6 +348,10 @@ perf_begin(perf_counter_t handle)
 		((struct perf_ctr_elapsed *)handle)->time_start = hrt_absolute_time();
 		break;
 
+	case PC_HISTOGRAM:
+		((struct perf_ctr_histogram *)handle)->time_start = hrt_absolute_time();
+		break;
+
 	default:
 		break;
 	}
@@ -254,6 +374,15 @@ perf_end(perf_counter_t handle)
 		}
 		break;
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+			if (pch->time_start != 0) {
+				perf_set_elapsed(handle, hrt_elapsed_time(&pch->time_start));
+			}
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -294,6 +423,24 @@ perf_set_elapsed(perf_counter_t handle, int64_t elapsed)
 		}
 		break;
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+			if (elapsed >= 0) {
+				const uint32_t elapsed_us = elapsed < UINT32_MAX ? (uint32_t)elapsed : UINT32_MAX;
+				__atomic_fetch_add(&pch->buckets[perf_histogram_bucket(elapsed_us)], 1, __ATOMIC_RELAXED);
+
+				uint32_t most = __atomic_load_n(&pch->time_most, __ATOMIC_RELAXED);
+
+				while (elapsed_us > most
+				       && !__atomic_compare_exchange_n(&pch->time_most, &most, elapsed_us, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				}
+
+				pch->time_start = 0;
+			}
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -387,6 +534,13 @@ perf_cancel(perf_counter_t handle)
 		}
 		break;
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+			pch->time_start = 0;
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -424,6 +578,18 @@ perf_reset(perf_counter_t handle)
 			pci->time_most = 0;
 			break;
 		}
+
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			pch->time_start = 0;
+
+			for (int i = 0; i < PERF_HISTOGRAM_BUCKETS; i++) {
+				__atomic_store_n(&pch->buckets[i], 0, __ATOMIC_RELAXED);
+			}
+
+			__atomic_store_n(&pch->time_most, 0, __ATOMIC_RELAXED);
+			break;
+		}
 	}
 }
 
@@ -470,6 +636,20 @@ perf_print_counter(perf_counter_t handle)
 			break;
 		}
 
+	case PC_HISTOGRAM: {
+			const perf_histogram_snapshot snapshot((struct perf_ctr_histogram *)handle);
+			PX4_INFO_RAW("%s: %" PRIu32 " events, p50 %" PRIu32 "us p90 %" PRIu32 "us p99 %" PRIu32 "us p99.9 %" PRIu32
+				     "us max %" PRIu32 "us\n",
+				     handle->name,
+				     snapshot.event_count,
+				     snapshot.percentile(0.5f),
+				     snapshot.percentile(0.9f),
+				     snapshot.percentile(0.99f),
+				     snapshot.percentile(0.999f),
+				     snapshot.time_most);
+			break;
+		}
+
 	default:
 		break;
 	}
@@ -522,6 +702,20 @@ perf_print_counter_buffer(char *buffer, int length, perf_counter_t handle)
 			break;
 		}
 
+	case PC_HISTOGRAM: {
+			const perf_histogram_snapshot snapshot((struct perf_ctr_histogram *)handle);
+			num_written = snprintf(buffer, length,
+					       "%s: %" PRIu32 " events, p50 %" PRIu32 "us p90 %" PRIu32 "us p99 %" PRIu32 "us p99.9 %" PRIu32 "us max %" PRIu32 "us",
+					       handle->name,
+					       snapshot.event_count,
+					       snapshot.percentile(0.5f),
+					       snapshot.percentile(0.9f),
+					       snapshot.percentile(0.99f),
+					       snapshot.percentile(0.999f),
+					       snapshot.time_most);
+			break;
+		}
+
 	default:
 		break;
 	}
@@ -530,6 +724,51 @@ perf_print_counter_buffer(char *buffer, int length, perf_counter_t handle)
 	return num_written;
 }
 
+void
+perf_print_histogram(perf_counter_t handle)
+{
+	if (handle == nullptr || handle->type != PC_HISTOGRAM) {
+		return;
+	}
+
+	const perf_histogram_snapshot snapshot((struct perf_ctr_histogram *)handle);
+
+	PX4_INFO_RAW("%s: %" PRIu32 " events\n", handle->name, snapshot.event_count);
+	PX4_INFO_RAW("bucket [us] : events\n");
+
+	for (int i = 0; i < PERF_HISTOGRAM_BUCKETS - 1; i++) {
+		if (snapshot.buckets[i] > 0) {
+			PX4_INFO_RAW("   %8" PRIu32 " : %" PRIu32 "\n", perf_histogram_bucket_min(i), snapshot.buckets[i]);
+		}
+	}
+
+	if (snapshot.buckets[PERF_HISTOGRAM_BUCKETS - 1] > 0) {
+		PX4_INFO_RAW(" >=%8" PRIu32 " : %" PRIu32 "\n", PERF_HISTOGRAM_MAX_US, snapshot.buckets[PERF_HISTOGRAM_BUCKETS - 1]);
+	}
+}
+
+int
+perf_print_histogram_buffer(char *buffer, int length, perf_counter_t handle)
+{
+	if (handle == nullptr || handle->type != PC_HISTOGRAM || length <= 0) {
+		return 0;
+	}
+
+	const perf_histogram_snapshot snapshot((struct perf_ctr_histogram *)handle);
+
+	int num_written = snprintf(buffer, length, "%s:", handle->name);
+
+	for (int i = 0; i < PERF_HISTOGRAM_BUCKETS && num_written < length; i++) {
+		if (snapshot.buckets[i] > 0) {
+			num_written += snprintf(buffer + num_written, length - num_written, " %" PRIu32 ":%" PRIu32,
+						perf_histogram_bucket_min(i), snapshot.buckets[i]);
+		}
+	}
+
+	buffer[length - 1] = 0; // ensure 0-termination
+	return num_written < length ? num_written : length - 1;
+}
+
 uint64_t
 perf_event_count(perf_counter_t handle)
 {
@@ -551,6 +790,11 @@ perf_event_count(perf_counter_t handle)
 			return pci->event_count;
 		}
 
+	case PC_HISTOGRAM: {
+			const perf_histogram_snapshot snapshot((struct perf_ctr_histogram *)handle);
+			return snapshot.event_count;
+		}
+
 	default:
 		break;
 	}
@@ -576,6 +820,11 @@ perf_mean(perf_counter_t handle)
 			return pci->mean;
 		}
 
+	case PC_HISTOGRAM: {
+			const perf_histogram_snapshot snapshot((struct perf_ctr_histogram *)handle);
+			return snapshot.mean();
+		}
+
 	default:
 		break;
 	}
@@ -48,7 +48,8 @@
 enum perf_counter_type {
 	PC_COUNT,		/**< count the number of times an event occurs */
 	PC_ELAPSED,		/**< measure the time elapsed performing an event */
-	PC_INTERVAL		/**< measure the interval between instances of an event */
+	PC_INTERVAL,		/**< measure the interval between instances of an event */
+	PC_HISTOGRAM		/**< measure the time elapsed performing an event, with log-scaled buckets for percentiles */
 };
 
 struct perf_ctr_header;
@@ -184,6 +185,24 @@ __EXPORT extern void		perf_print_counter(perf_counter_t handle);
  */
 __EXPORT extern int		perf_print_counter_buffer(char *buffer, int length, perf_counter_t handle);
 
+/**
+ * Print the histogram buckets of a PC_HISTOGRAM counter to stdout
+ *
+ * @param handle		The counter to print.
+ */
+__EXPORT extern void		perf_print_histogram(perf_counter_t handle);
+
+/**
+ * Print the non-empty histogram buckets of a PC_HISTOGRAM counter to a buffer,
+ * as '<name>: <bucket lower bound [us]>:<events> ...'.
+ *
+ * @param buffer			buffer to write to
+ * @param length			buffer length
+ * @param handle			The counter to print.
+ * @param return			number of bytes written (0 if the counter is not a PC_HISTOGRAM)
+ */
+__EXPORT extern int		perf_print_histogram_buffer(char *buffer, int length, perf_counter_t handle);
+
 /**
  * Print all of the performance counters.
  */
@@ -0,0 +1,316 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Padding used to keep the producer and consumer state on separate cache lines.
+#if defined(__PX4_POSIX)
+#define SPSC_RINGBUFFER_CACHE_LINE_SIZE 64
+#else
+#define SPSC_RINGBUFFER_CACHE_LINE_SIZE 32
+#endif
+
+
+// Lock-free FIFO ringbuffer for exactly one producer and one consumer thread.
+//
+// The producer only writes the head index and the consumer only writes the
+// tail index, published with release/acquire ordering. Both indices are free
+// running, so all slots can be used and the capacity is rounded up to a power
+// of two. Each side keeps a cached copy of the other side's index and only
+// reloads it when the cached value is not sufficient, to avoid bouncing cache
+// lines between the two cores.
+//
+// The producer calls push_back(), reserve()/commit() and space_available().
+// The consumer calls pop_front(), peek()/consume() and space_used().
+// allocate() and deallocate() must not run concurrently with anything else.
+//
+// T is copied with memcpy and needs to be trivially copyable.
+
+template<typename T>
+class SpscRingbuffer
+{
+public:
+	/* @brief Constructor
+	 *
+	 * @note Does not allocate automatically.
+	 */
+	SpscRingbuffer() = default;
+
+	/*
+	 * @brief Destructor
+	 *
+	 * Automatically calls deallocate.
+	 */
+	~SpscRingbuffer() { deallocate(); }
+
+	SpscRingbuffer(const SpscRingbuffer &) = delete;
+	SpscRingbuffer &operator=(const SpscRingbuffer &) = delete;
+
+	/* @brief Allocate ringbuffer
+	 *
+	 * @param capacity Number of items, rounded up to the next power of two.
+	 *
+	 * @returns false if allocation fails.
+	 */
+	bool allocate(size_t capacity)
+	{
+		deallocate();
+
+		if (capacity == 0 || capacity > (SIZE_MAX / 2) / sizeof(T)) {
+			return false;
+		}
+
+		size_t size = 1;
+
+		while (size < capacity) {
+			size <<= 1;
+		}
+
+		_buffer = new T[size];
+
+		if (_buffer == nullptr) {
+			return false;
+		}
+
+		_mask = size - 1;
+		return true;
+	}
+
+	/*
+	 * @brief Deallocate ringbuffer
+	 *
+	 * @note only required to deallocate and reallocate again.
+	 */
+	void deallocate()
+	{
+		delete[] _buffer;
+		_buffer = nullptr;
+		_mask = 0;
+		_head = 0;
+		_tail_cached = 0;
+		_tail = 0;
+		_head_cached = 0;
+	}
+
+	/*
+	 * @brief Number of items the buffer can hold
+	 */
+	size_t capacity() const { return (_buffer != nullptr) ? _mask + 1 : 0; }
+
+	/*
+	 * @brief Space available to push (producer)
+	 */
+	size_t space_available()
+	{
+		_tail_cached = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+		return capacity() - (_head - _tail_cached);
+	}
+
+	/*
+	 * @brief Slots from the next free slot to the end of the buffer, whether free or not (producer)
+	 */
+	size_t space_to_end() const { return capacity() - (_head & _mask); }
+
+	/*
+	 * @brief Items available to pop (consumer)
+	 */
+	size_t space_used()
+	{
+		_head_cached = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+		return _head_cached - _tail;
+	}
+
+	/*
+	 * @brief Copy items into ringbuffer (producer)
+	 *
+	 * @param items Pointer to the items to copy from.
+	 * @param count Number of items.
+	 *
+	 * @returns true if all items could be copied, nothing is copied otherwise.
+	 */
+	bool push_back(const T *items, size_t count)
+	{
+		if (count == 0 || items == nullptr || free_slots(count) < count) {
+			return false;
+		}
+
+		const size_t index = _head & _mask;
+		const size_t first = min(count, capacity() - index);
+
+		memcpy(&_buffer[index], items, first * sizeof(T));
+		memcpy(&_buffer[0], items + first, (count - first) * sizeof(T));
+
+		__atomic_store_n(&_head, _head + count, __ATOMIC_RELEASE);
+		return true;
+	}
+
+	bool push_back(const T &item) { return push_back(&item, 1); }
+
+	/*
+	 * @brief Get contiguous space to write into in place (producer)
+	 *
+	 * The items only become visible to the consumer with commit().
+	 *
+	 * @param items Set to the first free slot.
+	 *
+	 * @returns number of contiguous free slots, 0 if full.
+	 */
+	size_t reserve(T **items)
+	{
+		const size_t index = _head & _mask;
+		const size_t contiguous = capacity() - index;
+		*items = &_buffer[index];
+		return min(free_slots(contiguous), contiguous);
+	}
+
+	/*
+	 * @brief Publish items written after reserve() (producer)
+	 *
+	 * @param count Number of items, at most the value returned by reserve().
+	 */
+	void commit(size_t count)
+	{
+		__atomic_store_n(&_head, _head + count, __ATOMIC_RELEASE);
+	}
+
+	/*
+	 * @brief Copy items out of the ringbuffer (consumer)
+	 *
+	 * @param items Pointer to where the items can be copied into.
+	 * @param max_count Maximum number of items to copy.
+	 *
+	 * @returns number of items copied, 0 if the buffer is empty.
+	 */
+	size_t pop_front(T *items, size_t max_count)
+	{
+		if (items == nullptr) {
+			return 0;
+		}
+
+		const size_t count = min(used_slots(max_count), max_count);
+
+		if (count == 0) {
+			return 0;
+		}
+
+		const size_t index = _tail & _mask;
+		const size_t first = min(count, capacity() - index);
+
+		memcpy(items, &_buffer[index], first * sizeof(T));
+		memcpy(items + first, &_buffer[0], (count - first) * sizeof(T));
+
+		__atomic_store_n(&_tail, _tail + count, __ATOMIC_RELEASE);
+		return count;
+	}
+
+	bool pop_front(T &item) { return pop_front(&item, 1) == 1; }
+
+	/*
+	 * @brief Access the next items in place (consumer)
+	 *
+	 * The items stay in the buffer until consume() is called.
+	 *
+	 * @param items Set to the oldest item.
+	 *
+	 * @returns number of contiguous items, 0 if empty.
+	 */
+	size_t peek(const T **items)
+	{
+		const size_t index = _tail & _mask;
+		const size_t contiguous = capacity() - index;
+		*items = &_buffer[index];
+		return min(used_slots(contiguous), contiguous);
+	}
+
+	/*
+	 * @brief Remove items after peek() (consumer)
+	 *
+	 * @param count Number of items, at most the value returned by peek().
+	 */
+	void consume(size_t count)
+	{
+		__atomic_store_n(&_tail, _tail + count, __ATOMIC_RELEASE);
+	}
+
+private:
+	static size_t min(size_t a, size_t b) { return (a < b) ? a : b; }
+
+	// free slots, the tail is only reloaded if the cached value shows less than needed
+	size_t free_slots(size_t needed)
+	{
+		size_t free = capacity() - (_head - _tail_cached);
+
+		if (free < needed) {
+			_tail_cached = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+			free = capacity() - (_head - _tail_cached);
+		}
+
+		return free;
+	}
+
+	// used slots, the head is only reloaded if the cached value shows less than needed
+	size_t used_slots(size_t needed)
+	{
+		size_t used = _head_cached - _tail;
+
+		if (used < needed) {
+			_head_cached = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+			used = _head_cached - _tail;
+		}
+
+		return used;
+	}
+
+	// shared, only written by allocate() and deallocate()
+	T *_buffer{nullptr};
+	size_t _mask{0};
+
+	uint8_t _pad0[SPSC_RINGBUFFER_CACHE_LINE_SIZE];
+
+	// producer
+	size_t _head{0};
+	size_t _tail_cached{0};
+
+	uint8_t _pad1[SPSC_RINGBUFFER_CACHE_LINE_SIZE];
+
+	// consumer
+	size_t _tail{0};
+	size_t _head_cached{0};
+
+	uint8_t _pad2[SPSC_RINGBUFFER_CACHE_LINE_SIZE];
+};
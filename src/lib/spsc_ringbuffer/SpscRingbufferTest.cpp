@@ -0,0 +1,519 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Run this test only using make tests TESTFILTER=SpscRingbuffer
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "SpscRingbuffer.hpp"
+#include "SpscVariableLengthRingbuffer.hpp"
+
+
+TEST(SpscRingbuffer, AllocateRoundsUpToPowerOfTwo)
+{
+	SpscRingbuffer<uint16_t> buf;
+	EXPECT_FALSE(buf.allocate(0));
+	EXPECT_EQ(buf.capacity(), 0);
+
+	ASSERT_TRUE(buf.allocate(100));
+	EXPECT_EQ(buf.capacity(), 128);
+	EXPECT_EQ(buf.space_available(), 128);
+	EXPECT_EQ(buf.space_used(), 0);
+
+	ASSERT_TRUE(buf.allocate(64));
+	EXPECT_EQ(buf.capacity(), 64);
+	// The second time we forget to clean up, but we expect no leak.
+}
+
+TEST(SpscRingbuffer, PushIsAllOrNothing)
+{
+	SpscRingbuffer<uint32_t> buf;
+	ASSERT_TRUE(buf.allocate(16));
+
+	uint32_t data[17];
+
+	for (uint32_t i = 0; i < 17; ++i) {
+		data[i] = i;
+	}
+
+	EXPECT_FALSE(buf.push_back(data, 17));
+	EXPECT_EQ(buf.space_used(), 0);
+
+	// all slots can be used
+	EXPECT_TRUE(buf.push_back(data, 16));
+	EXPECT_EQ(buf.space_available(), 0);
+	EXPECT_FALSE(buf.push_back(data[16]));
+
+	uint32_t out[17] {};
+	EXPECT_EQ(buf.pop_front(out, 17), 16);
+	EXPECT_EQ(memcmp(data, out, 16 * sizeof(uint32_t)), 0);
+	EXPECT_EQ(buf.pop_front(out, 17), 0);
+}
+
+TEST(SpscRingbuffer, PushAndPopWrapAround)
+{
+	SpscRingbuffer<uint8_t> buf;
+	ASSERT_TRUE(buf.allocate(32));
+
+	uint8_t in[20];
+	uint8_t out[20];
+	uint8_t value = 0;
+	uint8_t expected = 0;
+
+	for (int round = 0; round < 50; ++round) {
+		const size_t count = 1 + (round * 7) % 20;
+
+		for (size_t i = 0; i < count; ++i) {
+			in[i] = value++;
+		}
+
+		ASSERT_TRUE(buf.push_back(in, count));
+		EXPECT_EQ(buf.space_used(), count);
+
+		// pop in two batches
+		const size_t first = count / 2;
+		EXPECT_EQ(buf.pop_front(out, first), first);
+		EXPECT_EQ(buf.pop_front(out + first, sizeof(out) - first), count - first);
+
+		for (size_t i = 0; i < count; ++i) {
+			EXPECT_EQ(out[i], expected++);
+		}
+	}
+}
+
+TEST(SpscRingbuffer, ReserveCommitPeekConsume)
+{
+	SpscRingbuffer<int> buf;
+	ASSERT_TRUE(buf.allocate(8));
+
+	// move the indices to the middle of the buffer
+	int tmp[6] {};
+	ASSERT_TRUE(buf.push_back(tmp, 6));
+	ASSERT_EQ(buf.pop_front(tmp, 6), 6);
+
+	// contiguous space ends at the end of the buffer
+	int *dst = nullptr;
+	ASSERT_EQ(buf.reserve(&dst), 2);
+	dst[0] = 10;
+	dst[1] = 11;
+
+	// nothing visible before commit
+	const int *src = nullptr;
+	EXPECT_EQ(buf.peek(&src), 0);
+
+	buf.commit(2);
+	ASSERT_EQ(buf.reserve(&dst), 6);
+	dst[0] = 12;
+	buf.commit(1);
+
+	ASSERT_EQ(buf.peek(&src), 2);
+	EXPECT_EQ(src[0], 10);
+	EXPECT_EQ(src[1], 11);
+	buf.consume(2);
+
+	ASSERT_EQ(buf.peek(&src), 1);
+	EXPECT_EQ(src[0], 12);
+	buf.consume(1);
+
+	EXPECT_EQ(buf.peek(&src), 0);
+	EXPECT_EQ(buf.space_available(), 8);
+}
+
+TEST(SpscRingbuffer, ConcurrentBatches)
+{
+	static constexpr uint32_t num_items = 2000000;
+
+	SpscRingbuffer<uint32_t> buf;
+	ASSERT_TRUE(buf.allocate(256));
+
+	std::thread producer([&buf]() {
+		uint32_t batch[37];
+		uint32_t next = 0;
+		size_t batch_size = 1;
+
+		while (next < num_items) {
+			const size_t count = (batch_size < num_items - next) ? batch_size : num_items - next;
+
+			for (size_t i = 0; i < count; ++i) {
+				batch[i] = next + i;
+			}
+
+			if (buf.push_back(batch, count)) {
+				next += count;
+				batch_size = batch_size % 37 + 1;
+
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	uint32_t out[23];
+	uint32_t expected = 0;
+	bool in_order = true;
+
+	while (expected < num_items && in_order) {
+		const size_t count = buf.pop_front(out, sizeof(out) / sizeof(out[0]));
+
+		for (size_t i = 0; i < count; ++i) {
+			in_order = in_order && (out[i] == expected++);
+		}
+
+		if (count == 0) {
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+
+	EXPECT_TRUE(in_order);
+	EXPECT_EQ(expected, num_items);
+	EXPECT_EQ(buf.space_used(), 0);
+}
+
+TEST(SpscRingbuffer, ConcurrentZeroCopy)
+{
+	static constexpr uint32_t num_items = 2000000;
+
+	SpscRingbuffer<uint32_t> buf;
+	ASSERT_TRUE(buf.allocate(100));
+
+	std::thread producer([&buf]() {
+		uint32_t next = 0;
+
+		while (next < num_items) {
+			uint32_t *dst = nullptr;
+			size_t count = buf.reserve(&dst);
+
+			if (count > num_items - next) {
+				count = num_items - next;
+			}
+
+			for (size_t i = 0; i < count; ++i) {
+				dst[i] = next++;
+			}
+
+			if (count > 0) {
+				buf.commit(count);
+
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	uint32_t expected = 0;
+	bool in_order = true;
+
+	while (expected < num_items && in_order) {
+		const uint32_t *src = nullptr;
+		const size_t count = buf.peek(&src);
+
+		for (size_t i = 0; i < count; ++i) {
+			in_order = in_order && (src[i] == expected++);
+		}
+
+		if (count > 0) {
+			buf.consume(count);
+
+		} else {
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+
+	EXPECT_TRUE(in_order);
+	EXPECT_EQ(expected, num_items);
+}
+
+TEST(SpscRingbuffer, Throughput)
+{
+	// bytes from a serial driver to a parser, in reads of up to 64 bytes
+	static constexpr size_t num_bytes = 16 * 1024 * 1024;
+
+	SpscRingbuffer<uint8_t> buf;
+	ASSERT_TRUE(buf.allocate(4096));
+
+	const auto start = std::chrono::steady_clock::now();
+
+	std::thread producer([&buf]() {
+		uint8_t chunk[64];
+		memset(chunk, 0x55, sizeof(chunk));
+		size_t sent = 0;
+
+		while (sent < num_bytes) {
+			if (buf.push_back(chunk, sizeof(chunk))) {
+				sent += sizeof(chunk);
+
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	uint8_t out[256];
+	size_t received = 0;
+	uint32_t sum = 0;
+
+	while (received < num_bytes) {
+		const size_t count = buf.pop_front(out, sizeof(out));
+		received += count;
+
+		for (size_t i = 0; i < count; ++i) {
+			sum += out[i];
+		}
+
+		if (count == 0) {
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	printf("SpscRingbuffer: %.1f MB/s\n", num_bytes / elapsed.count() / 1e6);
+
+	EXPECT_EQ(received, num_bytes);
+	EXPECT_EQ(sum, num_bytes * 0x55u % (1ull << 32));
+}
+
+TEST(SpscVariableLengthRingbuffer, PushAndPopPackets)
+{
+	SpscVariableLengthRingbuffer buf;
+	ASSERT_TRUE(buf.allocate(64));
+
+	uint8_t in[16];
+
+	for (size_t i = 0; i < sizeof(in); ++i) {
+		in[i] = i;
+	}
+
+	uint8_t out[16] {};
+
+	// empty
+	EXPECT_EQ(buf.pop_front(out, sizeof(out)), 0);
+
+	// invalid packets
+	EXPECT_FALSE(buf.push_back(in, 0));
+	EXPECT_FALSE(buf.push_back(nullptr, 10));
+
+	for (int round = 0; round < 100; ++round) {
+		// lengths 1 to 16, which sometimes need to skip the end of the buffer
+		const size_t len_a = 1 + round % 16;
+		const size_t len_b = 1 + (round * 5) % 16;
+		ASSERT_TRUE(buf.push_back(in, len_a));
+		ASSERT_TRUE(buf.push_back(in + 1, len_b - 1) || len_b == 1);
+
+		ASSERT_EQ(buf.pop_front(out, sizeof(out)), len_a);
+		EXPECT_EQ(memcmp(in, out, len_a), 0);
+
+		if (len_b > 1) {
+			ASSERT_EQ(buf.pop_front(out, sizeof(out)), len_b - 1);
+			EXPECT_EQ(memcmp(in + 1, out, len_b - 1), 0);
+		}
+
+		EXPECT_EQ(buf.pop_front(out, sizeof(out)), 0);
+	}
+}
+
+TEST(SpscVariableLengthRingbuffer, RejectAndDrop)
+{
+	SpscVariableLengthRingbuffer buf;
+	ASSERT_TRUE(buf.allocate(32));
+
+	uint8_t in[40] {};
+	uint8_t out[40];
+
+	// a packet bigger than the buffer is rejected
+	EXPECT_FALSE(buf.push_back(in, 29));
+
+	// a packet bigger than the receive buffer is dropped
+	EXPECT_TRUE(buf.push_back(in, 12));
+	EXPECT_TRUE(buf.push_back(in, 4));
+	EXPECT_EQ(buf.pop_front(out, 8), 0);
+	EXPECT_EQ(buf.pop_front(out, 8), 4);
+
+	// the 16 byte record does not fit before the end, the last 8 bytes are skipped
+	EXPECT_TRUE(buf.push_back(in, 12));
+	EXPECT_FALSE(buf.push_back(in, 12));
+	EXPECT_TRUE(buf.push_back(in, 4));
+	EXPECT_FALSE(buf.push_back(in, 1));
+
+	EXPECT_EQ(buf.pop_front(out, sizeof(out)), 12);
+	EXPECT_EQ(buf.pop_front(out, sizeof(out)), 4);
+	EXPECT_EQ(buf.pop_front(out, sizeof(out)), 0);
+}
+
+TEST(SpscVariableLengthRingbuffer, PeekInPlace)
+{
+	SpscVariableLengthRingbuffer buf;
+	ASSERT_TRUE(buf.allocate(32));
+
+	const uint8_t in[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	const uint8_t *packet = nullptr;
+
+	EXPECT_EQ(buf.peek(&packet), 0);
+
+	for (int round = 0; round < 10; ++round) {
+		ASSERT_TRUE(buf.push_back(in, sizeof(in)));
+
+		ASSERT_EQ(buf.peek(&packet), sizeof(in));
+		EXPECT_EQ(memcmp(packet, in, sizeof(in)), 0);
+
+		// peeking again returns the same packet
+		ASSERT_EQ(buf.peek(&packet), sizeof(in));
+		buf.consume();
+
+		EXPECT_EQ(buf.peek(&packet), 0);
+	}
+}
+
+TEST(SpscVariableLengthRingbuffer, ConcurrentPackets)
+{
+	static constexpr uint32_t num_packets = 500000;
+
+	SpscVariableLengthRingbuffer buf;
+	ASSERT_TRUE(buf.allocate(1000));
+
+	// each packet has a variable length and is filled with its sequence number
+	std::thread producer([&buf]() {
+		uint8_t packet[100];
+
+		for (uint32_t seq = 0; seq < num_packets;) {
+			const size_t len = 1 + seq % sizeof(packet);
+			memset(packet, seq & 0xff, len);
+
+			if (buf.push_back(packet, len)) {
+				++seq;
+
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	uint32_t seq = 0;
+	bool valid = true;
+
+	while (seq < num_packets && valid) {
+		const uint8_t *packet = nullptr;
+		const size_t len = buf.peek(&packet);
+
+		if (len == 0) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		valid = (len == 1 + seq % 100);
+
+		for (size_t i = 0; i < len; ++i) {
+			valid = valid && (packet[i] == (seq & 0xff));
+		}
+
+		buf.consume();
+		++seq;
+	}
+
+	producer.join();
+
+	EXPECT_TRUE(valid);
+	EXPECT_EQ(seq, num_packets);
+}
+
+TEST(SpscVariableLengthRingbuffer, ConcurrentPacketsSmallBuffer)
+{
+	static constexpr uint32_t num_packets = 200000;
+
+	// a small buffer, so that the end of the buffer is skipped often while the consumer frees space
+	SpscVariableLengthRingbuffer buf;
+	ASSERT_TRUE(buf.allocate(64));
+
+	std::atomic<bool> stop{false};
+
+	// each packet has a variable length and starts with its sequence number
+	std::thread producer([&buf, &stop]() {
+		uint8_t packet[12];
+
+		for (uint32_t seq = 0; seq < num_packets && !stop.load();) {
+			const size_t len = sizeof(seq) + seq % (sizeof(packet) - sizeof(seq) + 1);
+			memset(packet, seq & 0xff, len);
+			memcpy(packet, &seq, sizeof(seq));
+
+			if (buf.push_back(packet, len)) {
+				++seq;
+
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	uint32_t seq = 0;
+	bool valid = true;
+
+	while (seq < num_packets && valid) {
+		uint8_t packet[12];
+		const size_t len = buf.pop_front(packet, sizeof(packet));
+
+		if (len == 0) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		uint32_t packet_seq;
+		memcpy(&packet_seq, packet, sizeof(packet_seq));
+
+		valid = (packet_seq == seq) && (len == sizeof(seq) + seq % (sizeof(packet) - sizeof(seq) + 1));
+
+		for (size_t i = sizeof(seq); i < len; ++i) {
+			valid = valid && (packet[i] == (seq & 0xff));
+		}
+
+		++seq;
+	}
+
+	stop.store(true);
+	producer.join();
+
+	EXPECT_TRUE(valid);
+	EXPECT_EQ(seq, num_packets);
+}
@@ -0,0 +1,163 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+
+#include "SpscVariableLengthRingbuffer.hpp"
+
+#include <string.h>
+
+
+bool SpscVariableLengthRingbuffer::allocate(size_t buffer_size)
+{
+	// Every record starts 4 byte aligned, which needs a size of at least 8 bytes.
+	if (buffer_size < 2 * sizeof(Header)) {
+		buffer_size = 2 * sizeof(Header);
+	}
+
+	return _ringbuffer.allocate(buffer_size);
+}
+
+bool SpscVariableLengthRingbuffer::push_back(const uint8_t *packet, size_t packet_len)
+{
+	if (packet_len == 0 || packet == nullptr || packet_len >= SKIP_MARKER) {
+		// Nothing to add, we better don't try.
+		return false;
+	}
+
+	const size_t space_required = record_size(packet_len);
+
+	if (space_required > _ringbuffer.capacity()) {
+		return false;
+	}
+
+	uint8_t *dst = nullptr;
+	size_t contiguous = _ringbuffer.reserve(&dst);
+
+	if (contiguous < space_required) {
+		// The reserved space can be limited by the free space or by the end of the buffer.
+		// Decide on the distance to the end, since the consumer can free space concurrently
+		// and the skipped space must always extend to the end of the buffer.
+		const size_t to_end = _ringbuffer.space_to_end();
+
+		if (to_end < space_required) {
+			// Skip the rest of the buffer if the packet fits at the start.
+			if (_ringbuffer.space_available() < to_end + space_required) {
+				return false;
+			}
+
+			const Header skip{SKIP_MARKER};
+			memcpy(dst, &skip, sizeof(skip));
+			_ringbuffer.commit(to_end);
+
+		} else if (_ringbuffer.space_available() < space_required) {
+			return false;
+		}
+
+		contiguous = _ringbuffer.reserve(&dst);
+
+		if (contiguous < space_required) {
+			return false;
+		}
+	}
+
+	const Header header{static_cast<uint32_t>(packet_len)};
+	memcpy(dst, &header, sizeof(header));
+	memcpy(dst + sizeof(header), packet, packet_len);
+	_ringbuffer.commit(space_required);
+
+	return true;
+}
+
+size_t SpscVariableLengthRingbuffer::pop_front(uint8_t *buf, size_t max_buf_len)
+{
+	if (buf == nullptr) {
+		return 0;
+	}
+
+	const uint8_t *packet = nullptr;
+	const size_t packet_len = peek(&packet);
+
+	if (packet_len == 0) {
+		return 0;
+	}
+
+	size_t copied = 0;
+
+	if (packet_len <= max_buf_len) {
+		memcpy(buf, packet, packet_len);
+		copied = packet_len;
+	}
+
+	consume();
+	return copied;
+}
+
+size_t SpscVariableLengthRingbuffer::peek(const uint8_t **packet)
+{
+	const uint8_t *src = nullptr;
+	size_t contiguous = _ringbuffer.peek(&src);
+
+	if (contiguous == 0) {
+		return 0;
+	}
+
+	Header header;
+	memcpy(&header, src, sizeof(header));
+
+	if (header.len == SKIP_MARKER) {
+		// the skipped space always extends to the end of the buffer
+		_ringbuffer.consume(contiguous);
+
+		contiguous = _ringbuffer.peek(&src);
+
+		if (contiguous == 0) {
+			return 0;
+		}
+
+		memcpy(&header, src, sizeof(header));
+	}
+
+	*packet = src + sizeof(header);
+	return header.len;
+}
+
+void SpscVariableLengthRingbuffer::consume()
+{
+	const uint8_t *packet = nullptr;
+	const size_t packet_len = peek(&packet);
+
+	if (packet_len > 0) {
+		_ringbuffer.consume(record_size(packet_len));
+	}
+}
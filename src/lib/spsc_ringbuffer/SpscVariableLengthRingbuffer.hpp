@@ -0,0 +1,136 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+#include "SpscRingbuffer.hpp"
+
+
+// Lock-free FIFO ringbuffer for packets of variable length, for exactly one
+// producer and one consumer thread (see SpscRingbuffer).
+//
+// Each packet is stored as a 4 byte header containing the length, followed by
+// the packet, padded to a multiple of 4 bytes. Header and packet are published
+// together, and a packet never wraps around the end of the buffer, which allows
+// the consumer to access it in place with peek(). If a packet does not fit
+// before the end of the buffer, the rest is marked as skipped.
+
+class SpscVariableLengthRingbuffer
+{
+public:
+	/* @brief Constructor
+	 *
+	 * @note Does not allocate automatically.
+	 */
+	SpscVariableLengthRingbuffer() = default;
+
+	/*
+	 * @brief Destructor
+	 *
+	 * Automatically calls deallocate.
+	 */
+	~SpscVariableLengthRingbuffer() = default;
+
+	/* @brief Allocate ringbuffer
+	 *
+	 * @note The variable length requires 4 to 7 bytes of overhead per packet.
+	 * A packet is always accepted into an empty buffer if the packet with its
+	 * overhead needs at most half of the buffer.
+	 *
+	 * @param buffer_size Number of bytes to allocate on heap, rounded up to the next power of two.
+	 *
+	 * @returns false if allocation fails.
+	 */
+	bool allocate(size_t buffer_size);
+
+	/*
+	 * @brief Deallocate ringbuffer
+	 *
+	 * @note only required to deallocate and reallocate again.
+	 */
+	void deallocate() { _ringbuffer.deallocate(); }
+
+	/*
+	 * @brief Copy packet into ringbuffer (producer)
+	 *
+	 * @param packet Pointer to packet to copy from.
+	 * @param packet_len Length of packet.
+	 *
+	 * @returns true if packet could be copied into buffer.
+	 */
+	bool push_back(const uint8_t *packet, size_t packet_len);
+
+	/*
+	 * @brief Get packet from ringbuffer (consumer)
+	 *
+	 * @note A packet bigger than max_buf_len is dropped.
+	 *
+	 * @param buf Pointer to where next packet can be copied into.
+	 * @param max_buf_len Max size of buf
+	 *
+	 * @returns 0 if packet is bigger than max_len or buffer is empty.
+	 */
+	size_t pop_front(uint8_t *buf, size_t max_buf_len);
+
+	/*
+	 * @brief Access the next packet in place (consumer)
+	 *
+	 * The packet stays in the buffer until consume() is called.
+	 *
+	 * @param packet Set to the start of the packet.
+	 *
+	 * @returns length of the packet, 0 if empty.
+	 */
+	size_t peek(const uint8_t **packet);
+
+	/*
+	 * @brief Remove the packet returned by peek() (consumer)
+	 */
+	void consume();
+
+private:
+	struct Header {
+		uint32_t len;
+	};
+
+	static constexpr uint32_t SKIP_MARKER = UINT32_MAX;
+
+	static size_t record_size(size_t packet_len)
+	{
+		return (sizeof(Header) + packet_len + 3) & ~static_cast<size_t>(3);
+	}
+
+	SpscRingbuffer<uint8_t> _ringbuffer {};
+};
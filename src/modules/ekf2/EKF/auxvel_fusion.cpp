@@ -45,7 +45,7 @@ void Ekf::controlAuxVelFusion()
 			updateHorizontalVelocityAidSrcStatus(auxvel_sample_delayed.time_us, auxvel_sample_delayed.vel, auxvel_sample_delayed.velVar, fmaxf(_params.auxvel_gate, 1.f), _aid_src_aux_vel);
 
 			if (isHorizontalAidingActive()) {
-				fuseHorizontalVelocity(_aid_src_aux_vel);
+				fuseHorizontalVelocity(_aid_src_aux_vel, isVectorFusionEnabled(VectorFusion::AUX_VEL));
 			}
 		}
 	}
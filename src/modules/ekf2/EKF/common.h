@@ -140,6 +140,14 @@ enum class GnssCtrl : uint8_t {
 	YAW  = (1<<3)
 };
 
+enum class VectorFusion : uint8_t {
+	GNSS_VEL  = (1<<0),
+	GNSS_HPOS = (1<<1),
+	EV_VEL    = (1<<2),
+	EV_HPOS   = (1<<3),
+	AUX_VEL   = (1<<4)
+};
+
 enum class RngCtrl : uint8_t {
 	DISABLED    = 0,
 	CONDITIONAL = 1,
@@ -261,6 +269,8 @@ struct parameters {
 
 	int32_t imu_ctrl{static_cast<int32_t>(ImuCtrl::GyroBias) | static_cast<int32_t>(ImuCtrl::AccelBias)};
 
+	int32_t vector_fusion_mask{0}; ///< aid sources that are fused with a single vector update (see VectorFusion)
+
 	// measurement source control
 	int32_t height_sensor_ref{static_cast<int32_t>(HeightSensor::BARO)};
 	int32_t position_sensor_ref{static_cast<int32_t>(PositionSensor::GNSS)};
@@ -318,6 +318,12 @@ public:
 	// fuse single direct state measurement (eg NED velocity, NED position, mag earth field, etc)
 	bool fuseDirectStateMeasurement(const float innov, const float innov_var, const float R, const int state_index);
 
+	// fuse N consecutive direct state measurements with a single covariance update (vector fusion)
+	// R is the observation variance of each element, the innovation covariance is computed from P
+	template<size_t N>
+	bool fuseDirectStateMeasurement(const matrix::Vector<float, N> &innov, const matrix::Vector<float, N> &R,
+					const int state_index);
+
 	// gyro bias
 	const Vector3f &getGyroBias() const { return _state.gyro_bias; } // get the gyroscope bias in rad/s
 	Vector3f getGyroBiasVariance() const { return getStateVariance<State::gyro_bias>(); } // get the gyroscope bias variance in rad/s
@@ -475,24 +481,60 @@ public:
 		// P = (I - K * H) * P * (I - K * H).T   + K * R * K.T
 		//   =      P_temp     * (I - H.T * K.T) + K * R * K.T
 		//   =      P_temp - P_temp * H.T * K.T  + K * R * K.T
+		//
+		// Most observation Jacobians only have a few non-zero elements, so the products with H only
+		// iterate over those. The result is symmetric, so only the lower triangle of P_temp is
+		// computed (on the fly) and mirrored. Skipping the zero elements of H does not change the
+		// floating point result compared to the dense products.
 
-		// Step 1: conventional update
-		// Compute P_temp and store it in P to avoid allocating more memory
-		// P is symmetric, so PH == H.T * P.T == H.T * P. Taking the row is faster as matrices are row-major
-		VectorState PH = P * H; // H is stored as a column vector. H is in fact H.T
+		// indices of the non-zero elements of H
+		uint8_t H_idx[State::size];
+		unsigned H_nnz = 0;
 
 		for (unsigned i = 0; i < State::size; i++) {
-			for (unsigned j = 0; j < State::size; j++) {
-				P(i, j) -= K(i) * PH(j); // P is now not symmetrical if K is not optimal (e.g.: some gains have been zeroed)
+			if (fabsf(H(i)) > 0.f) {
+				H_idx[H_nnz++] = i;
 			}
 		}
 
-		// Step 2: stabilized update
-		PH = P * H; // H is stored as a column vector. H is in fact H.T
+		// Step 1: conventional update, P_temp = P - K * PH.T
+		// P_temp is not symmetrical if K is not optimal (e.g.: some gains have been zeroed)
+		// P is symmetric, so PH == H.T * P.T == H.T * P. H is stored as a column vector. H is in fact H.T
+		VectorState PH;
+
+		// Step 2: stabilized update, P = P_temp - P_temp * H * K.T + K * R * K.T
+		// The columns of P_temp needed for P_temp * H are computed on the fly
+		VectorState P_tempH;
+
+		if (H_nnz > State::size / 2) {
+			// mostly dense H: direct indexing is faster
+			PH = P * H;
+
+			for (unsigned i = 0; i < State::size; i++) {
+				for (unsigned k = 0; k < State::size; k++) {
+					P_tempH(i) += (P(i, k) - K(i) * PH(k)) * H(k);
+				}
+			}
+
+		} else {
+			for (unsigned i = 0; i < State::size; i++) {
+				for (unsigned n = 0; n < H_nnz; n++) {
+					PH(i) += P(i, H_idx[n]) * H(H_idx[n]);
+				}
+			}
+
+			for (unsigned i = 0; i < State::size; i++) {
+				for (unsigned n = 0; n < H_nnz; n++) {
+					const unsigned k = H_idx[n];
+					P_tempH(i) += (P(i, k) - K(i) * PH(k)) * H(k);
+				}
+			}
+		}
 
 		for (unsigned i = 0; i < State::size; i++) {
 			for (unsigned j = 0; j <= i; j++) {
-				P(i, j) = P(i, j) - PH(i) * K(j) + K(i) * R * K(j);
+				const float P_temp = P(i, j) - K(i) * PH(j);
+				P(i, j) = P_temp - P_tempH(i) * K(j) + K(i) * R * K(j);
 				P(j, i) = P(i, j);
 			}
 		}
@@ -828,12 +870,15 @@ private:
 	void updateVelocityAidSrcStatus(const uint64_t &time_us, const Vector3f &obs, const Vector3f &obs_var, const float innov_gate, estimator_aid_source3d_s &aid_src) const;
 
 	// horizontal and vertical position fusion
-	void fuseHorizontalPosition(estimator_aid_source2d_s &pos_aid_src);
+	// if vector_fusion is set, all axes are fused with a single covariance update instead of sequentially
+	void fuseHorizontalPosition(estimator_aid_source2d_s &pos_aid_src, bool vector_fusion = false);
 	void fuseVerticalPosition(estimator_aid_source1d_s &hgt_aid_src);
 
 	// 2d & 3d velocity fusion
-	void fuseHorizontalVelocity(estimator_aid_source2d_s &vel_aid_src);
-	void fuseVelocity(estimator_aid_source3d_s &vel_aid_src);
+	void fuseHorizontalVelocity(estimator_aid_source2d_s &vel_aid_src, bool vector_fusion = false);
+	void fuseVelocity(estimator_aid_source3d_s &vel_aid_src, bool vector_fusion = false);
+
+	bool isVectorFusionEnabled(VectorFusion source) const { return _params.vector_fusion_mask & static_cast<int32_t>(source); }
 
 #if defined(CONFIG_EKF2_TERRAIN)
 	// terrain vertical position estimator
@@ -883,3 +883,105 @@ bool Ekf::fuseDirectStateMeasurement(const float innov, const float innov_var, c
 	fuse(K, innov);
 	return true;
 }
+
+template<size_t N>
+bool Ekf::fuseDirectStateMeasurement(const matrix::Vector<float, N> &innov, const matrix::Vector<float, N> &R,
+				     const int state_index)
+{
+	// H selects the N consecutive states starting at state_index, so P * H.T are the corresponding
+	// columns of P and the innovation covariance S = H * P * H.T + R is a block of P
+	const matrix::Matrix<float, State::size, N> PHt = P.slice<State::size, N>(0, state_index);
+	matrix::SquareMatrix<float, N> S = P.slice<N, N>(state_index, state_index);
+
+	for (size_t n = 0; n < N; n++) {
+		S(n, n) += R(n);
+	}
+
+	// calculate the Kalman gain K = P * H.T * S^-1 using the Cholesky factorization S = L * L.T
+	const matrix::SquareMatrix<float, N> L = matrix::cholesky(S);
+
+	for (size_t n = 0; n < N; n++) {
+		if (!(L(n, n) > 0.f)) {
+			// S is not positive definite
+			return false;
+		}
+	}
+
+	matrix::Matrix<float, State::size, N> K;
+
+	for (unsigned row = 0; row < State::size; row++) {
+		// solve L * y = (P * H.T)(row, :).T and L.T * k = y
+		float y[N];
+
+		for (size_t n = 0; n < N; n++) {
+			float sum = PHt(row, n);
+
+			for (size_t m = 0; m < n; m++) {
+				sum -= L(n, m) * y[m];
+			}
+
+			y[n] = sum / L(n, n);
+		}
+
+		for (size_t n = N; n-- > 0;) {
+			float sum = y[n];
+
+			for (size_t m = n + 1; m < N; m++) {
+				sum -= L(m, n) * K(row, m);
+			}
+
+			K(row, n) = sum / L(n, n);
+		}
+	}
+
+	for (size_t n = 0; n < N; n++) {
+		VectorState K_col = K.col(n);
+		clearInhibitedStateKalmanGains(K_col);
+		K.col(n) = K_col;
+	}
+
+	// Joseph stabilized covariance update, see fuseDirectStateMeasurement() above
+	// P_temp = P - K * PHt.T
+	// P = P_temp - P_temp * H.T * K.T + K * R * K.T
+	//   = P + K * (R * K.T - PHt.T) - (P_temp * H.T) * K.T
+	// where P_temp * H.T are the columns state_index... of P_temp
+	matrix::Matrix<float, State::size, N> P_tempHt;
+	matrix::Matrix<float, State::size, N> RK_PHt;
+
+	for (unsigned i = 0; i < State::size; i++) {
+		for (size_t n = 0; n < N; n++) {
+			float sum = PHt(i, n);
+
+			for (size_t m = 0; m < N; m++) {
+				sum -= K(i, m) * PHt(state_index + n, m);
+			}
+
+			P_tempHt(i, n) = sum;
+			RK_PHt(i, n) = R(n) * K(i, n) - PHt(i, n);
+		}
+	}
+
+	for (unsigned i = 0; i < State::size; i++) {
+		for (unsigned j = 0; j <= i; j++) {
+			float P_ij = P(i, j);
+
+			for (size_t n = 0; n < N; n++) {
+				P_ij += K(i, n) * RK_PHt(j, n) - P_tempHt(i, n) * K(j, n);
+			}
+
+			P(i, j) = P_ij;
+			P(j, i) = P_ij;
+		}
+	}
+
+	constrainStateVariances();
+
+	// apply the state corrections, the combined correction is K * innov
+	fuse(K * innov, 1.f);
+	return true;
+}
+
+template bool Ekf::fuseDirectStateMeasurement<2>(const matrix::Vector<float, 2> &, const matrix::Vector<float, 2> &,
+		const int);
+template bool Ekf::fuseDirectStateMeasurement<3>(const matrix::Vector<float, 3> &, const matrix::Vector<float, 3> &,
+		const int);
@@ -247,7 +247,7 @@ void Ekf::updateEvPosFusion(const Vector2f &measurement, const Vector2f &measure
 		}
 
 	} else if (quality_sufficient) {
-		fuseHorizontalPosition(aid_src);
+		fuseHorizontalPosition(aid_src, isVectorFusionEnabled(VectorFusion::EV_HPOS));
 
 	} else {
 		aid_src.innovation_rejected = true;
@@ -159,7 +159,7 @@ void Ekf::controlEvVelFusion(const extVisionSample &ev_sample, const bool common
 				}
 
 			} else if (quality_sufficient) {
-				fuseVelocity(aid_src);
+				fuseVelocity(aid_src, isVectorFusionEnabled(VectorFusion::EV_VEL));
 
 			} else {
 				aid_src.innovation_rejected = true;
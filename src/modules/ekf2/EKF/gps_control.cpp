@@ -114,11 +114,11 @@ void Ekf::controlGpsFusion(const imuSample &imu_delayed)
 		if (_control_status.flags.gps) {
 			if (continuing_conditions_passing) {
 				if (gnss_vel_enabled) {
-					fuseVelocity(_aid_src_gnss_vel);
+					fuseVelocity(_aid_src_gnss_vel, isVectorFusionEnabled(VectorFusion::GNSS_VEL));
 				}
 
 				if (gnss_pos_enabled) {
-					fuseHorizontalPosition(_aid_src_gnss_pos);
+					fuseHorizontalPosition(_aid_src_gnss_pos, isVectorFusionEnabled(VectorFusion::GNSS_HPOS));
 				}
 
 				bool do_vel_pos_reset = shouldResetGpsFusion();
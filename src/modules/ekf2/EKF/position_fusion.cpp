@@ -76,13 +76,22 @@ void Ekf::updateVerticalPositionAidSrcStatus(const uint64_t &time_us, const floa
 	aid_src.timestamp_sample = time_us;
 }
 
-void Ekf::fuseHorizontalPosition(estimator_aid_source2d_s &aid_src)
+void Ekf::fuseHorizontalPosition(estimator_aid_source2d_s &aid_src, bool vector_fusion)
 {
 	// x & y
-	if (!aid_src.innovation_rejected
-	    && fuseDirectStateMeasurement(aid_src.innovation[0], aid_src.innovation_variance[0], aid_src.observation_variance[0], State::pos.idx + 0)
-	    && fuseDirectStateMeasurement(aid_src.innovation[1], aid_src.innovation_variance[1], aid_src.observation_variance[1], State::pos.idx + 1)
-	   ) {
+	bool fused = false;
+
+	if (!aid_src.innovation_rejected) {
+		if (vector_fusion) {
+			fused = fuseDirectStateMeasurement(Vector2f(aid_src.innovation), Vector2f(aid_src.observation_variance), State::pos.idx);
+
+		} else {
+			fused = fuseDirectStateMeasurement(aid_src.innovation[0], aid_src.innovation_variance[0], aid_src.observation_variance[0], State::pos.idx + 0)
+				&& fuseDirectStateMeasurement(aid_src.innovation[1], aid_src.innovation_variance[1], aid_src.observation_variance[1], State::pos.idx + 1);
+		}
+	}
+
+	if (fused) {
 		aid_src.fused = true;
 		aid_src.time_last_fuse = _time_delayed_us;
 
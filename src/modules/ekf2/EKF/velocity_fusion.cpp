@@ -79,13 +79,22 @@ void Ekf::updateVelocityAidSrcStatus(const uint64_t &time_us, const Vector3f &ob
 	aid_src.timestamp_sample = time_us;
 }
 
-void Ekf::fuseHorizontalVelocity(estimator_aid_source2d_s &aid_src)
+void Ekf::fuseHorizontalVelocity(estimator_aid_source2d_s &aid_src, bool vector_fusion)
 {
 	// vx, vy
-	if (!aid_src.innovation_rejected
-	    && fuseDirectStateMeasurement(aid_src.innovation[0], aid_src.innovation_variance[0], aid_src.observation_variance[0], State::vel.idx + 0)
-	    && fuseDirectStateMeasurement(aid_src.innovation[1], aid_src.innovation_variance[1], aid_src.observation_variance[1], State::vel.idx + 1)
-	   ) {
+	bool fused = false;
+
+	if (!aid_src.innovation_rejected) {
+		if (vector_fusion) {
+			fused = fuseDirectStateMeasurement(Vector2f(aid_src.innovation), Vector2f(aid_src.observation_variance), State::vel.idx);
+
+		} else {
+			fused = fuseDirectStateMeasurement(aid_src.innovation[0], aid_src.innovation_variance[0], aid_src.observation_variance[0], State::vel.idx + 0)
+				&& fuseDirectStateMeasurement(aid_src.innovation[1], aid_src.innovation_variance[1], aid_src.observation_variance[1], State::vel.idx + 1);
+		}
+	}
+
+	if (fused) {
 		aid_src.fused = true;
 		aid_src.time_last_fuse = _time_delayed_us;
 
@@ -96,14 +105,23 @@ void Ekf::fuseHorizontalVelocity(estimator_aid_source2d_s &aid_src)
 	}
 }
 
-void Ekf::fuseVelocity(estimator_aid_source3d_s &aid_src)
+void Ekf::fuseVelocity(estimator_aid_source3d_s &aid_src, bool vector_fusion)
 {
 	// vx, vy, vz
-	if (!aid_src.innovation_rejected
-	    && fuseDirectStateMeasurement(aid_src.innovation[0], aid_src.innovation_variance[0], aid_src.observation_variance[0], State::vel.idx + 0)
-	    && fuseDirectStateMeasurement(aid_src.innovation[1], aid_src.innovation_variance[1], aid_src.observation_variance[1], State::vel.idx + 1)
-	    && fuseDirectStateMeasurement(aid_src.innovation[2], aid_src.innovation_variance[2], aid_src.observation_variance[2], State::vel.idx + 2)
-	   ) {
+	bool fused = false;
+
+	if (!aid_src.innovation_rejected) {
+		if (vector_fusion) {
+			fused = fuseDirectStateMeasurement(Vector3f(aid_src.innovation), Vector3f(aid_src.observation_variance), State::vel.idx);
+
+		} else {
+			fused = fuseDirectStateMeasurement(aid_src.innovation[0], aid_src.innovation_variance[0], aid_src.observation_variance[0], State::vel.idx + 0)
+				&& fuseDirectStateMeasurement(aid_src.innovation[1], aid_src.innovation_variance[1], aid_src.observation_variance[1], State::vel.idx + 1)
+				&& fuseDirectStateMeasurement(aid_src.innovation[2], aid_src.innovation_variance[2], aid_src.observation_variance[2], State::vel.idx + 2);
+		}
+	}
+
+	if (fused) {
 		aid_src.fused = true;
 		aid_src.time_last_fuse = _time_delayed_us;
 
@@ -65,6 +65,7 @@ EKF2::EKF2(bool multi_mode, const px4::wq_config_t &config, bool replay_mode):
 	_params(_ekf.getParamHandle()),
 	_param_ekf2_predict_us(_params->filter_update_interval_us),
 	_param_ekf2_imu_ctrl(_params->imu_ctrl),
+	_param_ekf2_vec_fuse(_params->vector_fusion_mask),
 #if defined(CONFIG_EKF2_AUXVEL)
 	_param_ekf2_avel_delay(_params->auxvel_delay_ms),
 #endif // CONFIG_EKF2_AUXVEL
@@ -231,6 +232,9 @@ EKF2::~EKF2()
 {
 	perf_free(_ekf_update_perf);
 	perf_free(_msg_missed_imu_perf);
+#if defined(CONFIG_EKF2_MULTI_INSTANCE)
+	perf_free(_cycle_perf);
+#endif // CONFIG_EKF2_MULTI_INSTANCE
 }
 
 #if defined(CONFIG_EKF2_MULTI_INSTANCE)
@@ -387,6 +391,13 @@ int EKF2::print_status(bool verbose)
 
 	perf_print_counter(_ekf_update_perf);
 	perf_print_counter(_msg_missed_imu_perf);
+#if defined(CONFIG_EKF2_MULTI_INSTANCE)
+
+	if (_multi_mode) {
+		perf_print_counter(_cycle_perf);
+	}
+
+#endif // CONFIG_EKF2_MULTI_INSTANCE
 
 	if (verbose) {
 #if defined(CONFIG_EKF2_VERBOSE_STATUS)
@@ -549,6 +560,7 @@ void EKF2::Run()
 	hrt_abstime imu_dt = 0; // for tracking time slip later
 
 #if defined(CONFIG_EKF2_MULTI_INSTANCE)
+	hrt_abstime imu_published = 0;
 
 	if (_multi_mode) {
 		const unsigned last_generation = _vehicle_imu_sub.get_last_generation();
@@ -560,6 +572,7 @@ void EKF2::Run()
 		}
 
 		if (imu_updated) {
+			imu_published = imu.timestamp;
 			imu_sample_new.time_us = imu.timestamp_sample;
 			imu_sample_new.delta_ang_dt = imu.delta_angle_dt * 1.e-6f;
 			imu_sample_new.delta_ang = Vector3f{imu.delta_angle};
@@ -795,6 +808,15 @@ void EKF2::Run()
 
 		// publish ekf2_timestamps
 		_ekf2_timestamps_pub.publish(ekf2_timestamps);
+
+#if defined(CONFIG_EKF2_MULTI_INSTANCE)
+
+		if (_multi_mode) {
+			// wall time from the IMU publication until this instance is done with it
+			perf_set_elapsed(_cycle_perf, hrt_elapsed_time(&imu_published));
+		}
+
+#endif // CONFIG_EKF2_MULTI_INSTANCE
 	}
 
 	// re-schedule as backup timeout
@@ -2673,6 +2695,7 @@ int EKF2::task_spawn(int argc, char *argv[])
 	bool multi_mode = false;
 	int32_t imu_instances = 0;
 	int32_t mag_instances = 0;
+	int32_t multi_pool = 0;
 
 	int32_t sens_imu_mode = 1;
 	param_get(param_find("SENS_IMU_MODE"), &sens_imu_mode);
@@ -2681,6 +2704,11 @@ int EKF2::task_spawn(int argc, char *argv[])
 		// ekf selector requires SENS_IMU_MODE = 0
 		multi_mode = true;
 
+#if defined(__PX4_POSIX)
+		// the pool needs several threads per work queue, which is posix only
+		param_get(param_find("EKF2_MULTI_POOL"), &multi_pool);
+#endif // __PX4_POSIX
+
 		// IMUs (1 - MAX_NUM_IMUS supported)
 		param_get(param_find("EKF2_MULTI_IMU"), &imu_instances);
 
@@ -2769,7 +2797,11 @@ int EKF2::task_spawn(int argc, char *argv[])
 					if ((vehicle_mag_sub.advertised() || mag == 0) && (vehicle_imu_sub.advertised())) {
 
 						if (!ekf2_instance_created[imu][mag]) {
-							EKF2 *ekf2_inst = new EKF2(true, px4::ins_instance_to_wq(imu), false);
+							// either one queue per IMU or all instances on the shared pool
+							const px4::wq_config_t &wq_config = (multi_pool == 1) ? px4::wq_configurations::INS_pool :
+											    px4::ins_instance_to_wq(imu);
+
+							EKF2 *ekf2_inst = new EKF2(true, wq_config, false);
 
 							if (ekf2_inst && ekf2_inst->multi_init(imu, mag)) {
 								int actual_instance = ekf2_inst->instance(); // match uORB instance numbering
@@ -278,6 +278,9 @@ private:
 
 	perf_counter_t _ekf_update_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": EKF update")};
 	perf_counter_t _msg_missed_imu_perf{perf_alloc(PC_COUNT, MODULE_NAME": IMU message missed")};
+#if defined(CONFIG_EKF2_MULTI_INSTANCE)
+	perf_counter_t _cycle_perf {perf_alloc(PC_HISTOGRAM, MODULE_NAME": IMU cycle")};
+#endif // CONFIG_EKF2_MULTI_INSTANCE
 
 	InFlightCalibration _accel_cal{};
 	InFlightCalibration _gyro_cal{};
@@ -499,6 +502,7 @@ private:
 	DEFINE_PARAMETERS(
 		(ParamExtInt<px4::params::EKF2_PREDICT_US>) _param_ekf2_predict_us,
 		(ParamExtInt<px4::params::EKF2_IMU_CTRL>) _param_ekf2_imu_ctrl,
+		(ParamExtInt<px4::params::EKF2_VEC_FUSE>) _param_ekf2_vec_fuse,
 
 #if defined(CONFIG_EKF2_AUXVEL)
 		(ParamExtFloat<px4::params::EKF2_AVEL_DELAY>)
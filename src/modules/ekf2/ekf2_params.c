@@ -64,6 +64,24 @@ PARAM_DEFINE_INT32(EKF2_PREDICT_US, 10000);
  */
 PARAM_DEFINE_INT32(EKF2_IMU_CTRL, 7);
 
+/**
+ * Vector fusion of multi-axis observations
+ *
+ * Set bits to fuse all axes of the selected observations with a single covariance update,
+ * using a Cholesky factorization of the innovation covariance. Otherwise the axes are
+ * fused sequentially, with one covariance update per axis.
+ *
+ * @group EKF2
+ * @min 0
+ * @max 31
+ * @bit 0 GNSS velocity
+ * @bit 1 GNSS horizontal position
+ * @bit 2 External vision velocity
+ * @bit 3 External vision horizontal position
+ * @bit 4 Auxiliary velocity
+ */
+PARAM_DEFINE_INT32(EKF2_VEC_FUSE, 0);
+
 /**
  * Magnetometer measurement delay relative to IMU measurements
  *
@@ -56,3 +56,18 @@ PARAM_DEFINE_INT32(EKF2_MULTI_IMU, 0);
  * @max 4
  */
 PARAM_DEFINE_INT32(EKF2_MULTI_MAG, 0);
+
+/**
+ * Multi-EKF shared thread pool.
+ *
+ * Run all Multi-EKF instances on a pool of threads (wq:INS_pool) instead of
+ * one thread per IMU, so that instances can use spare CPU cores.
+ * Each instance still processes its own data in order, the estimates are
+ * identical in both modes.
+ * Only supported on posix (e.g. Linux), the parameter is ignored on NuttX.
+ *
+ * @group EKF2
+ * @reboot_required true
+ * @boolean
+ */
+PARAM_DEFINE_INT32(EKF2_MULTI_POOL, 0);
@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Compare and benchmark sequential and vector fusion of GNSS velocity and position
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include "EKF/ekf.h"
+#include "sensor_simulator/sensor_simulator.h"
+#include "sensor_simulator/ekf_wrapper.h"
+
+class EkfVectorFusionTest : public ::testing::Test
+{
+public:
+	EkfVectorFusionTest(): ::testing::Test(),
+		_ekf{std::make_shared<Ekf>()},
+		_sensor_simulator(_ekf),
+		_ekf_wrapper(_ekf),
+		_ekf_vec{std::make_shared<Ekf>()},
+		_sensor_simulator_vec(_ekf_vec),
+		_ekf_wrapper_vec(_ekf_vec) {};
+
+	// sequential fusion
+	std::shared_ptr<Ekf> _ekf;
+	SensorSimulator _sensor_simulator;
+	EkfWrapper _ekf_wrapper;
+
+	// vector fusion
+	std::shared_ptr<Ekf> _ekf_vec;
+	SensorSimulator _sensor_simulator_vec;
+	EkfWrapper _ekf_wrapper_vec;
+
+	void SetUp() override
+	{
+		_ekf_vec->getParamHandle()->vector_fusion_mask = static_cast<int32_t>(VectorFusion::GNSS_VEL)
+				| static_cast<int32_t>(VectorFusion::GNSS_HPOS);
+	}
+
+	/**
+	 * run the replay on the sensor simulator
+	 * @return processing time in seconds
+	 */
+	static double runReplay(SensorSimulator &sensor_simulator, EkfWrapper &ekf_wrapper, float duration_seconds)
+	{
+		sensor_simulator.loadSensorDataFromFile(TEST_DATA_PATH"/replay_data/iris_gps.csv");
+		sensor_simulator.startGps();
+		ekf_wrapper.enableGpsFusion();
+
+		const auto start = std::chrono::steady_clock::now();
+		sensor_simulator.runReplaySeconds(duration_seconds);
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+};
+
+TEST_F(EkfVectorFusionTest, gnssReplay)
+{
+	// WHEN: replaying the same data with sequential and with vector fusion of the GNSS observations
+	const double time_sequential = runReplay(_sensor_simulator, _ekf_wrapper, 35.f);
+	const double time_vector = runReplay(_sensor_simulator_vec, _ekf_wrapper_vec, 35.f);
+
+	printf("replay processing time: sequential fusion %.3f ms, vector fusion %.3f ms\n",
+	       time_sequential * 1e3, time_vector * 1e3);
+
+	// THEN: both filters use GNSS and converge to the same solution
+	EXPECT_TRUE(_ekf_wrapper.isIntendingGpsFusion());
+	EXPECT_TRUE(_ekf_wrapper_vec.isIntendingGpsFusion());
+
+	EXPECT_TRUE(isEqual(_ekf->getPosition(), _ekf_vec->getPosition(), 0.1f));
+	EXPECT_TRUE(isEqual(_ekf->getVelocity(), _ekf_vec->getVelocity(), 0.05f));
+	EXPECT_TRUE(isEqual(_ekf->getPositionVariance(), _ekf_vec->getPositionVariance(), 1e-3f));
+	EXPECT_TRUE(isEqual(_ekf->getVelocityVariance(), _ekf_vec->getVelocityVariance(), 1e-3f));
+
+	// AND: the covariance matrix stays symmetric
+	const auto &P = _ekf_vec->covariances();
+
+	for (unsigned i = 0; i < State::size; i++) {
+		for (unsigned j = 0; j < i; j++) {
+			EXPECT_EQ(P(i, j), P(j, i));
+		}
+	}
+}
+
+TEST_F(EkfVectorFusionTest, gnssVelocityStep)
+{
+	// GIVEN: both filters fusing GNSS at rest
+	const Vector3f simulated_velocity(1.5f, -0.5f, 0.f);
+
+	for (int i = 0; i < 2; i++) {
+		Ekf &ekf = (i == 0) ? *_ekf : *_ekf_vec;
+		SensorSimulator &sensor_simulator = (i == 0) ? _sensor_simulator : _sensor_simulator_vec;
+		EkfWrapper &ekf_wrapper = (i == 0) ? _ekf_wrapper : _ekf_wrapper_vec;
+
+		ekf.init(0);
+		sensor_simulator.runSeconds(0.1);
+		ekf.set_in_air_status(false);
+		ekf.set_vehicle_at_rest(true);
+
+		sensor_simulator.runSeconds(2);
+		ekf_wrapper.enableGpsFusion();
+		sensor_simulator.startGps();
+		sensor_simulator.runSeconds(11);
+
+		EXPECT_TRUE(ekf_wrapper.isIntendingGpsFusion());
+
+		// WHEN: the vehicle starts moving
+		sensor_simulator._gps.setVelocity(simulated_velocity);
+		sensor_simulator._gps.setPositionRateNED(simulated_velocity);
+		ekf.set_in_air_status(true);
+		ekf.set_vehicle_at_rest(false);
+
+		sensor_simulator.runSeconds(10);
+	}
+
+	// THEN: the vector fusion tracks the velocity like the sequential fusion
+	EXPECT_TRUE(isEqual(_ekf_vec->getVelocity(), simulated_velocity, 0.1f));
+	EXPECT_TRUE(isEqual(_ekf->getVelocity(), _ekf_vec->getVelocity(), 0.05f));
+	EXPECT_TRUE(isEqual(_ekf->getPosition(), _ekf_vec->getPosition(), 0.1f));
+}
@@ -60,6 +60,11 @@ GyroFFT::~GyroFFT()
 	perf_free(_gyro_generation_gap_perf);
 	perf_free(_gyro_fifo_generation_gap_perf);
 
+	FreeBuffers();
+}
+
+void GyroFFT::FreeBuffers()
+{
 	delete[] _gyro_data_buffer_x;
 	delete[] _gyro_data_buffer_y;
 	delete[] _gyro_data_buffer_z;
@@ -67,12 +72,60 @@ GyroFFT::~GyroFFT()
 	delete[] _fft_input_buffer;
 	delete[] _fft_outupt_buffer;
 	delete[] _peak_magnitudes_all;
+
+	_gyro_data_buffer_x = nullptr;
+	_gyro_data_buffer_y = nullptr;
+	_gyro_data_buffer_z = nullptr;
+	_hanning_window = nullptr;
+	_fft_input_buffer = nullptr;
+	_fft_outupt_buffer = nullptr;
+	_peak_magnitudes_all = nullptr;
+
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+	delete[] _welch_power;
+	_welch_power = nullptr;
+#endif // CONFIG_GYRO_FFT_FLOAT32
 }
 
 bool GyroFFT::init()
 {
 	bool buffers_allocated = false;
 
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+
+	switch (_param_imu_gyro_fft_len.get()) {
+	case 256:
+		buffers_allocated = AllocateBuffers<256>();
+		break;
+
+	case 512:
+		buffers_allocated = AllocateBuffers<512>();
+		break;
+
+	case 1024:
+		buffers_allocated = AllocateBuffers<1024>();
+		break;
+
+	case 2048:
+		buffers_allocated = AllocateBuffers<2048>();
+		break;
+
+	case 4096:
+		buffers_allocated = AllocateBuffers<4096>();
+		break;
+
+	default:
+		// otherwise default to 256
+		PX4_ERR("Invalid IMU_GYRO_FFT_LEN=%" PRId32 ", resetting", _param_imu_gyro_fft_len.get());
+		buffers_allocated = AllocateBuffers<256>();
+		_param_imu_gyro_fft_len.set(256);
+		_param_imu_gyro_fft_len.commit();
+		break;
+	}
+
+	buffers_allocated = buffers_allocated && _rfft.init(_param_imu_gyro_fft_len.get());
+
+#else
 	// arm_rfft_init_q15(&_rfft_q15, _imu_gyro_fft_len, 0, 1) manually inlined to save flash
 	_rfft_q15.pTwiddleAReal = (q15_t *) realCoefAQ15;
 	_rfft_q15.pTwiddleBReal = (q15_t *) realCoefBQ15;
@@ -138,13 +191,20 @@ bool GyroFFT::init()
 		break;
 	}
 
+#endif // CONFIG_GYRO_FFT_FLOAT32
+
 	if (buffers_allocated) {
 		_imu_gyro_fft_len = _param_imu_gyro_fft_len.get();
 
 		// init Hanning window
 		for (int n = 0; n < _imu_gyro_fft_len; n++) {
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+			// periodic window, required by the sub-bin peak interpolation
+			_hanning_window[n] = 0.5f * (1.f - cosf(2.f * M_PI_F * n / _imu_gyro_fft_len));
+#else
 			const float hanning_value = 0.5f * (1.f - cosf(2.f * M_PI_F * n / (_imu_gyro_fft_len - 1)));
 			arm_float_to_q15(&hanning_value, &_hanning_window[n], 1);
+#endif // CONFIG_GYRO_FFT_FLOAT32
 		}
 
 		if (!SensorSelectionUpdate(true)) {
@@ -155,12 +215,7 @@ bool GyroFFT::init()
 	}
 
 	PX4_ERR("failed to allocate buffers");
-	delete[] _gyro_data_buffer_x;
-	delete[] _gyro_data_buffer_y;
-	delete[] _gyro_data_buffer_z;
-	delete[] _hanning_window;
-	delete[] _fft_input_buffer;
-	delete[] _fft_outupt_buffer;
+	FreeBuffers();
 
 	return false;
 }
@@ -266,7 +321,8 @@ static inline float tau(float x)
 	return (0.25f * p1 - sqrtf(6.f) / 24.f * p2);
 }
 
-float GyroFFT::EstimatePeakFrequencyBin(q15_t fft[], int peak_index)
+#if !defined(CONFIG_GYRO_FFT_FLOAT32)
+float GyroFFT::EstimatePeakFrequencyBin(fft_sample_t fft[], int peak_index)
 {
 	if (peak_index >= 2) {
 		// find peak location using Quinn's Second Estimator (2020-06-14: http://dspguru.com/dsp/howtos/how-to-interpolate-fft-peak/)
@@ -298,6 +354,7 @@ float GyroFFT::EstimatePeakFrequencyBin(q15_t fft[], int peak_index)
 
 	return NAN;
 }
+#endif // !CONFIG_GYRO_FFT_FLOAT32
 
 void GyroFFT::Run()
 {
@@ -394,15 +451,19 @@ void GyroFFT::Run()
 
 void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N)
 {
-	q15_t *gyro_data_buffer[] {_gyro_data_buffer_x, _gyro_data_buffer_y, _gyro_data_buffer_z};
+	fft_sample_t *gyro_data_buffer[] {_gyro_data_buffer_x, _gyro_data_buffer_y, _gyro_data_buffer_z};
 
 	for (int axis = 0; axis < 3; axis++) {
 		int &buffer_index = _fft_buffer_index[axis];
 
 		for (int n = 0; n < N; n++) {
 			if (buffer_index < _imu_gyro_fft_len) {
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+				gyro_data_buffer[axis][buffer_index] = input[axis][n];
+#else
 				// convert int16_t -> q15_t (scaling isn't relevant)
 				gyro_data_buffer[axis][buffer_index] = input[axis][n] / 2;
+#endif // CONFIG_GYRO_FFT_FLOAT32
 				buffer_index++;
 			}
 
@@ -410,8 +471,17 @@ void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint
 			if ((buffer_index >= _imu_gyro_fft_len) && !_fft_updated) {
 				perf_begin(_fft_perf);
 
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+
+				for (int i = 0; i < _imu_gyro_fft_len; i++) {
+					_fft_input_buffer[i] = gyro_data_buffer[axis][i] * _hanning_window[i];
+				}
+
+				_rfft.transform(_fft_input_buffer, _fft_outupt_buffer);
+#else
 				arm_mult_q15(gyro_data_buffer[axis], _hanning_window, _fft_input_buffer, _imu_gyro_fft_len);
 				arm_rfft_q15(&_rfft_q15, _fft_input_buffer, _fft_outupt_buffer);
+#endif // CONFIG_GYRO_FFT_FLOAT32
 
 				_fft_updated = true;
 
@@ -420,7 +490,7 @@ void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint
 				// reset
 				// shift buffer (3/4 overlap)
 				const int overlap_start = _imu_gyro_fft_len / 4;
-				memmove(&gyro_data_buffer[axis][0], &gyro_data_buffer[axis][overlap_start], sizeof(q15_t) * overlap_start * 3);
+				memmove(&gyro_data_buffer[axis][0], &gyro_data_buffer[axis][overlap_start], sizeof(fft_sample_t) * overlap_start * 3);
 				buffer_index = overlap_start * 3;
 
 				perf_end(_fft_perf);
@@ -429,13 +499,49 @@ void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint
 	}
 }
 
-void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *fft_outupt_buffer)
+void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, fft_sample_t *fft_outupt_buffer)
 {
 	const float resolution_hz = _gyro_sample_rate_hz / _imu_gyro_fft_len;
 
 	// sum total energy across all used buckets for SNR
 	float bin_mag_sum = 0;
 
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+	// Welch's method: average the power spectra of the last WELCH_SEGMENTS (3/4 overlapping) windows
+	const int num_bins = _imu_gyro_fft_len / 2;
+	float *welch_power_axis = &_welch_power[axis * WELCH_SEGMENTS * num_bins];
+	float *welch_power_segment = &welch_power_axis[_welch_segment[axis] * num_bins];
+
+	// FFT output buffer is ordered [real[0], real[N/2], real[1], imag[1], ... real[(N/2)-1], imag[(N/2)-1]
+	for (int bin_index = 1; bin_index < num_bins; bin_index++) {
+		const float real = fft_outupt_buffer[2 * bin_index];
+		const float imag = fft_outupt_buffer[2 * bin_index + 1];
+		welch_power_segment[bin_index] = real * real + imag * imag;
+	}
+
+	_welch_segment[axis] = (_welch_segment[axis] + 1) % WELCH_SEGMENTS;
+
+	if (_welch_segment_count[axis] < WELCH_SEGMENTS) {
+		_welch_segment_count[axis]++;
+	}
+
+	const int segment_count = _welch_segment_count[axis];
+
+	for (int bin_index = 1; bin_index < num_bins; bin_index++) {
+		float power_sum = 0.f;
+
+		for (int segment = 0; segment < segment_count; segment++) {
+			power_sum += welch_power_axis[segment * num_bins + bin_index];
+		}
+
+		const float fft_magnitude = sqrtf(power_sum / segment_count);
+
+		_peak_magnitudes_all[bin_index] = fft_magnitude;
+		bin_mag_sum += fft_magnitude;
+	}
+
+#else
+
 	// FFT output buffer is ordered [real[0], imag[0], real[1], imag[1], real[2], imag[2] ... real[(N/2)-1], imag[(N/2)-1]
 	for (uint16_t fft_index = 2; fft_index < _imu_gyro_fft_len; fft_index += 2) {
 
@@ -450,10 +556,15 @@ void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *ff
 		bin_mag_sum += fft_magnitude;
 	}
 
+#endif // CONFIG_GYRO_FFT_FLOAT32
 
 	// find raw peaks
 	uint16_t raw_peak_index[MAX_NUM_PEAKS] {};
 	float peak_magnitude[MAX_NUM_PEAKS] {};
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+	float peak_magnitude_left[MAX_NUM_PEAKS] {};
+	float peak_magnitude_right[MAX_NUM_PEAKS] {};
+#endif // CONFIG_GYRO_FFT_FLOAT32
 
 	for (int i = 0; i < MAX_NUM_PEAKS; i++) {
 
@@ -476,6 +587,10 @@ void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *ff
 		if (largest_peak_index > 1) {
 			raw_peak_index[i] = largest_peak_index;
 			peak_magnitude[i] = _peak_magnitudes_all[largest_peak_index];
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+			peak_magnitude_left[i] = _peak_magnitudes_all[largest_peak_index - 1];
+			peak_magnitude_right[i] = _peak_magnitudes_all[largest_peak_index + 1];
+#endif // CONFIG_GYRO_FFT_FLOAT32
 
 			// remove peak + sides (included in frequency estimate later)
 			_peak_magnitudes_all[largest_peak_index - 1] = 0;
@@ -504,7 +619,12 @@ void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *ff
 	for (int peak_new = 0; peak_new < MAX_NUM_PEAKS; peak_new++) {
 		if (raw_peak_index[peak_new] > 0) {
 
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+			const float adjusted_bin = raw_peak_index[peak_new] + RealFFT::hannPeakOffset(peak_magnitude_left[peak_new],
+						   peak_magnitude[peak_new], peak_magnitude_right[peak_new]);
+#else
 			const float adjusted_bin = 0.5f * EstimatePeakFrequencyBin(fft_outupt_buffer, 2 * raw_peak_index[peak_new]);
+#endif // CONFIG_GYRO_FFT_FLOAT32
 
 			if (PX4_ISFINITE(adjusted_bin)) {
 				const float freq_adjusted = resolution_hz * adjusted_bin;
@@ -703,6 +823,11 @@ int GyroFFT::task_spawn(int argc, char *argv[])
 int GyroFFT::print_status()
 {
 	PX4_INFO("gyro sample rate: %.3f Hz", (double)_gyro_sample_rate_hz);
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+	PX4_INFO("FFT: float32, length: %" PRId32 ", Welch segments: %d", _imu_gyro_fft_len, WELCH_SEGMENTS);
+#else
+	PX4_INFO("FFT: q15, length: %" PRId32, _imu_gyro_fft_len);
+#endif // CONFIG_GYRO_FFT_FLOAT32
 	perf_print_counter(_cycle_perf);
 	perf_print_counter(_cycle_interval_perf);
 	perf_print_counter(_fft_perf);
@@ -53,8 +53,14 @@
 #include <uORB/topics/sensor_selection.h>
 #include <uORB/topics/vehicle_imu_status.h>
 
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+#include "RealFFT.hpp"
+typedef float fft_sample_t;
+#else
 #include "arm_math.h"
 #include "arm_const_structs.h"
+typedef q15_t fft_sample_t;
+#endif // CONFIG_GYRO_FFT_FLOAT32
 
 using namespace time_literals;
 
@@ -84,9 +90,16 @@ private:
 	static constexpr int MAX_NUM_PEAKS = sizeof(sensor_gyro_fft_s::peak_frequencies_x) / sizeof(
 			sensor_gyro_fft_s::peak_frequencies_x[0]);
 
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+	// number of overlapping windows averaged per spectrum (Welch's method)
+	static constexpr int WELCH_SEGMENTS = 4;
+#endif // CONFIG_GYRO_FFT_FLOAT32
+
 	void Run() override;
-	inline void FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *fft_outupt_buffer);
-	inline float EstimatePeakFrequencyBin(q15_t fft[], int peak_index);
+	inline void FindPeaks(const hrt_abstime &timestamp_sample, int axis, fft_sample_t *fft_outupt_buffer);
+#if !defined(CONFIG_GYRO_FFT_FLOAT32)
+	inline float EstimatePeakFrequencyBin(fft_sample_t fft[], int peak_index);
+#endif // !CONFIG_GYRO_FFT_FLOAT32
 	inline void Publish();
 	bool SensorSelectionUpdate(bool force = false);
 	void Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N);
@@ -97,21 +110,31 @@ private:
 	template<size_t N>
 	bool AllocateBuffers()
 	{
-		_gyro_data_buffer_x = new q15_t[N];
-		_gyro_data_buffer_y = new q15_t[N];
-		_gyro_data_buffer_z = new q15_t[N];
-		_hanning_window = new q15_t[N];
-		_fft_input_buffer = new q15_t[N];
-		_fft_outupt_buffer = new q15_t[N * 2];
+		_gyro_data_buffer_x = new fft_sample_t[N];
+		_gyro_data_buffer_y = new fft_sample_t[N];
+		_gyro_data_buffer_z = new fft_sample_t[N];
+		_hanning_window = new fft_sample_t[N];
+		_fft_input_buffer = new fft_sample_t[N];
+		_fft_outupt_buffer = new fft_sample_t[N * 2];
+
+		_peak_magnitudes_all = new float[N] {};
 
-		_peak_magnitudes_all = new float[N];
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+		_welch_power = new float[3 * WELCH_SEGMENTS * (N / 2)];
+#endif // CONFIG_GYRO_FFT_FLOAT32
 
 		return (_gyro_data_buffer_x && _gyro_data_buffer_y && _gyro_data_buffer_z
 			&& _hanning_window
 			&& _fft_input_buffer
-			&& _fft_outupt_buffer);
+			&& _fft_outupt_buffer
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+			&& _welch_power
+#endif // CONFIG_GYRO_FFT_FLOAT32
+		       );
 	}
 
+	void FreeBuffers();
+
 	uORB::Publication<sensor_gyro_fft_s> _sensor_gyro_fft_pub{ORB_ID(sensor_gyro_fft)};
 
 	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
@@ -132,14 +155,23 @@ private:
 
 	bool _gyro_fifo{false};
 
-	arm_rfft_instance_q15 _rfft_q15;
+#if defined(CONFIG_GYRO_FFT_FLOAT32)
+	RealFFT _rfft;
 
-	q15_t *_gyro_data_buffer_x{nullptr};
-	q15_t *_gyro_data_buffer_y{nullptr};
-	q15_t *_gyro_data_buffer_z{nullptr};
-	q15_t *_hanning_window{nullptr};
-	q15_t *_fft_input_buffer{nullptr};
-	q15_t *_fft_outupt_buffer{nullptr};
+	// power spectra of the last WELCH_SEGMENTS windows per axis, [axis][segment][bin]
+	float *_welch_power{nullptr};
+	int _welch_segment[3] {};
+	int _welch_segment_count[3] {};
+#else
+	arm_rfft_instance_q15 _rfft_q15;
+#endif // CONFIG_GYRO_FFT_FLOAT32
+
+	fft_sample_t *_gyro_data_buffer_x{nullptr};
+	fft_sample_t *_gyro_data_buffer_y{nullptr};
+	fft_sample_t *_gyro_data_buffer_z{nullptr};
+	fft_sample_t *_hanning_window{nullptr};
+	fft_sample_t *_fft_input_buffer{nullptr};
+	fft_sample_t *_fft_outupt_buffer{nullptr};
 
 	float *_peak_magnitudes_all{nullptr};
 
@@ -0,0 +1,182 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "RealFFT.hpp"
+
+#include <math.h>
+
+RealFFT::~RealFFT()
+{
+	release();
+}
+
+void RealFFT::release()
+{
+	delete[] _twiddle;
+	delete[] _bit_reverse;
+	delete[] _work;
+
+	_twiddle = nullptr;
+	_bit_reverse = nullptr;
+	_work = nullptr;
+	_length = 0;
+}
+
+bool RealFFT::init(int length)
+{
+	release();
+
+	if ((length < MIN_LENGTH) || (length > MAX_LENGTH) || ((length & (length - 1)) != 0)) {
+		return false;
+	}
+
+	const int half = length / 2;
+
+	_twiddle = new float[length];
+	_bit_reverse = new uint16_t[half];
+	_work = new float[length];
+
+	if (!_twiddle || !_bit_reverse || !_work) {
+		release();
+		return false;
+	}
+
+	for (int k = 0; k < half; k++) {
+		const double angle = 2.0 * M_PI * k / length;
+		_twiddle[2 * k] = (float)cos(angle);
+		_twiddle[2 * k + 1] = (float)sin(angle);
+	}
+
+	int bits = 0;
+
+	while ((1 << bits) < half) {
+		bits++;
+	}
+
+	for (int n = 0; n < half; n++) {
+		int reversed = 0;
+
+		for (int b = 0; b < bits; b++) {
+			reversed |= ((n >> b) & 1) << (bits - 1 - b);
+		}
+
+		_bit_reverse[n] = reversed;
+	}
+
+	_length = length;
+	return true;
+}
+
+void RealFFT::transform(const float *input, float *output)
+{
+	const int half = _length / 2;
+
+	// pack the even samples as real and the odd samples as imaginary part of a N/2 point complex sequence,
+	// stored in bit reversed order for the in-place radix-2 FFT below
+	for (int n = 0; n < half; n++) {
+		const int r = _bit_reverse[n];
+		_work[2 * r] = input[2 * n];
+		_work[2 * r + 1] = input[2 * n + 1];
+	}
+
+	// radix-2 decimation in time, W_m^j = W_N^(j * N / m)
+	for (int m = 2; m <= half; m *= 2) {
+		const int twiddle_step = 2 * (_length / m);
+
+		for (int k = 0; k < half; k += m) {
+			float *a = &_work[2 * k];
+			float *b = &_work[2 * (k + m / 2)];
+
+			for (int j = 0; j < m / 2; j++) {
+				const float wr = _twiddle[j * twiddle_step];
+				const float wi = _twiddle[j * twiddle_step + 1];
+
+				// t = b * exp(-i angle)
+				const float tr = wr * b[2 * j] + wi * b[2 * j + 1];
+				const float ti = wr * b[2 * j + 1] - wi * b[2 * j];
+
+				b[2 * j] = a[2 * j] - tr;
+				b[2 * j + 1] = a[2 * j + 1] - ti;
+				a[2 * j] += tr;
+				a[2 * j + 1] += ti;
+			}
+		}
+	}
+
+	// split into the spectrum of the real sequence:
+	//  X[k] = E[k] + W_N^k O[k], E[k] = (Z[k] + Z*[N/2-k]) / 2, O[k] = (Z[k] - Z*[N/2-k]) / 2i
+	output[0] = _work[0] + _work[1];
+	output[1] = _work[0] - _work[1];
+
+	for (int k = 1; k < half; k++) {
+		const float zr = _work[2 * k];
+		const float zi = _work[2 * k + 1];
+		const float cr = _work[2 * (half - k)];
+		const float ci = -_work[2 * (half - k) + 1];
+
+		const float even_r = 0.5f * (zr + cr);
+		const float even_i = 0.5f * (zi + ci);
+		const float odd_r = 0.5f * (zi - ci);
+		const float odd_i = -0.5f * (zr - cr);
+
+		const float wr = _twiddle[2 * k];
+		const float wi = _twiddle[2 * k + 1];
+
+		output[2 * k] = even_r + wr * odd_r + wi * odd_i;
+		output[2 * k + 1] = even_i + wr * odd_i - wi * odd_r;
+	}
+}
+
+float RealFFT::hannPeakOffset(float magnitude_left, float magnitude_peak, float magnitude_right)
+{
+	if (!(magnitude_peak > 0.f) || !(fmaxf(magnitude_left, magnitude_right) > 0.f)) {
+		return 0.f;
+	}
+
+	// Grandke: for a Hann window the magnitude ratio of the larger neighbour to the peak bin is
+	// alpha = (1 + d) / (2 - d), with d the offset of the tone towards that neighbour
+	float offset;
+
+	if (magnitude_right > magnitude_left) {
+		const float alpha = magnitude_right / magnitude_peak;
+		offset = (2.f * alpha - 1.f) / (alpha + 1.f);
+
+	} else {
+		const float alpha = magnitude_left / magnitude_peak;
+		offset = -(2.f * alpha - 1.f) / (alpha + 1.f);
+	}
+
+	// a larger neighbour (peak at the edge of the search range) isn't a local maximum, limit to one bin
+	return fminf(fmaxf(offset, -1.f), 1.f);
+}
@@ -0,0 +1,98 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file RealFFT.hpp
+ *
+ * Float32 real-input FFT (power of two lengths) used by GyroFFT on targets
+ * without the CMSIS Q15 backend. The twiddle factors and the bit reversal
+ * table are computed at init, so no length dependent tables are kept in flash.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class RealFFT
+{
+public:
+	static constexpr int MIN_LENGTH = 8;
+	static constexpr int MAX_LENGTH = 8192;
+
+	RealFFT() = default;
+	~RealFFT();
+
+	RealFFT(const RealFFT &) = delete;
+	RealFFT &operator=(const RealFFT &) = delete;
+
+	/**
+	 * Allocate the tables for a given transform length.
+	 * @param length power of two in [MIN_LENGTH, MAX_LENGTH]
+	 * @return true on success
+	 */
+	bool init(int length);
+
+	int length() const { return _length; }
+
+	/**
+	 * Forward transform of length() real samples.
+	 *
+	 * The output has the same layout as arm_rfft_fast_f32(): length() floats ordered
+	 * [real[0], real[N/2], real[1], imag[1], ..., real[(N/2)-1], imag[(N/2)-1]],
+	 * i.e. the purely real DC and Nyquist bins share the first complex entry.
+	 *
+	 * @param input length() samples, not modified
+	 * @param output length() floats
+	 */
+	void transform(const float *input, float *output);
+
+	/**
+	 * Sub-bin location of a spectral peak of a periodic Hann windowed input.
+	 * Exact for a single tone, also valid for averaged (Welch) magnitude spectra.
+	 * @param magnitude_left magnitude of the bin below the peak
+	 * @param magnitude_peak magnitude of the peak bin
+	 * @param magnitude_right magnitude of the bin above the peak
+	 * @return offset of the peak from the peak bin in bins, in [-0.5, 0.5] for a tone, limited to [-1, 1]
+	 */
+	static float hannPeakOffset(float magnitude_left, float magnitude_peak, float magnitude_right);
+
+private:
+	void release();
+
+	int _length{0};
+
+	float *_twiddle{nullptr};    ///< cos/sin(2 pi k / N) pairs, k in [0, N/2)
+	uint16_t *_bit_reverse{nullptr}; ///< bit reversal permutation of the N/2 point complex FFT
+	float *_work{nullptr};       ///< N/2 point complex FFT buffer
+};
@@ -0,0 +1,176 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the float32 real FFT used by GyroFFT
+ * Run this test only using make tests TESTFILTER=RealFFT
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "RealFFT.hpp"
+
+static std::vector<float> randomSignal(int length)
+{
+	std::mt19937 generator(length);
+	std::normal_distribution<float> distribution(0.f, 1000.f);
+	std::vector<float> signal(length);
+
+	for (float &x : signal) {
+		x = distribution(generator);
+	}
+
+	return signal;
+}
+
+TEST(RealFFTTest, InvalidLength)
+{
+	RealFFT fft;
+	EXPECT_FALSE(fft.init(0));
+	EXPECT_FALSE(fft.init(100));
+	EXPECT_FALSE(fft.init(2 * RealFFT::MAX_LENGTH));
+	EXPECT_TRUE(fft.init(256));
+	EXPECT_EQ(fft.length(), 256);
+}
+
+TEST(RealFFTTest, MatchesDFT)
+{
+	for (int length = RealFFT::MIN_LENGTH; length <= 4096; length *= 2) {
+		RealFFT fft;
+		ASSERT_TRUE(fft.init(length));
+
+		const std::vector<float> input = randomSignal(length);
+		std::vector<float> output(length);
+		fft.transform(input.data(), output.data());
+
+		// reference DFT in double precision
+		double max_abs = 0.;
+		double max_error = 0.;
+
+		for (int k = 0; k <= length / 2; k++) {
+			double real = 0.;
+			double imag = 0.;
+
+			for (int n = 0; n < length; n++) {
+				const double angle = 2. * M_PI * (double)((long)k * n % length) / length;
+				real += (double)input[n] * cos(angle);
+				imag -= (double)input[n] * sin(angle);
+			}
+
+			double fft_real;
+			double fft_imag;
+
+			if (k == 0) {
+				fft_real = output[0];
+				fft_imag = 0.;
+
+			} else if (k == length / 2) {
+				fft_real = output[1];
+				fft_imag = 0.;
+
+			} else {
+				fft_real = output[2 * k];
+				fft_imag = output[2 * k + 1];
+			}
+
+			max_abs = fmax(max_abs, hypot(real, imag));
+			max_error = fmax(max_error, hypot(real - fft_real, imag - fft_imag));
+		}
+
+		EXPECT_LT(max_error / max_abs, 1e-5) << "length " << length;
+	}
+}
+
+TEST(RealFFTTest, HannPeakInterpolation)
+{
+	static constexpr int length = 1024;
+
+	RealFFT fft;
+	ASSERT_TRUE(fft.init(length));
+
+	std::vector<float> input(length);
+	std::vector<float> output(length);
+
+	for (float bin : {100.f, 100.2f, 100.5f, 151.37f, 300.8f}) {
+		for (int n = 0; n < length; n++) {
+			const float hann = 0.5f * (1.f - cosf(2.f * (float)M_PI * n / length));
+			input[n] = hann * 1000.f * sinf(2.f * (float)M_PI * bin * n / length + 0.3f);
+		}
+
+		fft.transform(input.data(), output.data());
+
+		int peak = 1;
+
+		for (int k = 1; k < length / 2; k++) {
+			if (hypotf(output[2 * k], output[2 * k + 1]) > hypotf(output[2 * peak], output[2 * peak + 1])) {
+				peak = k;
+			}
+		}
+
+		const float offset = RealFFT::hannPeakOffset(hypotf(output[2 * (peak - 1)], output[2 * (peak - 1) + 1]),
+				     hypotf(output[2 * peak], output[2 * peak + 1]),
+				     hypotf(output[2 * (peak + 1)], output[2 * (peak + 1) + 1]));
+
+		EXPECT_NEAR(peak + offset, bin, 0.01f);
+	}
+}
+
+TEST(RealFFTTest, ProcessingTimePerWindow)
+{
+	for (int length = 256; length <= 4096; length *= 2) {
+		RealFFT fft;
+		ASSERT_TRUE(fft.init(length));
+
+		const std::vector<float> input = randomSignal(length);
+		std::vector<float> output(length);
+
+		static constexpr int iterations = 1000;
+		const auto start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < iterations; i++) {
+			fft.transform(input.data(), output.data());
+		}
+
+		const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+		printf("RealFFT length %4d: %.2f us per window\n", length, elapsed.count() / iterations);
+
+		EXPECT_TRUE(std::isfinite(output[2]));
+	}
+}
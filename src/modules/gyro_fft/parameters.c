@@ -65,9 +65,12 @@ PARAM_DEFINE_FLOAT(IMU_GYRO_FFT_MAX, 150.f);
 /**
 * IMU gyro FFT length.
 *
+* Lengths above 1024 are only available with the float32 FFT (default on Linux targets).
+*
 * @value 256 256
 * @value 512 512
 * @value 1024 1024
+* @value 2048 2048
 * @value 4096 4096
 * @unit Hz
 * @reboot_required true
@@ -101,6 +101,10 @@ void LoadMon::Run()
 
 	cpuload();
 
+#if defined(WORK_ITEM_PROFILING)
+	work_item_profile();
+#endif // WORK_ITEM_PROFILING
+
 #if defined(__PX4_NUTTX)
 
 	if (_param_sys_stck_en.get()) {
@@ -247,6 +251,43 @@ void LoadMon::cpuload()
 #endif
 }
 
+#if defined(WORK_ITEM_PROFILING)
+void LoadMon::work_item_profile()
+{
+	static constexpr int ITEMS_PER_CYCLE = work_item_profile_s::ORB_QUEUE_LENGTH;
+
+	for (int i = 0; i < ITEMS_PER_CYCLE; i++) {
+		px4::work_item_profile_t profile;
+
+		if (!px4::WorkQueueManagerItemProfile(_work_item_index, profile)) {
+			// wrap around
+			if (_work_item_index == 0) {
+				return;
+			}
+
+			_work_item_index = 0;
+			continue;
+		}
+
+		work_item_profile_s report{};
+		static_assert(sizeof(report.item_name) == sizeof(profile.item_name), "item_name size mismatch");
+		static_assert(sizeof(report.wq_name) == sizeof(profile.wq_name), "wq_name size mismatch");
+		memcpy(report.item_name, profile.item_name, sizeof(report.item_name));
+		memcpy(report.wq_name, profile.wq_name, sizeof(report.wq_name));
+
+		for (int k = 0; k < 3; k++) {
+			report.latency_us[k] = profile.latency_us[k];
+			report.runtime_us[k] = profile.runtime_us[k];
+		}
+
+		report.timestamp = hrt_absolute_time();
+		_work_item_profile_pub.publish(report);
+
+		_work_item_index++;
+	}
+}
+#endif // WORK_ITEM_PROFILING
+
 #if defined(__PX4_NUTTX)
 void LoadMon::stack_usage()
 {
@@ -47,6 +47,7 @@
 #include <uORB/Publication.hpp>
 #include <uORB/topics/cpuload.h>
 #include <uORB/topics/task_stack_info.h>
+#include <uORB/topics/work_item_profile.h>
 
 #if defined(__PX4_LINUX)
 #include <sys/times.h>
@@ -92,6 +93,15 @@ private:
 #endif
 	uORB::Publication<cpuload_s> _cpuload_pub {ORB_ID(cpuload)};
 
+#if defined(WORK_ITEM_PROFILING)
+	/** Publish the profiling statistics of the next few work items. */
+	void work_item_profile();
+
+	unsigned _work_item_index{0};
+
+	uORB::Publication<work_item_profile_s> _work_item_profile_pub{ORB_ID(work_item_profile)};
+#endif // WORK_ITEM_PROFILING
+
 #if defined(__PX4_LINUX)
 	FILE *_proc_fd = nullptr;
 	/* calculate usage directly from clock ticks on Linux */
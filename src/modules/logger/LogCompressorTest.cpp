@@ -0,0 +1,287 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Round trip tests of the log compressor: the blocks are decompressed with a reference
+ * LZ4 block decoder and compared with the input.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "log_compressor.h"
+#include "messages.h"
+
+using namespace px4::logger;
+
+// decode the LZ4 block format, returns false on malformed input
+static bool lz4Decompress(const uint8_t *src, size_t size, std::vector<uint8_t> &dst)
+{
+	size_t i = 0;
+
+	auto read_length = [&](size_t &length) {
+		uint8_t b;
+
+		do {
+			if (i >= size) {
+				return false;
+			}
+
+			b = src[i++];
+			length += b;
+		} while (b == 255);
+
+		return true;
+	};
+
+	while (i < size) {
+		const uint8_t token = src[i++];
+
+		size_t literal_length = token >> 4;
+
+		if (literal_length == 15 && !read_length(literal_length)) {
+			return false;
+		}
+
+		if (i + literal_length > size) {
+			return false;
+		}
+
+		dst.insert(dst.end(), src + i, src + i + literal_length);
+		i += literal_length;
+
+		if (i == size) {
+			// the last sequence has no match
+			return true;
+		}
+
+		if (i + 2 > size) {
+			return false;
+		}
+
+		const size_t offset = src[i] | (src[i + 1] << 8);
+		i += 2;
+
+		size_t match_length = token & 0xf;
+
+		if (match_length == 15 && !read_length(match_length)) {
+			return false;
+		}
+
+		match_length += 4;
+
+		if (offset == 0 || offset > dst.size()) {
+			return false;
+		}
+
+		// byte by byte, matches can overlap
+		for (size_t k = 0; k < match_length; k++) {
+			dst.push_back(dst[dst.size() - offset]);
+		}
+	}
+
+	return false;
+}
+
+// compress data as a stream of blocks and decompress it again
+static std::vector<uint8_t> roundTrip(LogCompressor &compressor, const std::vector<uint8_t> &data, size_t block_size)
+{
+	std::vector<uint8_t> output;
+	size_t offset = 0;
+
+	while (offset < data.size()) {
+		const size_t size = std::min(block_size, data.size() - offset);
+		const uint8_t *block;
+		const size_t block_len = compressor.compress_block(data.data() + offset, size, &block);
+
+		ulog_compressed_block_header_s header;
+		EXPECT_GE(block_len, sizeof(header));
+		memcpy(&header, block, sizeof(header));
+
+		EXPECT_EQ(memcmp(header.magic, "ULZB", 4), 0);
+		EXPECT_EQ(header.compressed_size + sizeof(header), block_len);
+		EXPECT_EQ(header.uncompressed_size, size);
+		EXPECT_EQ(header.uncompressed_offset, offset);
+		EXPECT_LE(header.compressed_size, size);
+
+		const uint8_t *block_data = block + sizeof(header);
+
+		if (header.type == ULOG_COMPRESSED_BLOCK_LZ4) {
+			std::vector<uint8_t> decompressed;
+			EXPECT_TRUE(lz4Decompress(block_data, header.compressed_size, decompressed));
+			EXPECT_EQ(decompressed.size(), size);
+			output.insert(output.end(), decompressed.begin(), decompressed.end());
+
+		} else {
+			EXPECT_EQ(header.type, ULOG_COMPRESSED_BLOCK_STORED);
+			EXPECT_EQ(header.compressed_size, size);
+			output.insert(output.end(), block_data, block_data + header.compressed_size);
+		}
+
+		compressor.commit_block();
+		offset += size;
+	}
+
+	EXPECT_EQ(compressor.total_in(), data.size());
+	return output;
+}
+
+TEST(LogCompressorTest, FileHeader)
+{
+	LogCompressor compressor;
+	ASSERT_TRUE(compressor.init());
+
+	const uint8_t *header_data;
+	ASSERT_EQ(compressor.file_header(&header_data), sizeof(ulog_compressed_file_header_s));
+
+	ulog_compressed_file_header_s header;
+	memcpy(&header, header_data, sizeof(header));
+	EXPECT_EQ(memcmp(header.magic, "ULogLZ4", 7), 0);
+	EXPECT_EQ(header.hdr_ver, 1);
+	EXPECT_EQ(header.block_size_max, LogCompressor::BLOCK_SIZE_MAX);
+}
+
+TEST(LogCompressorTest, FixedBuffers)
+{
+	LogCompressor compressor;
+	ASSERT_TRUE(compressor.init());
+
+	// constant data, compresses to long overlapping matches
+	std::vector<uint8_t> zeros(LogCompressor::BLOCK_SIZE_MAX, 0);
+	EXPECT_EQ(roundTrip(compressor, zeros, LogCompressor::BLOCK_SIZE_MAX), zeros);
+
+	const uint8_t *block;
+	EXPECT_LT(compressor.compress_block(zeros.data(), zeros.size(), &block), zeros.size() / 50);
+
+	// repeating message-like records with a counter
+	std::vector<uint8_t> records;
+
+	for (uint32_t i = 0; records.size() < 3 * LogCompressor::BLOCK_SIZE_MAX; i++) {
+		const uint8_t record[] = {'D', 40, 0, 3, 0, (uint8_t)i, (uint8_t)(i >> 8), 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde};
+		records.insert(records.end(), record, record + sizeof(record));
+	}
+
+	ASSERT_TRUE(compressor.init());
+	EXPECT_EQ(roundTrip(compressor, records, LogCompressor::BLOCK_SIZE_MAX), records);
+
+	// short inputs, down to below the minimum match distance from the end
+	for (size_t size = 0; size <= 32; size++) {
+		std::vector<uint8_t> small(size, 'a');
+		ASSERT_TRUE(compressor.init());
+		EXPECT_EQ(roundTrip(compressor, small, LogCompressor::BLOCK_SIZE_MAX), small);
+	}
+}
+
+TEST(LogCompressorTest, RandomBuffers)
+{
+	LogCompressor compressor;
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<int> byte(0, 255);
+
+	// incompressible data is stored
+	std::vector<uint8_t> noise(2 * LogCompressor::BLOCK_SIZE_MAX + 123);
+
+	for (uint8_t &b : noise) {
+		b = byte(gen);
+	}
+
+	ASSERT_TRUE(compressor.init());
+	EXPECT_EQ(roundTrip(compressor, noise, LogCompressor::BLOCK_SIZE_MAX), noise);
+
+	const uint8_t *block;
+	EXPECT_EQ(compressor.compress_block(noise.data(), LogCompressor::BLOCK_SIZE_MAX, &block),
+		  sizeof(ulog_compressed_block_header_s) + LogCompressor::BLOCK_SIZE_MAX);
+	EXPECT_EQ(block[4], ULOG_COMPRESSED_BLOCK_STORED);
+
+	// random mixes of literals and copies of earlier data, with various lengths and distances
+	for (int iteration = 0; iteration < 20; iteration++) {
+		std::vector<uint8_t> data;
+		std::uniform_int_distribution<size_t> length(1, 300);
+		std::uniform_int_distribution<int> alphabet(0, 1 + iteration % 8);
+
+		while (data.size() < 4 * LogCompressor::BLOCK_SIZE_MAX) {
+			const size_t n = length(gen);
+
+			if (data.size() > 0 && byte(gen) < 128) {
+				std::uniform_int_distribution<size_t> distance(1, data.size());
+				const size_t start = data.size() - distance(gen);
+
+				for (size_t k = 0; k < n; k++) {
+					data.push_back(data[start + k]);
+				}
+
+			} else {
+				for (size_t k = 0; k < n; k++) {
+					data.push_back(alphabet(gen));
+				}
+			}
+		}
+
+		std::uniform_int_distribution<size_t> block_size(1, LogCompressor::BLOCK_SIZE_MAX);
+		ASSERT_TRUE(compressor.init());
+		EXPECT_EQ(roundTrip(compressor, data, block_size(gen)), data);
+	}
+}
+
+TEST(LogCompressorTest, RetryUncommittedBlock)
+{
+	LogCompressor compressor;
+	ASSERT_TRUE(compressor.init());
+
+	std::vector<uint8_t> data(3000);
+
+	for (size_t i = 0; i < data.size(); i++) {
+		data[i] = i % 7;
+	}
+
+	const uint8_t *block;
+	ulog_compressed_block_header_s header;
+
+	compressor.compress_block(data.data(), 1000, &block);
+	compressor.commit_block();
+
+	// a block that was not written (not committed) does not advance the stream offset
+	compressor.compress_block(data.data() + 1000, 1000, &block);
+	compressor.compress_block(data.data() + 1000, 1000, &block);
+	memcpy(&header, block, sizeof(header));
+	EXPECT_EQ(header.uncompressed_offset, 1000u);
+	EXPECT_EQ(compressor.total_in(), 1000u);
+
+	compressor.commit_block();
+	compressor.compress_block(data.data() + 2000, 1000, &block);
+	memcpy(&header, block, sizeof(header));
+	EXPECT_EQ(header.uncompressed_offset, 2000u);
+}
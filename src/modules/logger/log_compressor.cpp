@@ -0,0 +1,228 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "log_compressor.h"
+#include "messages.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace px4
+{
+namespace logger
+{
+
+constexpr size_t LogCompressor::BLOCK_SIZE_MAX;
+
+// LZ4 block format constants
+static constexpr size_t MIN_MATCH = 4;
+static constexpr size_t LAST_LITERALS = 5; ///< the last 5 bytes are always literals
+static constexpr size_t MF_LIMIT = 12; ///< a match must start at least 12 bytes before the end
+static constexpr size_t MAX_DISTANCE = 65535;
+
+static inline uint32_t read32(const uint8_t *p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint8_t *write_length(uint8_t *op, size_t length)
+{
+	while (length >= 255) {
+		*op++ = 255;
+		length -= 255;
+	}
+
+	*op++ = (uint8_t)length;
+	return op;
+}
+
+bool LogCompressor::init()
+{
+	if (!initialized()) {
+		_hash_table = (uint16_t *)malloc(sizeof(uint16_t) << HASH_BITS);
+		_output = (uint8_t *)malloc(sizeof(ulog_compressed_block_header_s) + max_compressed_size(BLOCK_SIZE_MAX));
+
+		if (_hash_table == nullptr || _output == nullptr) {
+			release();
+			return false;
+		}
+	}
+
+	_total_in = 0;
+	_block_in = 0;
+	return true;
+}
+
+void LogCompressor::release()
+{
+	free(_hash_table);
+	free(_output);
+	_hash_table = nullptr;
+	_output = nullptr;
+}
+
+size_t LogCompressor::file_header(const uint8_t **header)
+{
+	static const ulog_compressed_file_header_s file_header = {
+		.magic = {'U', 'L', 'o', 'g', 'L', 'Z', '4'},
+		.hdr_ver = 1,
+		.block_size_max = BLOCK_SIZE_MAX,
+	};
+
+	*header = (const uint8_t *)&file_header;
+	return sizeof(file_header);
+}
+
+size_t LogCompressor::compress_block(const uint8_t *data, size_t size, const uint8_t **block)
+{
+	ulog_compressed_block_header_s header{};
+	header.magic[0] = 'U';
+	header.magic[1] = 'L';
+	header.magic[2] = 'Z';
+	header.magic[3] = 'B';
+	header.uncompressed_size = size;
+	header.uncompressed_offset = _total_in;
+
+	uint8_t *block_data = _output + sizeof(header);
+	size_t compressed_size = compress_lz4(data, size, block_data);
+
+	if (compressed_size < size) {
+		header.type = ULOG_COMPRESSED_BLOCK_LZ4;
+
+	} else {
+		// incompressible data: store as is
+		header.type = ULOG_COMPRESSED_BLOCK_STORED;
+		memcpy(block_data, data, size);
+		compressed_size = size;
+	}
+
+	header.compressed_size = compressed_size;
+	memcpy(_output, &header, sizeof(header));
+
+	_block_in = size;
+
+	*block = _output;
+	return sizeof(header) + compressed_size;
+}
+
+size_t LogCompressor::compress_lz4(const uint8_t *src, size_t size, uint8_t *dst)
+{
+	uint8_t *op = dst;
+	size_t anchor = 0; ///< start of the pending literals
+
+	if (size > MF_LIMIT) {
+		memset(_hash_table, 0, sizeof(uint16_t) << HASH_BITS);
+
+		const size_t match_start_limit = size - MF_LIMIT;
+		const size_t match_end_limit = size - LAST_LITERALS;
+		size_t ip = 1;
+		unsigned misses = 0;
+
+		while (ip < match_start_limit) {
+			const uint32_t sequence = read32(src + ip);
+			const uint32_t h = (sequence * 2654435761u) >> (32 - HASH_BITS);
+			size_t ref = _hash_table[h];
+			_hash_table[h] = ip;
+
+			if (ref >= ip || ip - ref > MAX_DISTANCE || read32(src + ref) != sequence) {
+				// skip faster over incompressible data
+				ip += 1 + (misses++ >> 6);
+				continue;
+			}
+
+			misses = 0;
+
+			// extend the match backwards over the pending literals, then forwards
+			while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+				ip--;
+				ref--;
+			}
+
+			size_t match_length = MIN_MATCH;
+
+			while (ip + match_length < match_end_limit && src[ip + match_length] == src[ref + match_length]) {
+				match_length++;
+			}
+
+			// sequence: token, literal length, literals, offset, match length
+			const size_t literal_length = ip - anchor;
+			uint8_t *token = op++;
+			*token = (uint8_t)((literal_length >= 15 ? 15 : literal_length) << 4);
+
+			if (literal_length >= 15) {
+				op = write_length(op, literal_length - 15);
+			}
+
+			memcpy(op, src + anchor, literal_length);
+			op += literal_length;
+
+			const size_t offset = ip - ref;
+			*op++ = (uint8_t)offset;
+			*op++ = (uint8_t)(offset >> 8);
+
+			const size_t length_code = match_length - MIN_MATCH;
+			*token |= (uint8_t)(length_code >= 15 ? 15 : length_code);
+
+			if (length_code >= 15) {
+				op = write_length(op, length_code - 15);
+			}
+
+			ip += match_length;
+			anchor = ip;
+
+			if (ip < match_start_limit) {
+				// index the position just before the next search start to find repetitions faster
+				_hash_table[(read32(src + ip - 2) * 2654435761u) >> (32 - HASH_BITS)] = ip - 2;
+			}
+		}
+	}
+
+	// last literals
+	const size_t literal_length = size - anchor;
+	uint8_t *token = op++;
+	*token = (uint8_t)((literal_length >= 15 ? 15 : literal_length) << 4);
+
+	if (literal_length >= 15) {
+		op = write_length(op, literal_length - 15);
+	}
+
+	memcpy(op, src + anchor, literal_length);
+	op += literal_length;
+
+	return op - dst;
+}
+
+} // namespace logger
+} // namespace px4
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class LogCompressor
+ * Streaming compression of the ULog data into independent blocks (LZ4 block format), each preceded by
+ * a ulog_compressed_block_header_s. Since blocks don't reference each other, a reader can seek to any block
+ * using the block headers, and data after a corrupted block can still be recovered.
+ * The output can be converted back to a ULog file with Tools/decompress_ulog.py.
+ */
+class LogCompressor
+{
+public:
+	/** maximum uncompressed size of a block */
+	static constexpr size_t BLOCK_SIZE_MAX = 8192;
+
+	LogCompressor() = default;
+	~LogCompressor() { release(); }
+
+	LogCompressor(const LogCompressor &) = delete;
+	LogCompressor &operator=(const LogCompressor &) = delete;
+
+	/**
+	 * Allocate the working memory and reset the stream
+	 * @return false on allocation failure
+	 */
+	bool init();
+
+	/**
+	 * Free the working memory
+	 */
+	void release();
+
+	bool initialized() const { return _output != nullptr; }
+
+	/**
+	 * Get the file header, to be written before the first block
+	 * @return size of the header
+	 */
+	size_t file_header(const uint8_t **header);
+
+	/**
+	 * Compress the next chunk of the stream into a block. The stream offset only advances with commit_block(),
+	 * so a block that could not be written can be compressed again.
+	 * @param data input data
+	 * @param size input size, at most BLOCK_SIZE_MAX
+	 * @param block set to the block (header and data), valid until the next call
+	 * @return size of the block
+	 */
+	size_t compress_block(const uint8_t *data, size_t size, const uint8_t **block);
+
+	/**
+	 * Mark the last block returned by compress_block() as written, the next block follows it in the stream
+	 */
+	void commit_block() { _total_in += _block_in; _block_in = 0; }
+
+	/** total size of the input data of the committed blocks */
+	uint64_t total_in() const { return _total_in; }
+
+private:
+	static constexpr int HASH_BITS = 12;
+
+	/**
+	 * Compress into the LZ4 block format (greedy parsing with a single entry hash table)
+	 * @return compressed size, dst must have room for max_compressed_size(size)
+	 */
+	size_t compress_lz4(const uint8_t *src, size_t size, uint8_t *dst);
+
+	static constexpr size_t max_compressed_size(size_t size) { return size + size / 255 + 16; }
+
+	uint16_t *_hash_table{nullptr};
+	uint8_t *_output{nullptr}; ///< block header and compressed data
+	uint64_t _total_in{0};
+	size_t _block_in{0}; ///< input size of the last block, until committed
+};
+
+} // namespace logger
+} // namespace px4
@@ -180,6 +180,16 @@ int LogWriter::write_message(LogType type, void *ptr, size_t size, uint64_t drop
 	return ret_mavlink;
 }
 
+void LogWriter::commit_message(LogType type, uint8_t *ptr, size_t size)
+{
+	_log_writer_file_for_write->commit_message(type, size);
+
+	// the committed data stays valid while the lock is held, so it can be passed on directly
+	if (_log_writer_mavlink_for_write && type == LogType::Full) {
+		_log_writer_mavlink_for_write->write_message(ptr, size);
+	}
+}
+
 void LogWriter::select_write_backend(Backend sel_backend)
 {
 	if (sel_backend & BackendFile) {
@@ -94,6 +94,30 @@ public:
 	 */
 	int write_message(LogType type, void *ptr, size_t size, uint64_t dropout_start = 0);
 
+	/**
+	 * Reserve space for a single ulog message directly in the file write buffer, so that it can be filled
+	 * without an intermediate copy. The caller must hold the lock until commit_message() is called, and must not
+	 * write other messages in between. A reservation that is not committed is discarded.
+	 * @param size number of bytes to reserve. This can be larger than the size passed to commit_message().
+	 * @param dropout_start @see write_message()
+	 * @return pointer to the reserved bytes, or nullptr if reserving is not possible (e.g. no file backend, dropout,
+	 *         or the message would wrap around the end of the buffer). Use write_message() in that case.
+	 */
+	uint8_t *reserve_message(LogType type, size_t size, uint64_t dropout_start = 0)
+	{
+		if (_log_writer_file_for_write) { return _log_writer_file_for_write->reserve_message(type, size, dropout_start); }
+
+		return nullptr;
+	}
+
+	/**
+	 * Add a message that was filled via reserve_message() to the log. The message is also passed on to
+	 * the mavlink backend, if selected.
+	 * @param ptr pointer returned by reserve_message()
+	 * @param size actual message size (including header)
+	 */
+	void commit_message(LogType type, uint8_t *ptr, size_t size);
+
 	/**
 	 * Select a backend, so that future calls to write_message() only write to the selected
 	 * sel_backend, until unselect_write_backend() is called.
@@ -126,6 +150,31 @@ public:
 		return 0;
 	}
 
+	size_t get_total_file_size_file(LogType type) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_total_file_size(type); }
+
+		return 0;
+	}
+
+	/**
+	 * Enable or disable compression of the full log file
+	 * @return true if compression is enabled
+	 */
+	bool set_compression_file(bool enable)
+	{
+		if (_log_writer_file) { return _log_writer_file->set_compression(enable); }
+
+		return false;
+	}
+
+	bool compression_enabled_file() const
+	{
+		if (_log_writer_file) { return _log_writer_file->compression_enabled(); }
+
+		return false;
+	}
+
 	size_t get_buffer_size_file(LogType type) const
 	{
 		if (_log_writer_file) { return _log_writer_file->get_buffer_size(type); }
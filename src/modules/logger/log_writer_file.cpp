@@ -35,6 +35,7 @@
 #include "messages.h"
 
 #include <fcntl.h>
+#include <unistd.h>
 #include <string.h>
 #include <errno.h>
 
@@ -225,11 +226,12 @@ bool LogWriterFile::start_log(LogType type, const char *filename)
 
 	unlock();
 
-	if (type == LogType::Full) {
+	if (type == LogType::Full && !compression_enabled()) {
 		// register the current file with the hardfault handler: if the system crashes,
 		// the hardfault handler will append the crash log to that file on the next reboot.
 		// Note that we don't deregister it when closing the log, so that crashes after disarming
 		// are appended as well (the same holds for crashes before arming, which can be a bit misleading)
+		// This is not possible for compressed logs, as the handler patches the ULog header in place.
 		int ret = hardfault_store_filename(filename);
 
 		if (ret) {
@@ -248,6 +250,11 @@ bool LogWriterFile::start_log(LogType type, const char *filename)
 
 #endif
 
+	if (type == LogType::Full && compression_enabled()) {
+		_compressor.init(); // reset the stream
+		_compressed_file_header_pending = true;
+	}
+
 	if (_buffers[(int)type].start_log(filename)) {
 		PX4_INFO("Opened %s log file: %s", log_type_str(type), filename);
 		notify();
@@ -257,6 +264,66 @@ bool LogWriterFile::start_log(LogType type, const char *filename)
 	return false;
 }
 
+bool LogWriterFile::set_compression(bool enable)
+{
+	// only change it while the full log is not running, the compressor is used by the writer thread
+	lock();
+	const bool running = _buffers[(int)LogType::Full].fd() >= 0;
+	unlock();
+
+	if (!running) {
+		if (enable) {
+			if (!_compressor.init()) {
+				PX4_ERR("log compression alloc failed");
+			}
+
+		} else {
+			_compressor.release();
+		}
+	}
+
+	return compression_enabled();
+}
+
+int LogWriterFile::write_compressed(LogFileBuffer &buffer, const uint8_t *data, size_t size, bool call_fsync)
+{
+	if (_compressed_file_header_pending) {
+		const uint8_t *header;
+		const size_t header_size = _compressor.file_header(&header);
+
+		if (buffer.write_to_file(header, header_size, false) != (ssize_t)header_size) {
+			buffer.truncate_file();
+			return -1;
+		}
+
+		buffer.add_file_size(header_size);
+		_compressed_file_header_pending = false;
+	}
+
+	size_t consumed = 0;
+
+	while (consumed < size) {
+		const size_t block_input_size = math::min(size - consumed, LogCompressor::BLOCK_SIZE_MAX);
+		const uint8_t *block;
+		const size_t block_size = _compressor.compress_block(data + consumed, block_input_size, &block);
+
+		const bool last = consumed + block_input_size >= size;
+
+		if (buffer.write_to_file(block, block_size, call_fsync && last) != (ssize_t)block_size) {
+			// remove a partially written block, so that the file ends with the last complete block.
+			// The block is compressed again, at the same stream offset, when the data is retried.
+			buffer.truncate_file();
+			break;
+		}
+
+		buffer.add_file_size(block_size);
+		_compressor.commit_block();
+		consumed += block_input_size;
+	}
+
+	return consumed > 0 ? (int)consumed : -1;
+}
+
 int LogWriterFile::hardfault_store_filename(const char *log_file)
 {
 #if defined(__PX4_NUTTX) && defined(px4_savepanic)
@@ -429,13 +496,21 @@ void LogWriterFile::run()
 
 #endif
 
-					int written = buffer.write_to_file(read_ptr, available, call_fsync);
+					const bool compress = (i == (int)LogType::Full) && compression_enabled();
+
+					int written = compress ? write_compressed(buffer, (const uint8_t *)read_ptr, available, call_fsync)
+						      : buffer.write_to_file(read_ptr, available, call_fsync);
 
 					if (written < 0) {
 						// retry once
 						PX4_ERR("write failed errno:%i (%s), retrying", errno, strerror(errno));
 						px4_usleep(10000); // 10 milliseconds
-						written = buffer.write_to_file(read_ptr, available, call_fsync);
+						written = compress ? write_compressed(buffer, (const uint8_t *)read_ptr, available, call_fsync)
+							  : buffer.write_to_file(read_ptr, available, call_fsync);
+					}
+
+					if (written > 0 && !compress) {
+						buffer.add_file_size(written);
 					}
 
 					/* buffer.mark_read() requires _mtx to be locked */
@@ -547,6 +622,16 @@ int LogWriterFile::write_message(LogType type, void *ptr, size_t size, uint64_t
 	return write(type, ptr, size, dropout_start);
 }
 
+uint8_t *LogWriterFile::reserve_message(LogType type, size_t size, uint64_t dropout_start)
+{
+	// dropouts and reliable transfer are handled by write_message() only
+	if (!is_started(type) || dropout_start || _need_reliable_transfer) {
+		return nullptr;
+	}
+
+	return _buffers[(int)type].reserve(size);
+}
+
 int LogWriterFile::write(LogType type, void *ptr, size_t size, uint64_t dropout_start)
 {
 	if (!is_started(type)) {
@@ -674,6 +759,7 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 	_head = 0;
 	_count = 0;
 	_total_written = 0;
+	_total_file_size = 0;
 
 	_should_run = true;
 
@@ -700,6 +786,17 @@ ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t s
 	return ret;
 }
 
+void LogWriterFile::LogFileBuffer::truncate_file() const
+{
+	const int errno_write = errno;
+
+	if (ftruncate(_fd, _total_file_size) != 0 || lseek(_fd, _total_file_size, SEEK_SET) < 0) {
+		PX4_ERR("truncating log file failed (%i)", errno);
+	}
+
+	errno = errno_write; // keep the write error for reporting
+}
+
 void LogWriterFile::LogFileBuffer::close_file()
 {
 	if (_fd >= 0) {
@@ -709,7 +806,7 @@ void LogWriterFile::LogFileBuffer::close_file()
 			PX4_WARN("closing log file failed (%i)", errno);
 
 		} else {
-			PX4_INFO("closed logfile, bytes written: %zu", _total_written);
+			PX4_INFO("closed logfile, bytes written: %zu (on disk: %zu)", _total_written, _total_file_size);
 		}
 	}
 }
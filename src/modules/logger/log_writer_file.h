@@ -41,6 +41,8 @@
 #include <perf/perf_counter.h>
 #include <px4_platform_common/crypto.h>
 
+#include "log_compressor.h"
+
 namespace px4
 {
 namespace logger
@@ -88,6 +90,12 @@ public:
 	/** @see LogWriter::write_message() */
 	int write_message(LogType type, void *ptr, size_t size, uint64_t dropout_start = 0);
 
+	/** @see LogWriter::reserve_message() */
+	uint8_t *reserve_message(LogType type, size_t size, uint64_t dropout_start);
+
+	/** @see LogWriter::commit_message() */
+	void commit_message(LogType type, size_t size) { _buffers[(int)type].commit(size); }
+
 	void lock()
 	{
 		pthread_mutex_lock(&_mtx);
@@ -108,6 +116,14 @@ public:
 		return _buffers[(int)type].total_written();
 	}
 
+	/**
+	 * Number of bytes written to the file, which differs from get_total_written() if compression is enabled
+	 */
+	size_t get_total_file_size(LogType type) const
+	{
+		return _buffers[(int)type].total_file_size();
+	}
+
 	size_t get_buffer_size(LogType type) const
 	{
 		return _buffers[(int)type].buffer_size();
@@ -136,6 +152,14 @@ public:
 
 	pthread_t thread_id() const { return _thread; }
 
+	/**
+	 * Enable or disable compression of the full log (see LogCompressor). Takes effect with the next start_log().
+	 * @return true if compression is enabled
+	 */
+	bool set_compression(bool enable);
+
+	bool compression_enabled() const { return _compressor.initialized(); }
+
 #if defined(PX4_CRYPTO)
 	void set_encryption_parameters(px4_crypto_algorithm_t algorithm, uint8_t key_idx,  uint8_t exchange_key_idx)
 	{
@@ -186,6 +210,29 @@ private:
 		 */
 		inline void write_no_check(void *ptr, size_t size);
 
+		/**
+		 * Get a pointer to size contiguous bytes at the write position, which can be filled and then
+		 * added with commit().
+		 * @return nullptr if there is not enough space or the bytes would wrap around the end of the buffer
+		 */
+		uint8_t *reserve(size_t size)
+		{
+			if (size > available() || _head + size > _buffer_size) {
+				return nullptr;
+			}
+
+			return &_buffer[_head];
+		}
+
+		/**
+		 * Add size bytes previously filled via reserve() to the buffer
+		 */
+		void commit(size_t size)
+		{
+			_head = (_head + size) % _buffer_size;
+			_count += size;
+		}
+
 		size_t available() const { return _buffer_size - _count; }
 
 		int fd() const { return _fd; }
@@ -194,9 +241,17 @@ private:
 
 		inline void fsync() const;
 
+		/**
+		 * Truncate the file to the size added with add_file_size(), removing partially written data
+		 */
+		void truncate_file() const;
+
 		void mark_read(size_t n) { _count -= n; _total_written += n; }
 
+		void add_file_size(size_t n) { _total_file_size += n; }
+
 		size_t total_written() const { return _total_written; }
+		size_t total_file_size() const { return _total_file_size; }
 		size_t buffer_size() const { return _buffer_size; }
 		size_t count() const { return _count; }
 
@@ -209,18 +264,29 @@ private:
 		size_t _head = 0; ///< next position to write to
 		size_t _count = 0; ///< number of bytes in _buffer to be written
 		size_t _total_written = 0;
+		size_t _total_file_size = 0;
 		perf_counter_t _perf_write;
 		perf_counter_t _perf_fsync;
 	};
 
 	LogFileBuffer _buffers[(int)LogType::Count];
 
+	/**
+	 * Compress data from the buffer into blocks and write them to the file
+	 * @return number of bytes consumed from the buffer, or -1 if nothing could be written
+	 */
+	int write_compressed(LogFileBuffer &buffer, const uint8_t *data, size_t size, bool call_fsync);
+
 	px4::atomic_bool	_exit_thread{false};
 	bool			_need_reliable_transfer{false};
 	px4::atomic_bool	_want_fsync{false};
 	pthread_mutex_t		_mtx;
 	pthread_cond_t		_cv;
 	pthread_t _thread = 0;
+
+	LogCompressor		_compressor; ///< compression of the full log, used by the writer thread only
+	bool			_compressed_file_header_pending{false};
+
 #if defined(PX4_CRYPTO)
 	bool init_logfile_encryption(const char *filename);
 	PX4Crypto _crypto;
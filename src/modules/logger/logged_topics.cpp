@@ -43,6 +43,83 @@
 
 using namespace px4::logger;
 
+// topic name prefixes of the priority classes, all other topics are LogPriority::Normal
+static constexpr const char *critical_topics[] = {
+	"actuator_",
+	"airspeed", // estimator inputs, replay needs them at full rate
+	"aux_global_position",
+	"battery_status",
+	"distance_sensor",
+	"ekf2_timestamps",
+	"estimator_",
+	"failsafe_flags",
+	"failure_detector_status",
+	"sensor_combined",
+	"sensor_selection",
+	"vehicle_acceleration",
+	"vehicle_air_data",
+	"vehicle_angular_velocity",
+	"vehicle_attitude",
+	"vehicle_command",
+	"vehicle_control_mode",
+	"vehicle_global_position",
+	"vehicle_gps_position",
+	"vehicle_land_detected",
+	"vehicle_local_position",
+	"vehicle_magnetometer",
+	"vehicle_optical_flow",
+	"vehicle_rates_setpoint",
+	"vehicle_status",
+	"vehicle_thrust_setpoint",
+	"vehicle_torque_setpoint",
+	"vehicle_visual_odometry",
+};
+
+static constexpr const char *low_priority_topics[] = {
+	"can_interface_status",
+	"cellular_status",
+	"debug_",
+	"gps_dump",
+	"iridiumsbd_status",
+	"mag_worker_data",
+	"mavlink_tunnel",
+	"onboard_computer_status",
+	"rtl_time_estimate",
+	"satellite_info",
+	"sensor_accel", // raw and redundant sensor data (including the FIFO topics), sensor_combined is critical
+	"sensor_baro",
+	"sensor_gyro",
+	"sensor_mag",
+	"sensor_preflight_mag",
+	"transponder_report",
+	"work_item_profile",
+};
+
+template<size_t N>
+static bool matches_prefix(const char *name, const char *const (&prefixes)[N])
+{
+	for (size_t i = 0; i < N; ++i) {
+		if (strncmp(name, prefixes[i], strlen(prefixes[i])) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+LogPriority LoggedTopics::topic_priority(const char *name)
+{
+	if (matches_prefix(name, critical_topics)) {
+		return LogPriority::Critical;
+	}
+
+	if (matches_prefix(name, low_priority_topics)) {
+		return LogPriority::Low;
+	}
+
+	return LogPriority::Normal;
+}
+
 void LoggedTopics::add_default_topics()
 {
 	add_topic("action_request");
@@ -137,6 +214,7 @@ void LoggedTopics::add_default_topics()
 	add_topic("vehicle_status");
 	add_optional_topic("vtol_vehicle_status", 200);
 	add_topic("wind", 1000);
+	add_optional_topic("work_item_profile");
 
 	// multi topics
 	add_optional_topic_multi("actuator_outputs", 100, 3);
@@ -497,6 +575,7 @@ bool LoggedTopics::add_topic(const orb_metadata *topic, uint16_t interval_ms, ui
 	RequestedSubscription &sub = _subscriptions.sub[_subscriptions.count++];
 	sub.interval_ms = interval_ms;
 	sub.instance = instance;
+	sub.priority = topic_priority(topic->o_name);
 	sub.id = static_cast<ORB_ID>(topic->o_id);
 	return true;
 }
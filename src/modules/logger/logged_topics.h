@@ -63,6 +63,18 @@ enum class MissionLogType : int32_t {
 	Geotagging =             2
 };
 
+/**
+ * Priority class of a logged topic. When the write backlog grows, the logger
+ * increases the intervals of Normal and Low priority topics.
+ */
+enum class LogPriority : uint8_t {
+	Critical = 0, ///< always logged at the configured rate (estimator and its inputs, control, failsafe)
+	Normal,       ///< throttled under high load, topics without rate limit use a minimum interval
+	Low,          ///< throttled first and most
+
+	Count
+};
+
 inline bool operator&(SDLogProfileMask a, SDLogProfileMask b)
 {
 	return static_cast<int32_t>(a) & static_cast<int32_t>(b);
@@ -82,6 +94,7 @@ public:
 	struct RequestedSubscription {
 		uint16_t interval_ms;
 		uint8_t instance;
+		LogPriority priority{LogPriority::Normal};
 		ORB_ID id{ORB_ID::INVALID};
 	};
 	struct RequestedSubscriptionArray {
@@ -108,6 +121,12 @@ public:
 
 	void set_rate_factor(float rate_factor) { _rate_factor = rate_factor; }
 
+	/**
+	 * Get the priority class of a topic
+	 * @param name topic name
+	 */
+	static LogPriority topic_priority(const char *name);
+
 private:
 
 	/**
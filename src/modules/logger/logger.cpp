@@ -215,6 +215,9 @@ int Logger::print_status()
 
 	if (!is_logging) {
 		PX4_INFO("Not logging");
+
+	} else {
+		perf_print_counter(_lock_hold_perf);
 	}
 
 	return 0;
@@ -242,6 +245,16 @@ void Logger::print_statistics(LogType type)
 		PX4_INFO("Wrote %4.2f MiB (avg %5.2f KiB/s)", (double)mebibytes, (double)(kibibytes / seconds));
 	}
 
+	const size_t file_size = _writer.get_total_file_size_file(type);
+	PX4_INFO("On disk: %4.2f MiB (compression ratio: %.2f)", (double)(file_size / (1024.0f * 1024.0f)),
+		 (double)(file_size > 0 ? _writer.get_total_written_file(type) / (float)file_size : 1.f));
+
+	PX4_INFO("Dropouts since log start: %zu", stats.total_write_dropouts);
+
+	if (type == LogType::Full && _param_sdlog_load_shed.get()) {
+		PX4_INFO("Load shedding level: %i", _load_shedding_level);
+	}
+
 	PX4_INFO("Since last status: dropouts: %zu (max len: %.3f s), max used buffer: %zu / %zu B",
 		 stats.write_dropouts, (double)stats.max_dropout_duration, stats.high_water, _writer.get_buffer_size_file(type));
 	stats.high_water = 0;
@@ -416,6 +429,8 @@ Logger::~Logger()
 
 	delete[](_msg_buffer);
 	delete[](_subscriptions);
+
+	perf_free(_lock_hold_perf);
 }
 
 void Logger::update_params()
@@ -560,7 +575,7 @@ bool Logger::initialize_topics()
 
 		for (int i = 0; i < logged_topics.subscriptions().count; ++i) {
 			const LoggedTopics::RequestedSubscription &sub = logged_topics.subscriptions().sub[i];
-			_subscriptions[i] = LoggerSubscription(sub.id, sub.interval_ms, sub.instance);
+			_subscriptions[i] = LoggerSubscription(sub.id, sub.interval_ms, sub.instance, sub.priority);
 			_subscriptions[i].subscribe();
 		}
 	}
@@ -748,6 +763,7 @@ void Logger::run()
 
 			/* wait for lock on log buffer */
 			_writer.lock();
+			perf_begin(_lock_hold_perf);
 
 			for (int sub_idx = 0; sub_idx < _num_subscriptions; ++sub_idx) {
 				LoggerSubscription &sub = _subscriptions[sub_idx];
@@ -756,23 +772,43 @@ void Logger::run()
 				 */
 				const bool try_to_subscribe = (sub_idx == next_subscribe_topic_index);
 
-				if (copy_if_updated(sub_idx, _msg_buffer + sizeof(ulog_message_data_s), try_to_subscribe)) {
+				/* Copy the data directly into the write buffer if possible. Subscribing writes to the log
+				 * (add logged message), so in that case the message buffer is used.
+				 * orb_copy() writes o_size bytes, but only o_size_no_padding get logged.
+				 */
+				uint8_t *reserved = nullptr;
+
+				if (sub.valid()) {
+					reserved = _writer.reserve_message(LogType::Full, sizeof(ulog_message_data_s) + sub.get_topic()->o_size,
+									   _statistics[(int)LogType::Full].dropout_start);
+				}
+
+				uint8_t *const msg_buffer = reserved ? reserved : _msg_buffer;
+
+				if (copy_if_updated(sub_idx, msg_buffer + sizeof(ulog_message_data_s), try_to_subscribe)) {
 					// each message consists of a header followed by an orb data object
 					const size_t msg_size = sizeof(ulog_message_data_s) + sub.get_topic()->o_size_no_padding;
 					const uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
 					const uint16_t write_msg_id = sub.msg_id;
 
 					//write one byte after another (necessary because of alignment)
-					_msg_buffer[0] = (uint8_t)write_msg_size;
-					_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
-					_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
-					_msg_buffer[3] = (uint8_t)write_msg_id;
-					_msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
+					msg_buffer[0] = (uint8_t)write_msg_size;
+					msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+					msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
+					msg_buffer[3] = (uint8_t)write_msg_id;
+					msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
 
 					// PX4_INFO("topic: %s, size = %zu, out_size = %zu", sub.get_topic()->o_name, sub.get_topic()->o_size, msg_size);
 
 					// full log
-					if (write_message(LogType::Full, _msg_buffer, msg_size)) {
+					if (reserved) {
+						_writer.commit_message(LogType::Full, reserved, msg_size);
+
+#ifdef DBGPRINT
+						total_bytes += msg_size;
+#endif /* DBGPRINT */
+
+					} else if (write_message(LogType::Full, msg_buffer, msg_size)) {
 
 #ifdef DBGPRINT
 						total_bytes += msg_size;
@@ -789,7 +825,8 @@ void Logger::run()
 									_mission_subscriptions[sub_idx].next_write_time = (loop_time / 100000) + delta_time / 100;
 								}
 
-								write_message(LogType::Mission, _msg_buffer, msg_size);
+								// the full log data stays valid while holding the lock
+								write_message(LogType::Mission, msg_buffer, msg_size);
 							}
 						}
 					}
@@ -803,21 +840,7 @@ void Logger::run()
 			log_message_s log_message;
 
 			if (_log_message_sub.update(&log_message)) {
-				const char *message = (const char *)log_message.text;
-				int message_len = strlen(message);
-
-				if (message_len > 0) {
-					uint16_t write_msg_size = sizeof(ulog_message_logging_s) - sizeof(ulog_message_logging_s::message)
-								  - ULOG_MSG_HEADER_LEN + message_len;
-					_msg_buffer[0] = (uint8_t)write_msg_size;
-					_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
-					_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::LOGGING);
-					_msg_buffer[3] = log_message.severity + '0';
-					memcpy(_msg_buffer + 4, &log_message.timestamp, sizeof(ulog_message_logging_s::timestamp));
-					strncpy((char *)(_msg_buffer + 12), message, sizeof(ulog_message_logging_s::message));
-
-					write_message(LogType::Full, _msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN);
-				}
+				write_logging_message(log_message.severity, log_message.timestamp, (const char *)log_message.text);
 			}
 
 			// Add sync magic
@@ -841,6 +864,8 @@ void Logger::run()
 				_last_sync_time = loop_time;
 			}
 
+			update_load_shedding(loop_time);
+
 			// update buffer statistics
 			for (int i = 0; i < (int)LogType::Count; ++i) {
 				if (!_statistics[i].dropout_start && (_writer.get_buffer_fill_count_file((LogType)i) > _statistics[i].high_water)) {
@@ -851,6 +876,7 @@ void Logger::run()
 			publish_logger_status();
 
 			/* release the log buffer */
+			perf_end(_lock_hold_perf);
 			_writer.unlock();
 
 			/* notify the writer thread */
@@ -1085,6 +1111,110 @@ void Logger::adjust_subscription_updates()
 	}
 }
 
+void Logger::write_logging_message(uint8_t log_level, uint64_t timestamp, const char *message)
+{
+	int message_len = strlen(message);
+
+	if (message_len > 0) {
+		uint16_t write_msg_size = sizeof(ulog_message_logging_s) - sizeof(ulog_message_logging_s::message)
+					  - ULOG_MSG_HEADER_LEN + message_len;
+		_msg_buffer[0] = (uint8_t)write_msg_size;
+		_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+		_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::LOGGING);
+		_msg_buffer[3] = log_level + '0';
+		memcpy(_msg_buffer + 4, &timestamp, sizeof(ulog_message_logging_s::timestamp));
+		strncpy((char *)(_msg_buffer + 12), message, sizeof(ulog_message_logging_s::message));
+
+		write_message(LogType::Full, _msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN);
+	}
+}
+
+static constexpr int load_shedding_levels = 4;
+
+// interval multiplier per load shedding level and LogPriority
+static constexpr uint8_t load_shedding_factor[load_shedding_levels][(int)LogPriority::Count] = {
+	{1, 1, 1},
+	{1, 1, 4},
+	{1, 2, 10},
+	{1, 4, 20},
+};
+
+// buffer fill ratio at which a load shedding level is entered. A level is left again when the fill ratio
+// stays below the threshold minus the hysteresis for some time.
+static constexpr float load_shedding_threshold[load_shedding_levels] = {0.f, 0.4f, 0.6f, 0.8f};
+static constexpr float load_shedding_hysteresis{0.2f};
+static constexpr hrt_abstime load_shedding_decrease_delay{3_s};
+
+// interval used for shedding topics that are logged at full rate (no interval configured)
+static constexpr uint32_t load_shedding_min_interval_us{10_ms};
+
+void Logger::update_load_shedding(const hrt_abstime &now)
+{
+	if (!_param_sdlog_load_shed.get() || !_writer.is_started(LogType::Full, LogWriter::BackendFile)) {
+		return;
+	}
+
+	const float fill_ratio = (float)_writer.get_buffer_fill_count_file(LogType::Full) /
+				 _writer.get_buffer_size_file(LogType::Full);
+
+	int level = _load_shedding_level;
+
+	// increase immediately, decrease one level at a time once the backlog stayed low for a while
+	if (_statistics[(int)LogType::Full].dropout_start) {
+		level = load_shedding_levels - 1;
+	}
+
+	while (level < load_shedding_levels - 1 && fill_ratio >= load_shedding_threshold[level + 1]) {
+		++level;
+	}
+
+	if (level == _load_shedding_level && level > 0
+	    && fill_ratio < load_shedding_threshold[level] - load_shedding_hysteresis) {
+
+		if (_load_shedding_low_since == 0) {
+			_load_shedding_low_since = now;
+
+		} else if (now - _load_shedding_low_since > load_shedding_decrease_delay) {
+			--level;
+		}
+
+	} else {
+		_load_shedding_low_since = 0;
+	}
+
+	if (level != _load_shedding_level) {
+		set_load_shedding_level(level);
+		_load_shedding_low_since = 0;
+
+		char message[sizeof(ulog_message_logging_s::message)];
+		snprintf(message, sizeof(message),
+			 "logger: load shedding level %i (buffer %i%%): interval factor normal: %i, low priority: %i", level,
+			 (int)(fill_ratio * 100.f), load_shedding_factor[level][(int)LogPriority::Normal],
+			 load_shedding_factor[level][(int)LogPriority::Low]);
+		write_logging_message(level > 0 ? 4 : 6, now, message);
+	}
+}
+
+void Logger::set_load_shedding_level(int level)
+{
+	_load_shedding_level = level;
+
+	// the mission log topics are not throttled, since they share the subscription with the full log
+	for (int i = _num_mission_subs; i < _num_subscriptions; ++i) {
+		LoggerSubscription &sub = _subscriptions[i];
+		const uint32_t factor = load_shedding_factor[level][(int)sub.priority];
+		uint32_t interval_us = sub.base_interval_us;
+
+		if (factor > 1) {
+			// Topics without rate limit are throttled as well, they include high-rate sensor data.
+			// Event-based topics rarely publish faster than the resulting interval, so they are not affected.
+			interval_us = (interval_us > 0) ? interval_us * factor : load_shedding_min_interval_us * factor;
+		}
+
+		sub.set_interval_us(interval_us);
+	}
+}
+
 bool Logger::get_disable_boot_logging()
 {
 	if (_param_sdlog_boot_bat.get()) {
@@ -1217,6 +1347,7 @@ bool Logger::write_message(LogType type, void *ptr, size_t size)
 	if (!stats.dropout_start) {
 		stats.dropout_start = hrt_absolute_time();
 		++stats.write_dropouts;
+		++stats.total_write_dropouts;
 		stats.high_water = 0;
 	}
 
@@ -1300,15 +1431,19 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		replay_suffix = "_replayed";
 	}
 
-	const char *crypto_suffix = "";
+	const char *file_suffix = "";
 #if defined(PX4_CRYPTO)
 
 	if (_param_sdlog_crypto_algorithm.get() != 0) {
-		crypto_suffix = "c";
+		file_suffix = "c";
 	}
 
 #endif
 
+	if (type == LogType::Full && _writer.compression_enabled_file()) {
+		file_suffix = "z"; // compressed log, see Tools/decompress_ulog.py
+	}
+
 	char *log_file_name = _file_name[(int)type].log_file_name;
 
 	if (time_ok) {
@@ -1321,7 +1456,7 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		char log_file_name_time[16] = "";
 		strftime(log_file_name_time, sizeof(log_file_name_time), "%H_%M_%S", &tt);
 		snprintf(log_file_name, sizeof(LogFileName::log_file_name), "%s%s.ulg%s", log_file_name_time, replay_suffix,
-			 crypto_suffix);
+			 file_suffix);
 		snprintf(file_name + n, file_name_size - n, "/%s", log_file_name);
 
 		if (notify) {
@@ -1352,7 +1487,7 @@ int Logger::get_log_file_name(LogType type, char *file_name, size_t file_name_si
 		while (file_number <= MAX_NO_LOGFILE) {
 			/* format log file path: e.g. /fs/microsd/log/sess001/log001.ulg */
 			snprintf(log_file_name, sizeof(LogFileName::log_file_name), "log%03" PRIu16 "%s.ulg%s", file_number, replay_suffix,
-				 crypto_suffix);
+				 file_suffix);
 			snprintf(file_name + n, file_name_size - n, "/%s", log_file_name);
 
 			if (!util::file_exist(file_name)) {
@@ -1403,6 +1538,24 @@ void Logger::start_log_file(LogType type)
 
 	PX4_INFO("Start file log (type: %s)", log_type_str(type));
 	_statistics[(int) type].start_time_file = 0;
+	_statistics[(int) type].total_write_dropouts = 0;
+
+	if (type == LogType::Full) {
+		bool compress = _param_sdlog_compress.get();
+#if defined(PX4_CRYPTO)
+
+		if (compress && _param_sdlog_crypto_algorithm.get() != 0) {
+			PX4_WARN("log compression is not supported with encryption");
+			compress = false;
+		}
+
+#endif
+
+		_writer.set_compression_file(compress);
+
+		set_load_shedding_level(0);
+		_load_shedding_low_since = 0;
+	}
 
 	char file_name[LOG_DIR_LEN] = "";
 
@@ -1516,11 +1669,15 @@ void Logger::stop_log_mavlink()
 	}
 }
 
+static constexpr int perf_histogram_buffer_length = 600;
+
 struct perf_callback_data_t {
 	Logger *logger;
 	int counter;
 	Logger::PrintLoadReason reason;
 	char *buffer;
+	int histogram_counter;
+	char *histogram_buffer;
 };
 
 void Logger::handle_file_write_error()
@@ -1562,6 +1719,29 @@ void Logger::perf_iterate_callback(perf_counter_t handle, void *user)
 
 	callback_data->logger->write_info_multiple(LogType::Full, perf_name, buffer, callback_data->counter != 0);
 	++callback_data->counter;
+
+	// histogram buckets (PC_HISTOGRAM only)
+	if (callback_data->histogram_buffer
+	    && perf_print_histogram_buffer(callback_data->histogram_buffer, perf_histogram_buffer_length, handle) > 0) {
+		switch (callback_data->reason) {
+		case PrintLoadReason::Preflight:
+		default:
+			perf_name = "perf_histogram_preflight";
+			break;
+
+		case PrintLoadReason::Postflight:
+			perf_name = "perf_histogram_postflight";
+			break;
+
+		case PrintLoadReason::Watchdog:
+			perf_name = "perf_histogram_watchdog";
+			break;
+		}
+
+		callback_data->logger->write_info_multiple(LogType::Full, perf_name, callback_data->histogram_buffer,
+				callback_data->histogram_counter != 0);
+		++callback_data->histogram_counter;
+	}
 }
 
 void Logger::write_perf_data(PrintLoadReason reason)
@@ -1570,9 +1750,13 @@ void Logger::write_perf_data(PrintLoadReason reason)
 	callback_data.logger = this;
 	callback_data.counter = 0;
 	callback_data.reason = reason;
+	callback_data.histogram_counter = 0;
+	callback_data.histogram_buffer = new char[perf_histogram_buffer_length]; // too large for the stack
 
 	// write the perf counters
 	perf_iterate_all(perf_iterate_callback, &callback_data);
+
+	delete[](callback_data.histogram_buffer);
 }
 
 
@@ -43,6 +43,7 @@
 #include <drivers/drv_hrt.h>
 #include <version/version.h>
 #include <parameters/param.h>
+#include <perf/perf_counter.h>
 #include <px4_platform_common/printload.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
@@ -74,11 +75,16 @@ static constexpr uint8_t MSG_ID_INVALID = UINT8_MAX;
 struct LoggerSubscription : public uORB::SubscriptionInterval {
 	LoggerSubscription() = default;
 
-	LoggerSubscription(ORB_ID id, uint32_t interval_ms = 0, uint8_t instance = 0) :
-		uORB::SubscriptionInterval(id, interval_ms * 1000, instance)
+	LoggerSubscription(ORB_ID id, uint32_t interval_ms = 0, uint8_t instance = 0,
+			   LogPriority log_priority = LogPriority::Normal) :
+		uORB::SubscriptionInterval(id, interval_ms * 1000, instance),
+		priority(log_priority),
+		base_interval_us(interval_ms * 1000)
 	{}
 
 	uint8_t msg_id{MSG_ID_INVALID};
+	LogPriority priority{LogPriority::Normal};
+	uint32_t base_interval_us{0}; ///< configured interval, the actual one is increased while shedding load
 };
 
 class Logger : public ModuleBase<Logger>, public ModuleParams
@@ -174,6 +180,7 @@ private:
 		hrt_abstime dropout_start{0};				///< start of current dropout (0 = no dropout)
 		float max_dropout_duration{0.0f};			///< max duration of dropout [s]
 		size_t write_dropouts{0};				///< failed buffer writes due to buffer overflow
+		size_t total_write_dropouts{0};				///< failed buffer writes since the start of the log
 		size_t high_water{0};					///< maximum used write buffer
 	};
 
@@ -338,9 +345,29 @@ private:
 
 	void adjust_subscription_updates();
 
+	/**
+	 * Write a logging (string) message to the full log. The caller must hold the writer lock.
+	 * @param log_level syslog level (0=emergency ... 7=debug)
+	 */
+	void write_logging_message(uint8_t log_level, uint64_t timestamp, const char *message);
+
+	/**
+	 * Adapt the load shedding level to the fill state of the full log write buffer: while the backlog
+	 * is large, the intervals of normal and low priority topics are increased. Changes are recorded in the log.
+	 * The caller must hold the writer lock.
+	 */
+	void update_load_shedding(const hrt_abstime &now);
+
+	/**
+	 * Apply the intervals of a load shedding level to all subscriptions
+	 */
+	void set_load_shedding_level(int level);
+
 	uint8_t						*_msg_buffer{nullptr};
 	int						_msg_buffer_len{0};
 
+	perf_counter_t					_lock_hold_perf{perf_alloc(PC_HISTOGRAM, MODULE_NAME": lock hold")}; ///< write buffer lock hold time per main loop iteration
+
 	LogFileName					_file_name[(int)LogType::Count];
 
 	bool						_prev_file_log_start_state{false}; ///< previous state depending on logging mode (arming or aux1 state)
@@ -383,6 +410,9 @@ private:
 
 	uint32_t					_message_gaps{0};
 
+	int						_load_shedding_level{0};
+	hrt_abstime					_load_shedding_low_since{0}; ///< since when the buffer fill is low enough to decrease the level
+
 	timer_callback_data_s				_timer_callback_data{};
 
 	uORB::Subscription				_manual_control_setpoint_sub{ORB_ID(manual_control_setpoint)};
@@ -397,7 +427,9 @@ private:
 		(ParamInt<px4::params::SDLOG_PROFILE>) _param_sdlog_profile,
 		(ParamInt<px4::params::SDLOG_MISSION>) _param_sdlog_mission,
 		(ParamBool<px4::params::SDLOG_BOOT_BAT>) _param_sdlog_boot_bat,
-		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid
+		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid,
+		(ParamBool<px4::params::SDLOG_COMPRESS>) _param_sdlog_compress,
+		(ParamBool<px4::params::SDLOG_LOAD_SHED>) _param_sdlog_load_shed
 #if defined(PX4_CRYPTO)
 		, (ParamInt<px4::params::SDLOG_ALGORITHM>) _param_sdlog_crypto_algorithm,
 		(ParamInt<px4::params::SDLOG_KEY>) _param_sdlog_crypto_key,
@@ -88,6 +88,41 @@ struct ulog_key_header_s {
 	uint8_t	data[0];
 };
 
+/** first bytes of a compressed log file (.ulgz), followed by a sequence of blocks */
+struct ulog_compressed_file_header_s {
+	/* magic identifying the file content */
+	uint8_t magic[7];
+
+	/* version of the compressed file format */
+	uint8_t hdr_ver;
+
+	/* maximum uncompressed size of a block */
+	uint32_t block_size_max;
+};
+
+/** header of each block in a compressed log file */
+struct ulog_compressed_block_header_s {
+	/* sync marker, allows to find the next block after a corrupted one */
+	uint8_t magic[4];
+
+	/* ULOG_COMPRESSED_BLOCK_STORED or ULOG_COMPRESSED_BLOCK_LZ4 */
+	uint8_t type;
+
+	uint8_t reserved[3];
+
+	/* size of the block data following this header */
+	uint32_t compressed_size;
+
+	/* size of the block data after decompression */
+	uint32_t uncompressed_size;
+
+	/* offset of the block in the decompressed ULog file, for seeking without decompressing all blocks */
+	uint64_t uncompressed_offset;
+};
+
+#define ULOG_COMPRESSED_BLOCK_STORED 0 ///< uncompressed block data
+#define ULOG_COMPRESSED_BLOCK_LZ4 1 ///< block data in LZ4 block format
+
 
 /**
  * @brief Message Header for the ULog
@@ -177,6 +177,22 @@ PARAM_DEFINE_INT32(SDLOG_DIRS_MAX, 0);
  */
 PARAM_DEFINE_INT32(SDLOG_UUID, 1);
 
+/**
+ * Log compression
+ *
+ * If enabled, the full log is compressed in the logger's writer thread before writing it
+ * to the SD card, which reduces the write bandwidth for high-rate logging profiles.
+ * The log files are then stored as .ulgz and need to be converted to .ulg with
+ * Tools/decompress_ulog.py for analysis.
+ *
+ * Compression is not applied to encrypted logs and to the mission log.
+ * Compressed logs do not contain the hardfault crash dump.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_COMPRESS, 0);
+
 /**
  * Logfile Encryption algorithm
  *
@@ -220,3 +236,17 @@ PARAM_DEFINE_INT32(SDLOG_KEY, 2);
  * @group SD Logging
  */
 PARAM_DEFINE_INT32(SDLOG_EXCH_KEY, 1);
+
+/**
+ * Adaptive log rate
+ *
+ * If enabled, the logger increases the logging intervals of non-critical topics
+ * (including raw sensor data and topics without a configured rate) when the write
+ * buffer fills up (e.g. on a slow SD card), instead of dropping arbitrary messages.
+ * Estimator inputs, estimator, control and failsafe topics are always logged at
+ * the configured rate. Changes of the rates are recorded as messages in the log.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_LOAD_SHED, 1);
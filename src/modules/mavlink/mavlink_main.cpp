@@ -180,6 +180,10 @@ Mavlink::~Mavlink()
 	perf_free(_loop_interval_perf);
 	perf_free(_send_byte_error_perf);
 	perf_free(_forwarding_error_perf);
+
+#if defined(MAVLINK_UDP_MMSG)
+	delete _udp_batch;
+#endif // MAVLINK_UDP_MMSG
 }
 
 void
@@ -752,6 +756,11 @@ void Mavlink::send_start(int length)
 
 	} else {
 		_tx_buffer_low = false;
+
+		// only stream updates (main thread) are charged to the byte budget, not the receiver thread
+		if (pthread_equal(pthread_self(), _main_thread)) {
+			_tx_stream_bytes_queued += length;
+		}
 	}
 }
 
@@ -767,42 +776,58 @@ void Mavlink::send_finish()
 	// send message to UART
 	if (get_protocol() == Protocol::SERIAL) {
 		ret = ::write(_uart_fd, _buf, _buf_fill);
+		_syscalls_tx++;
 	}
 
 #if defined(MAVLINK_UDP)
 
 	else if (get_protocol() == Protocol::UDP) {
 
+# if defined(MAVLINK_UDP_MMSG)
+
+		if (_udp_batch) {
+			// queue the message, it's sent together with the others at the end of the main loop iteration
+			memcpy(_udp_batch->buf[_udp_batch->count], _buf, _buf_fill);
+			_udp_batch->iov[_udp_batch->count].iov_base = _udp_batch->buf[_udp_batch->count];
+			_udp_batch->iov[_udp_batch->count].iov_len = _buf_fill;
+			_udp_batch->count++;
+
+			if (_udp_batch->count >= UDP_BATCH_MAX_MESSAGES) {
+				udp_batch_send();
+			}
+
+			_buf_fill = 0;
+
+			pthread_mutex_unlock(&_send_mutex);
+			return;
+		}
+
+# endif // MAVLINK_UDP_MMSG
+
 # if defined(CONFIG_NET)
 
 		if (_src_addr_initialized) {
 # endif // CONFIG_NET
 			ret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_src_addr, sizeof(_src_addr));
+			_syscalls_tx++;
 # if defined(CONFIG_NET)
 		}
 
 # endif // CONFIG_NET
 
-		if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
-		    (!get_client_source_initialized() || !is_gcs_connected())) {
-
-			if (!_broadcast_address_found) {
-				find_broadcast_address();
-			}
-
-			if (_broadcast_address_found && _buf_fill > 0) {
+		if (send_broadcast()) {
 
-				int bret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
-
-				if (bret <= 0) {
-					if (!_broadcast_failed_warned) {
-						PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
-						_broadcast_failed_warned = true;
-					}
+			int bret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
+			_syscalls_tx++;
 
-				} else {
-					_broadcast_failed_warned = false;
+			if (bret <= 0) {
+				if (!_broadcast_failed_warned) {
+					PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
+					_broadcast_failed_warned = true;
 				}
+
+			} else {
+				_broadcast_failed_warned = false;
 			}
 		}
 	}
@@ -837,6 +862,93 @@ void Mavlink::send_bytes(const uint8_t *buf, unsigned packet_len)
 }
 
 #ifdef MAVLINK_UDP
+bool Mavlink::send_broadcast()
+{
+	if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
+	    (!get_client_source_initialized() || !is_gcs_connected())) {
+
+		if (!_broadcast_address_found) {
+			find_broadcast_address();
+		}
+
+		return _broadcast_address_found;
+	}
+
+	return false;
+}
+
+#if defined(MAVLINK_UDP_MMSG)
+void Mavlink::udp_batch_send()
+{
+	if (_udp_batch == nullptr || _udp_batch->count == 0) {
+		return;
+	}
+
+	UdpBatch &batch = *_udp_batch;
+	const bool broadcast = send_broadcast();
+	const unsigned entries_per_message = broadcast ? 2 : 1;
+	unsigned num_entries = 0;
+
+	for (unsigned i = 0; i < batch.count; i++) {
+		mmsghdr &unicast = batch.msgs[num_entries++];
+		unicast.msg_hdr = {};
+		unicast.msg_hdr.msg_name = &_src_addr;
+		unicast.msg_hdr.msg_namelen = sizeof(_src_addr);
+		unicast.msg_hdr.msg_iov = &batch.iov[i];
+		unicast.msg_hdr.msg_iovlen = 1;
+
+		if (broadcast) {
+			mmsghdr &bcast = batch.msgs[num_entries++];
+			bcast.msg_hdr = unicast.msg_hdr;
+			bcast.msg_hdr.msg_name = &_bcast_addr;
+			bcast.msg_hdr.msg_namelen = sizeof(_bcast_addr);
+		}
+	}
+
+	// a failing entry is skipped, as with one sendto() per message
+	bool entry_sent[UDP_BATCH_MAX_MESSAGES * 2];
+	unsigned entry = 0;
+
+	while (entry < num_entries) {
+		const int ret = sendmmsg(_socket_fd, &batch.msgs[entry], num_entries - entry, 0);
+		_syscalls_tx++;
+
+		if (ret > 0) {
+			for (int k = 0; k < ret; k++) {
+				entry_sent[entry++] = true;
+			}
+
+		} else {
+			if (broadcast && (entry % 2 == 1) && !_broadcast_failed_warned) {
+				PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
+				_broadcast_failed_warned = true;
+			}
+
+			entry_sent[entry++] = false;
+		}
+	}
+
+	for (unsigned i = 0; i < batch.count; i++) {
+		const unsigned len = batch.iov[i].iov_len;
+
+		if (entry_sent[i * entries_per_message]) {
+			_tstatus.tx_message_count++;
+			count_txbytes(len);
+			_last_write_success_time = _last_write_try_time;
+
+		} else {
+			count_txerrbytes(len);
+		}
+
+		if (broadcast && entry_sent[i * entries_per_message + 1]) {
+			_broadcast_failed_warned = false;
+		}
+	}
+
+	batch.count = 0;
+}
+#endif // MAVLINK_UDP_MMSG
+
 void Mavlink::find_broadcast_address()
 {
 	struct ifconf ifconf;
@@ -1012,6 +1124,18 @@ void Mavlink::init_udp()
 	}
 
 	_src_addr.sin_port = htons(_remote_port);
+
+#if defined(MAVLINK_UDP_MMSG)
+
+	if (_udp_batching_requested && _udp_batch == nullptr) {
+		_udp_batch = new UdpBatch{};
+
+		if (_udp_batch == nullptr) {
+			PX4_ERR("UDP batch alloc failed, sending messages individually");
+		}
+	}
+
+#endif // MAVLINK_UDP_MMSG
 }
 #endif // MAVLINK_UDP
 
@@ -1164,6 +1288,8 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 
 	for (const auto &stream : _streams) {
 		if (strcmp(stream_name, stream->get_name()) == 0) {
+			_stream_scheduler.invalidate();
+
 			if (interval != 0) {
 				/* set new interval */
 				stream->set_interval(interval);
@@ -1185,6 +1311,7 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 	if (stream != nullptr) {
 		stream->set_interval(interval);
 		_streams.add(stream);
+		_stream_scheduler.invalidate();
 
 		return OK;
 	}
@@ -1343,6 +1470,77 @@ Mavlink::update_rate_mult()
 	_rate_mult = math::constrain(_rate_mult, 0.05f, 1.0f);
 }
 
+void
+Mavlink::update_tx_budget(const hrt_abstime &t, unsigned bytes_used)
+{
+	int64_t budget = (int64_t)_tx_budget - bytes_used;
+
+	if ((_tx_budget_time != 0) && (t > _tx_budget_time)) {
+		budget += (int64_t)_datarate * (int64_t)(t - _tx_budget_time) / 1000000;
+	}
+
+	_tx_budget_time = t;
+
+	// allow bursts of up to 100 ms, but at least one full message
+	const int64_t budget_max = math::max(_datarate / 10, (int)MAVLINK_MAX_PACKET_LEN);
+	_tx_budget = math::constrain(budget, -budget_max, budget_max);
+}
+
+void
+Mavlink::check_first_heartbeat_sent(MavlinkStream *stream)
+{
+	if (!_first_heartbeat_sent) {
+		if (_mode == MAVLINK_MODE_IRIDIUM) {
+			if (stream->get_id() == MAVLINK_MSG_ID_HIGH_LATENCY2) {
+				_first_heartbeat_sent = stream->first_message_sent();
+			}
+
+		} else {
+			if (stream->get_id() == MAVLINK_MSG_ID_HEARTBEAT) {
+				_first_heartbeat_sent = stream->first_message_sent();
+			}
+		}
+	}
+}
+
+void
+Mavlink::update_streams(const hrt_abstime &t)
+{
+	if (!_stream_scheduler.update(_streams, _rate_mult, _main_loop_delay)) {
+		// no schedule, visit all streams
+		for (const auto &stream : _streams) {
+			stream->update(t);
+			check_first_heartbeat_sent(stream);
+		}
+
+		return;
+	}
+
+	update_tx_budget(t, 0);
+
+	// with flow control the link itself limits the rate
+	const bool use_tx_budget = !get_flow_control_enabled();
+
+	const unsigned num_due = _stream_scheduler.take_due(t);
+
+	for (unsigned i = 0; i < num_due; i++) {
+		MavlinkStream *stream = _stream_scheduler.due_stream(i);
+
+		if (use_tx_budget && (_tx_budget <= 0) && !stream->const_rate()) {
+			_stream_scheduler.defer(i);
+			continue;
+		}
+
+		const unsigned bytes_queued = _tx_stream_bytes_queued;
+		stream->update(t);
+		update_tx_budget(t, _tx_stream_bytes_queued - bytes_queued);
+
+		_stream_scheduler.reschedule(i);
+
+		check_first_heartbeat_sent(stream);
+	}
+}
+
 void
 Mavlink::update_radio_status(const radio_status_s &radio_status)
 {
@@ -1849,7 +2047,7 @@ Mavlink::task_main(int argc, char *argv[])
 	int temp_int_arg;
 #endif
 
-	while ((ch = px4_getopt(argc, argv, "b:r:d:n:u:o:m:t:c:fswxzZp", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "b:r:d:n:u:o:m:t:c:fswxzZpB", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'b':
 			if (px4_get_parameter_value(myoptarg, _baudrate) != 0) {
@@ -1935,6 +2133,14 @@ Mavlink::task_main(int argc, char *argv[])
 			_mav_broadcast = BROADCAST_MODE_ON;
 			break;
 
+		case 'B':
+#if defined(MAVLINK_UDP_MMSG)
+			_udp_batching_requested = true;
+#else
+			PX4_WARN("UDP batching not supported on this platform");
+#endif // MAVLINK_UDP_MMSG
+			break;
+
 #if defined(CONFIG_NET_IGMP) && defined(CONFIG_NET_ROUTE)
 
 		// multicast
@@ -1964,6 +2170,7 @@ Mavlink::task_main(int argc, char *argv[])
 		case 'u':
 		case 'o':
 		case 't':
+		case 'B':
 			PX4_ERR("UDP options not supported on this platform");
 			err_flag = true;
 			break;
@@ -2227,6 +2434,7 @@ Mavlink::task_main(int argc, char *argv[])
 #endif // MAVLINK_UDP
 
 	_task_id = px4_getpid();
+	_main_thread = pthread_self();
 
 	/* if the protocol is serial, we send the system version blindly */
 	if (get_protocol() == Protocol::SERIAL) {
@@ -2247,6 +2455,15 @@ Mavlink::task_main(int argc, char *argv[])
 
 		if (!should_transmit()) {
 			check_requested_subscriptions();
+
+#if defined(MAVLINK_UDP_MMSG)
+			// messages sent by the receiver thread
+			{
+				LockGuard lg{_send_mutex};
+				udp_batch_send();
+			}
+#endif // MAVLINK_UDP_MMSG
+
 			continue;
 		}
 
@@ -2439,22 +2656,7 @@ Mavlink::task_main(int argc, char *argv[])
 		check_requested_subscriptions();
 
 		/* update streams */
-		for (const auto &stream : _streams) {
-			stream->update(t);
-
-			if (!_first_heartbeat_sent) {
-				if (_mode == MAVLINK_MODE_IRIDIUM) {
-					if (stream->get_id() == MAVLINK_MSG_ID_HIGH_LATENCY2) {
-						_first_heartbeat_sent = stream->first_message_sent();
-					}
-
-				} else {
-					if (stream->get_id() == MAVLINK_MSG_ID_HEARTBEAT) {
-						_first_heartbeat_sent = stream->first_message_sent();
-					}
-				}
-			}
-		}
+		update_streams(t);
 
 		/* check for ulog streaming messages */
 		if (_mavlink_ulog) {
@@ -2527,6 +2729,14 @@ Mavlink::task_main(int argc, char *argv[])
 			}
 		}
 
+#if defined(MAVLINK_UDP_MMSG)
+		/* send all messages of this iteration at once */
+		{
+			LockGuard lg{_send_mutex};
+			udp_batch_send();
+		}
+#endif // MAVLINK_UDP_MMSG
+
 		/* update TX/RX rates*/
 		if (t > _bytes_timestamp + 1_s) {
 			if (_bytes_timestamp != 0) {
@@ -2536,9 +2746,14 @@ Mavlink::task_main(int argc, char *argv[])
 				_tstatus.tx_error_rate_avg = _bytes_txerr / dt;
 				_tstatus.rx_rate_avg = _bytes_rx / dt;
 
+				_syscalls_tx_rate = _syscalls_tx / dt;
+				_syscalls_rx_rate = _syscalls_rx / dt;
+
 				_bytes_tx = 0;
 				_bytes_txerr = 0;
 				_bytes_rx = 0;
+				_syscalls_tx = 0;
+				_syscalls_rx = 0;
 			}
 
 			_bytes_timestamp = t;
@@ -2558,6 +2773,7 @@ Mavlink::task_main(int argc, char *argv[])
 	_subscribe_to_stream = nullptr;
 
 	/* delete streams */
+	_stream_scheduler.invalidate();
 	_streams.clear();
 
 	if (_uart_fd >= 0) {
@@ -2874,6 +3090,8 @@ Mavlink::display_status()
 	printf("\t  tx rate max: %i B/s\n", _datarate);
 	printf("\t  rx: %.1f B/s\n", (double)_tstatus.rx_rate_avg);
 	printf("\t  rx loss: %.1f%%\n", (double)_tstatus.rx_message_lost_rate);
+	printf("\t  tx syscalls: %.1f/s\n", (double)_syscalls_tx_rate);
+	printf("\t  rx syscalls: %.1f/s\n", (double)_syscalls_rx_rate);
 
 #if !defined(CONSTRAINED_FLASH)
 	_receiver.print_detailed_rx_stats();
@@ -2900,6 +3118,10 @@ Mavlink::display_status()
 		printf("UDP (%hu, remote port: %hu)\n", _network_port, _remote_port);
 		printf("\tBroadcast enabled: %s\n",
 		       broadcast_enabled() ? "YES" : "NO");
+#if defined(MAVLINK_UDP_MMSG)
+		printf("\tBatching (sendmmsg/recvmmsg): %s\n",
+		       get_udp_batching() ? "YES" : "NO");
+#endif // MAVLINK_UDP_MMSG
 #if defined(CONFIG_NET_IGMP) && defined(CONFIG_NET_ROUTE)
 		printf("\tMulticast enabled: %s\n",
 		       multicast_enabled() ? "YES" : "NO");
@@ -3261,6 +3483,7 @@ $ mavlink stream -u 14556 -s HIGHRES_IMU -r 50
 	PRINT_MODULE_USAGE_PARAM_INT('u', 14556, 0, 65536, "Select UDP Network Port (local)", true);
 	PRINT_MODULE_USAGE_PARAM_INT('o', 14550, 0, 65536, "Select UDP Network Port (remote)", true);
 	PRINT_MODULE_USAGE_PARAM_STRING('t', "127.0.0.1", nullptr, "Partner IP (broadcasting can be enabled via -p flag)", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('B', "Batch UDP sends and receives per loop iteration (sendmmsg/recvmmsg, Linux only)", true);
 #endif
 	PRINT_MODULE_USAGE_PARAM_STRING('m', "normal", "custom|camera|onboard|osd|magic|config|iridium|minimal|extvision|extvisionmin|gimbal|uavionix",
 					"Mode: sets default streams and rates", true);
@@ -84,6 +84,7 @@
 #include "mavlink_messages.h"
 #include "mavlink_receiver.h"
 #include "mavlink_shell.h"
+#include "mavlink_stream_scheduler.h"
 #include "mavlink_ulog.h"
 
 #define DEFAULT_BAUD_RATE       57600
@@ -96,6 +97,10 @@
 # define DEFAULT_REMOTE_PORT_UDP 14550 ///< GCS port per MAVLink spec
 #endif // CONFIG_NET || __PX4_POSIX
 
+#if defined(MAVLINK_UDP) && defined(__PX4_LINUX)
+# define MAVLINK_UDP_MMSG ///< batched UDP transport (sendmmsg/recvmmsg)
+#endif // MAVLINK_UDP && __PX4_LINUX
+
 enum class Protocol {
 	SERIAL = 0,
 #if defined(MAVLINK_UDP)
@@ -435,6 +440,11 @@ public:
 	 */
 	void			count_rxbytes(unsigned n) { _bytes_rx += n; };
 
+	/**
+	 * Count read/recv system calls
+	 */
+	void			count_rxsyscalls(unsigned n = 1) { _syscalls_rx += n; };
+
 	/**
 	 * Get the receive status of this MAVLink link
 	 */
@@ -467,6 +477,10 @@ public:
 	bool			get_client_source_initialized() { return _src_addr_initialized; }
 #endif
 
+#if defined(MAVLINK_UDP_MMSG)
+	bool			get_udp_batching() const { return _udp_batch != nullptr; }
+#endif // MAVLINK_UDP_MMSG
+
 	uint64_t		get_start_time() { return _mavlink_start_time; }
 
 	static bool		boot_complete() { return _boot_complete; }
@@ -565,6 +579,12 @@ private:
 	unsigned		_main_loop_delay{1000};	/**< mainloop delay, depends on data rate */
 
 	List<MavlinkStream *>		_streams;
+	MavlinkStreamScheduler		_stream_scheduler;
+
+	int32_t			_tx_budget{0};			///< bytes that can still be sent by rate adjusted streams
+	hrt_abstime		_tx_budget_time{0};
+	pthread_t		_main_thread{};			///< thread running task_main() and the stream updates
+	unsigned		_tx_stream_bytes_queued{0};	///< bytes queued for sending by the main thread, only accessed by it
 
 	MavlinkShell		*_mavlink_shell{nullptr};
 	MavlinkULog		*_mavlink_ulog{nullptr};
@@ -613,8 +633,13 @@ private:
 	unsigned		_bytes_tx{0};
 	unsigned		_bytes_txerr{0};
 	unsigned		_bytes_rx{0};
+	unsigned		_syscalls_tx{0};
+	unsigned		_syscalls_rx{0};
 	hrt_abstime		_bytes_timestamp{0};
 
+	float			_syscalls_tx_rate{0.f};
+	float			_syscalls_rx_rate{0.f};
+
 #if defined(MAVLINK_UDP)
 	BROADCAST_MODE		_mav_broadcast {BROADCAST_MODE_OFF};
 
@@ -631,6 +656,24 @@ private:
 	unsigned short		_remote_port{DEFAULT_REMOTE_PORT_UDP};
 #endif // MAVLINK_UDP
 
+#if defined(MAVLINK_UDP_MMSG)
+	static constexpr unsigned UDP_BATCH_MAX_MESSAGES{64};
+
+	/**
+	 * Messages queued by send_finish() and sent with a single sendmmsg() per main loop iteration.
+	 * Each message is sent to the partner and, if broadcasting, to the broadcast address.
+	 */
+	struct UdpBatch {
+		uint8_t buf[UDP_BATCH_MAX_MESSAGES][MAVLINK_MAX_PACKET_LEN];
+		iovec iov[UDP_BATCH_MAX_MESSAGES];
+		mmsghdr msgs[UDP_BATCH_MAX_MESSAGES * 2];
+		unsigned count;
+	};
+
+	UdpBatch		*_udp_batch{nullptr};
+	bool			_udp_batching_requested{false};
+#endif // MAVLINK_UDP_MMSG
+
 	uint8_t			_buf[MAVLINK_MAX_PACKET_LEN] {};
 	unsigned		_buf_fill{0};
 
@@ -720,12 +763,39 @@ private:
 	 */
 	void update_rate_mult();
 
+	/**
+	 * Refill the byte budget of the link at the data rate and subtract the bytes queued by stream updates.
+	 * Streams that are not constant rate are deferred while the budget is used up. Traffic from the
+	 * receiver thread (parameters, missions, FTP, log download) is not charged.
+	 */
+	void update_tx_budget(const hrt_abstime &t, unsigned bytes_used);
+
+	/**
+	 * Update the streams that are due, constant rate streams first, then the others by deadline
+	 * as long as the byte budget permits.
+	 */
+	void update_streams(const hrt_abstime &t);
+
+	void check_first_heartbeat_sent(MavlinkStream *stream);
+
 #if defined(MAVLINK_UDP)
 	void find_broadcast_address();
 
 	void init_udp();
+
+	/**
+	 * Check if the broadcast address is to be used for the current message and look it up if required
+	 */
+	bool send_broadcast();
 #endif // MAVLINK_UDP
 
+#if defined(MAVLINK_UDP_MMSG)
+	/**
+	 * Send all queued UDP messages, _send_mutex must be held
+	 */
+	void udp_batch_send();
+#endif // MAVLINK_UDP_MMSG
+
 
 	bool set_channel();
 
@@ -72,6 +72,7 @@
 MavlinkReceiver::~MavlinkReceiver()
 {
 	delete _tune_publisher;
+	delete[] _udp_batch_buf;
 	delete _px4_accel;
 	delete _px4_gyro;
 	delete _px4_mag;
@@ -3116,6 +3117,170 @@ MavlinkReceiver::handle_message_gimbal_device_attitude_status(mavlink_message_t
 	_gimbal_device_attitude_status_pub.publish(gimbal_attitude_status);
 }
 
+void
+MavlinkReceiver::parse_received(const uint8_t *buf, ssize_t nread)
+{
+	mavlink_message_t msg;
+
+	/* if read failed, this loop won't execute */
+	for (ssize_t i = 0; i < nread; i++) {
+		if (mavlink_parse_char(_mavlink->get_channel(), buf[i], &msg, &_status)) {
+
+			/* check if we received version 2 and request a switch. */
+			if (!(_mavlink->get_status()->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)) {
+				/* this will only switch to proto version 2 if allowed in settings */
+				_mavlink->set_proto_version(2);
+			}
+
+			/* handle generic messages and commands */
+			handle_message(&msg);
+
+			/* handle packet with mission manager */
+			_mission_manager.handle_message(&msg);
+
+			/* handle packet with parameter component */
+			if (_mavlink->boot_complete()) {
+				// make sure mavlink app has booted before we start processing parameter sync
+				_parameters_manager.handle_message(&msg);
+
+			} else {
+				if (hrt_elapsed_time(&_mavlink->get_first_start_time()) > 20_s) {
+					PX4_ERR("system boot did not complete in 20 seconds");
+					_mavlink->set_boot_complete();
+				}
+			}
+
+			if (_mavlink->ftp_enabled()) {
+				/* handle packet with ftp component */
+				_mavlink_ftp.handle_message(&msg);
+			}
+
+			/* handle packet with log component */
+			_mavlink_log_handler.handle_message(&msg);
+
+			/* handle packet with timesync component */
+			_mavlink_timesync.handle_message(&msg);
+
+			/* handle packet with parent object */
+			_mavlink->handle_message(&msg);
+
+			update_rx_stats(msg);
+
+			if (_message_statistics_enabled) {
+				update_message_statistics(msg);
+			}
+		}
+	}
+
+	/* count received bytes (nread will be -1 on read error) */
+	if (nread > 0) {
+		_mavlink->count_rxbytes(nread);
+
+		telemetry_status_s &tstatus = _mavlink->telemetry_status();
+		tstatus.rx_message_count = _total_received_counter;
+		tstatus.rx_message_lost_count = _total_lost_counter;
+		tstatus.rx_message_lost_rate = static_cast<float>(_total_lost_counter) / static_cast<float>(_total_received_counter);
+
+		if (_mavlink_status_last_buffer_overrun != _status.buffer_overrun) {
+			tstatus.rx_buffer_overruns++;
+			_mavlink_status_last_buffer_overrun = _status.buffer_overrun;
+		}
+
+		if (_mavlink_status_last_parse_error != _status.parse_error) {
+			tstatus.rx_parse_errors++;
+			_mavlink_status_last_parse_error = _status.parse_error;
+		}
+
+		if (_mavlink_status_last_packet_rx_drop_count != _status.packet_rx_drop_count) {
+			tstatus.rx_packet_drop_count++;
+			_mavlink_status_last_packet_rx_drop_count = _status.packet_rx_drop_count;
+		}
+	}
+}
+
+#if defined(MAVLINK_UDP)
+/**
+ * Take the source address of a received datagram as partner address if not yet initialized
+ */
+static void update_udp_source(Mavlink *mavlink, const sockaddr_in &srcaddr)
+{
+	struct sockaddr_in &srcaddr_last = mavlink->get_client_source_address();
+
+	int localhost = (127 << 24) + 1;
+
+	if (!mavlink->get_client_source_initialized()) {
+
+		// set the address either if localhost or if 3 seconds have passed
+		// this ensures that a GCS running on localhost can get a hold of
+		// the system within the first N seconds
+		hrt_abstime stime = mavlink->get_start_time();
+
+		if ((stime != 0 && (hrt_elapsed_time(&stime) > 3_s))
+		    || (srcaddr_last.sin_addr.s_addr == htonl(localhost))) {
+
+			srcaddr_last.sin_addr.s_addr = srcaddr.sin_addr.s_addr;
+			srcaddr_last.sin_port = srcaddr.sin_port;
+
+			mavlink->set_client_source_initialized();
+
+			PX4_INFO("partner IP: %s", inet_ntoa(srcaddr.sin_addr));
+		}
+	}
+}
+#endif // MAVLINK_UDP
+
+#if defined(MAVLINK_UDP_MMSG)
+bool
+MavlinkReceiver::receive_udp_batch(size_t datagram_len)
+{
+	static constexpr unsigned UDP_BATCH_MAX_DATAGRAMS = 5;
+
+	// each datagram gets a slot as large as the buffer of a single recvfrom()
+	if (_udp_batch_buf == nullptr) {
+		_udp_batch_buf = new uint8_t[UDP_BATCH_MAX_DATAGRAMS * datagram_len];
+
+		if (_udp_batch_buf == nullptr) {
+			return false;
+		}
+	}
+
+	iovec iov[UDP_BATCH_MAX_DATAGRAMS];
+	mmsghdr msgs[UDP_BATCH_MAX_DATAGRAMS] {};
+	sockaddr_in addrs[UDP_BATCH_MAX_DATAGRAMS];
+
+	for (unsigned i = 0; i < UDP_BATCH_MAX_DATAGRAMS; i++) {
+		iov[i].iov_base = _udp_batch_buf + i * datagram_len;
+		iov[i].iov_len = datagram_len;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+	}
+
+	// don't wait for more datagrams than already available
+	const int received = recvmmsg(_mavlink->get_socket_fd(), msgs, UDP_BATCH_MAX_DATAGRAMS, MSG_DONTWAIT, nullptr);
+	_mavlink->count_rxsyscalls();
+
+	// each datagram is handled on its own, with its own source address
+	for (int i = 0; i < received; i++) {
+		if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+			// larger than the receive buffer, drop it rather than parsing a partial packet
+			_mavlink->telemetry_status().rx_packet_drop_count++;
+			continue;
+		}
+
+		update_udp_source(_mavlink, addrs[i]);
+
+		// only start accepting messages once we're sure who we talk to
+		if (_mavlink->get_client_source_initialized()) {
+			parse_received(static_cast<const uint8_t *>(iov[i].iov_base), msgs[i].msg_len);
+		}
+	}
+
+	return true;
+}
+#endif // MAVLINK_UDP_MMSG
+
 void
 MavlinkReceiver::run()
 {
@@ -3139,7 +3304,6 @@ MavlinkReceiver::run()
 	/* the serial port buffers internally as well, we just need to fit a small chunk */
 	uint8_t buf[64];
 #endif
-	mavlink_message_t msg;
 
 	struct pollfd fds[1] = {};
 
@@ -3180,6 +3344,7 @@ MavlinkReceiver::run()
 			if (_mavlink->get_protocol() == Protocol::SERIAL) {
 				/* non-blocking read. read may return negative values */
 				nread = ::read(fds[0].fd, buf, sizeof(buf));
+				_mavlink->count_rxsyscalls();
 
 				if (nread == -1 && errno == ENOTCONN) { // Not connected (can happen for USB)
 					usleep(100000);
@@ -3189,112 +3354,35 @@ MavlinkReceiver::run()
 #if defined(MAVLINK_UDP)
 
 			else if (_mavlink->get_protocol() == Protocol::UDP) {
-				if (fds[0].revents & POLLIN) {
-					nread = recvfrom(_mavlink->get_socket_fd(), buf, sizeof(buf), 0, (struct sockaddr *)&srcaddr, &addrlen);
-				}
-
-				struct sockaddr_in &srcaddr_last = _mavlink->get_client_source_address();
+				nread = 0;
+				bool batched = false;
 
-				int localhost = (127 << 24) + 1;
-
-				if (!_mavlink->get_client_source_initialized()) {
-
-					// set the address either if localhost or if 3 seconds have passed
-					// this ensures that a GCS running on localhost can get a hold of
-					// the system within the first N seconds
-					hrt_abstime stime = _mavlink->get_start_time();
-
-					if ((stime != 0 && (hrt_elapsed_time(&stime) > 3_s))
-					    || (srcaddr_last.sin_addr.s_addr == htonl(localhost))) {
+				if (fds[0].revents & POLLIN) {
+#if defined(MAVLINK_UDP_MMSG)
 
-						srcaddr_last.sin_addr.s_addr = srcaddr.sin_addr.s_addr;
-						srcaddr_last.sin_port = srcaddr.sin_port;
+					if (_mavlink->get_udp_batching()) {
+						// source address and parsing are handled per datagram
+						batched = receive_udp_batch(sizeof(buf));
+					}
 
-						_mavlink->set_client_source_initialized();
+#endif // MAVLINK_UDP_MMSG
 
-						PX4_INFO("partner IP: %s", inet_ntoa(srcaddr.sin_addr));
+					if (!batched) {
+						nread = recvfrom(_mavlink->get_socket_fd(), buf, sizeof(buf), 0, (struct sockaddr *)&srcaddr, &addrlen);
+						_mavlink->count_rxsyscalls();
 					}
 				}
+
+				if (!batched) {
+					update_udp_source(_mavlink, srcaddr);
+				}
 			}
 
 			// only start accepting messages on UDP once we're sure who we talk to
 			if (_mavlink->get_protocol() != Protocol::UDP || _mavlink->get_client_source_initialized()) {
 #endif // MAVLINK_UDP
 
-				/* if read failed, this loop won't execute */
-				for (ssize_t i = 0; i < nread; i++) {
-					if (mavlink_parse_char(_mavlink->get_channel(), buf[i], &msg, &_status)) {
-
-						/* check if we received version 2 and request a switch. */
-						if (!(_mavlink->get_status()->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)) {
-							/* this will only switch to proto version 2 if allowed in settings */
-							_mavlink->set_proto_version(2);
-						}
-
-						/* handle generic messages and commands */
-						handle_message(&msg);
-
-						/* handle packet with mission manager */
-						_mission_manager.handle_message(&msg);
-
-						/* handle packet with parameter component */
-						if (_mavlink->boot_complete()) {
-							// make sure mavlink app has booted before we start processing parameter sync
-							_parameters_manager.handle_message(&msg);
-
-						} else {
-							if (hrt_elapsed_time(&_mavlink->get_first_start_time()) > 20_s) {
-								PX4_ERR("system boot did not complete in 20 seconds");
-								_mavlink->set_boot_complete();
-							}
-						}
-
-						if (_mavlink->ftp_enabled()) {
-							/* handle packet with ftp component */
-							_mavlink_ftp.handle_message(&msg);
-						}
-
-						/* handle packet with log component */
-						_mavlink_log_handler.handle_message(&msg);
-
-						/* handle packet with timesync component */
-						_mavlink_timesync.handle_message(&msg);
-
-						/* handle packet with parent object */
-						_mavlink->handle_message(&msg);
-
-						update_rx_stats(msg);
-
-						if (_message_statistics_enabled) {
-							update_message_statistics(msg);
-						}
-					}
-				}
-
-				/* count received bytes (nread will be -1 on read error) */
-				if (nread > 0) {
-					_mavlink->count_rxbytes(nread);
-
-					telemetry_status_s &tstatus = _mavlink->telemetry_status();
-					tstatus.rx_message_count = _total_received_counter;
-					tstatus.rx_message_lost_count = _total_lost_counter;
-					tstatus.rx_message_lost_rate = static_cast<float>(_total_lost_counter) / static_cast<float>(_total_received_counter);
-
-					if (_mavlink_status_last_buffer_overrun != _status.buffer_overrun) {
-						tstatus.rx_buffer_overruns++;
-						_mavlink_status_last_buffer_overrun = _status.buffer_overrun;
-					}
-
-					if (_mavlink_status_last_parse_error != _status.parse_error) {
-						tstatus.rx_parse_errors++;
-						_mavlink_status_last_parse_error = _status.parse_error;
-					}
-
-					if (_mavlink_status_last_packet_rx_drop_count != _status.packet_rx_drop_count) {
-						tstatus.rx_packet_drop_count++;
-						_mavlink_status_last_packet_rx_drop_count = _status.packet_rx_drop_count;
-					}
-				}
+				parse_received(buf, nread);
 
 #if defined(MAVLINK_UDP)
 			}
@@ -217,6 +217,20 @@ private:
 
 	void CheckHeartbeats(const hrt_abstime &t, bool force = false);
 
+	/**
+	 * Parse received bytes and handle the decoded messages
+	 * @param nread number of bytes in buf, nothing is parsed if negative (read error)
+	 */
+	void parse_received(const uint8_t *buf, ssize_t nread);
+
+	/**
+	 * Receive all pending UDP datagrams with a single recvmmsg() call (Linux only, see MAVLINK_UDP_MMSG)
+	 * and handle each of them with its own source address. Truncated datagrams are dropped.
+	 * @param datagram_len maximum size of each datagram
+	 * @return false if the receive buffer could not be allocated
+	 */
+	bool receive_udp_batch(size_t datagram_len);
+
 	/**
 	 * Set the interval at which the given message stream is published.
 	 * The rate is the number of messages per second.
@@ -378,6 +392,7 @@ private:
 
 	// Allocated if needed.
 	TunePublisher *_tune_publisher{nullptr};
+	uint8_t *_udp_batch_buf{nullptr}; ///< one slot per datagram for receive_udp_batch()
 
 	hrt_abstime _last_heartbeat_check{0};
 
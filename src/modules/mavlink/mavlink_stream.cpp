@@ -128,3 +128,33 @@ MavlinkStream::update(const hrt_abstime &t)
 
 	return -1;
 }
+
+hrt_abstime
+MavlinkStream::next_update_time(float rate_mult, unsigned main_loop_delay)
+{
+	if (update_data_required() || (_last_sent == 0)) {
+		return 0;
+	}
+
+	// same interval and deadline as in update()
+	int interval = _interval;
+
+	if (!const_rate()) {
+		interval /= rate_mult;
+	}
+
+	if (interval == 0) {
+		return UINT64_MAX;
+
+	} else if (interval < 0) {
+		return 0;
+	}
+
+	const int64_t min_dt = (int64_t)interval - (int64_t)((main_loop_delay / 10) * 3);
+
+	if (min_dt < 0) {
+		return _last_sent;
+	}
+
+	return _last_sent + min_dt + 1;
+}
@@ -79,6 +79,18 @@ public:
 	 * @return 0 if updated / sent, -1 if unchanged
 	 */
 	int update(const hrt_abstime &t);
+
+	/**
+	 * Get the earliest time at which update() can send the next message. Used by the stream scheduler,
+	 * so that streams which are not due are not visited.
+	 *
+	 * @param rate_mult current rate multiplier of the instance
+	 * @param main_loop_delay main loop delay of the instance in microseconds (us)
+	 * @return time of the next update, 0 if the stream needs to be updated at every iteration,
+	 *         UINT64_MAX if it is only sent on request
+	 */
+	hrt_abstime next_update_time(float rate_mult, unsigned main_loop_delay);
+
 	virtual const char *get_name() const = 0;
 	virtual uint16_t get_id() = 0;
 
@@ -87,6 +99,11 @@ public:
 	 */
 	virtual bool const_rate() { return false; }
 
+	/**
+	 * @return true if update_data() needs to be called at every iteration, independent of the stream rate
+	 */
+	virtual bool update_data_required() { return false; }
+
 	/**
 	 * Get maximal total messages size on update
 	 */
@@ -0,0 +1,190 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_stream_scheduler.cpp
+ * Deadline ordered schedule of the streams of a mavlink instance.
+ */
+
+#include "mavlink_stream_scheduler.h"
+
+MavlinkStreamScheduler::~MavlinkStreamScheduler()
+{
+	delete[] _heap;
+	delete[] _due;
+}
+
+bool
+MavlinkStreamScheduler::update(List<MavlinkStream *> &streams, float rate_mult, unsigned main_loop_delay)
+{
+	_rate_mult = rate_mult;
+
+	// streams can only get due earlier than scheduled with a higher rate multiplier or a different loop delay
+	if (_valid && (rate_mult <= _rate_mult_min) && (main_loop_delay == _main_loop_delay)) {
+		return true;
+	}
+
+	const unsigned num_streams = streams.size();
+
+	if (num_streams > _capacity) {
+		delete[] _heap;
+		delete[] _due;
+		_heap = new Entry[num_streams];
+		_due = new Entry[num_streams];
+
+		if ((_heap == nullptr) || (_due == nullptr)) {
+			delete[] _heap;
+			delete[] _due;
+			_heap = nullptr;
+			_due = nullptr;
+			_capacity = 0;
+			_size = 0;
+			_valid = false;
+			return false;
+		}
+
+		_capacity = num_streams;
+	}
+
+	_rate_mult_min = rate_mult;
+	_main_loop_delay = main_loop_delay;
+	_size = 0;
+
+	for (const auto &stream : streams) {
+		const hrt_abstime time = stream->next_update_time(rate_mult, main_loop_delay);
+
+		if (time != UINT64_MAX) {
+			push(Entry{time, stream});
+		}
+	}
+
+	_valid = true;
+	return true;
+}
+
+unsigned
+MavlinkStreamScheduler::take_due(hrt_abstime t)
+{
+	unsigned num_due = 0;
+	unsigned num_const_rate = 0;
+
+	while ((_size > 0) && (_heap[0].time <= t)) {
+		const Entry entry = pop();
+
+		if (entry.stream->const_rate()) {
+			// keep the deadline order within the constant rate streams
+			for (unsigned i = num_due; i > num_const_rate; i--) {
+				_due[i] = _due[i - 1];
+			}
+
+			_due[num_const_rate++] = entry;
+
+		} else {
+			_due[num_due] = entry;
+		}
+
+		num_due++;
+	}
+
+	return num_due;
+}
+
+void
+MavlinkStreamScheduler::reschedule(unsigned index)
+{
+	MavlinkStream *stream = _due[index].stream;
+	const hrt_abstime time = stream->next_update_time(_rate_mult, _main_loop_delay);
+
+	if (time != UINT64_MAX) {
+		push(Entry{time, stream});
+	}
+
+	if (_rate_mult < _rate_mult_min) {
+		_rate_mult_min = _rate_mult;
+	}
+}
+
+void
+MavlinkStreamScheduler::push(const Entry &entry)
+{
+	// sift up
+	unsigned i = _size++;
+
+	while (i > 0) {
+		const unsigned parent = (i - 1) / 2;
+
+		if (_heap[parent].time <= entry.time) {
+			break;
+		}
+
+		_heap[i] = _heap[parent];
+		i = parent;
+	}
+
+	_heap[i] = entry;
+}
+
+MavlinkStreamScheduler::Entry
+MavlinkStreamScheduler::pop()
+{
+	const Entry top = _heap[0];
+	const Entry last = _heap[--_size];
+
+	// sift down
+	unsigned i = 0;
+
+	while (true) {
+		unsigned child = 2 * i + 1;
+
+		if (child >= _size) {
+			break;
+		}
+
+		if ((child + 1 < _size) && (_heap[child + 1].time < _heap[child].time)) {
+			child++;
+		}
+
+		if (last.time <= _heap[child].time) {
+			break;
+		}
+
+		_heap[i] = _heap[child];
+		i = child;
+	}
+
+	if (_size > 0) {
+		_heap[i] = last;
+	}
+
+	return top;
+}
@@ -0,0 +1,120 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_stream_scheduler.h
+ * Deadline ordered schedule of the streams of a mavlink instance.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <containers/List.hpp>
+
+#include "mavlink_stream.h"
+
+/**
+ * Min-heap of the streams of a mavlink instance, ordered by the time they need to be updated next.
+ * The main loop only takes out and updates the streams that are due, instead of visiting every stream
+ * at every iteration.
+ *
+ * The scheduled times are computed with the rate multiplier and main loop delay at the time of scheduling.
+ * A lower rate multiplier only makes a stream get visited too early, in which case update() does not send
+ * and the stream is scheduled again. A higher rate multiplier rebuilds the schedule.
+ */
+class MavlinkStreamScheduler
+{
+public:
+	MavlinkStreamScheduler() = default;
+	~MavlinkStreamScheduler();
+
+	// no copy, assignment, move, move assignment
+	MavlinkStreamScheduler(const MavlinkStreamScheduler &) = delete;
+	MavlinkStreamScheduler &operator=(const MavlinkStreamScheduler &) = delete;
+	MavlinkStreamScheduler(MavlinkStreamScheduler &&) = delete;
+	MavlinkStreamScheduler &operator=(MavlinkStreamScheduler &&) = delete;
+
+	/**
+	 * Mark the schedule as outdated. Needs to be called when a stream is added, removed or reconfigured.
+	 */
+	void invalidate() { _valid = false; }
+
+	/**
+	 * Rebuild the schedule from the list of streams if needed.
+	 *
+	 * @return false if the schedule could not be allocated, the caller then needs to update all streams
+	 */
+	bool update(List<MavlinkStream *> &streams, float rate_mult, unsigned main_loop_delay);
+
+	/**
+	 * Take all streams that are due at time t out of the schedule. Constant rate streams come first,
+	 * then the other streams ordered by their deadline. Each of them must be put back with
+	 * reschedule() or defer() before the next call to take_due().
+	 *
+	 * @return number of due streams
+	 */
+	unsigned take_due(hrt_abstime t);
+
+	MavlinkStream *due_stream(unsigned index) const { return _due[index].stream; }
+
+	/**
+	 * Schedule a due stream again after it was updated
+	 */
+	void reschedule(unsigned index);
+
+	/**
+	 * Put a due stream back without updating it. It keeps its deadline, so it is due again at the next iteration.
+	 */
+	void defer(unsigned index) { push(_due[index]); }
+
+	unsigned size() const { return _size; }
+
+private:
+	struct Entry {
+		hrt_abstime time;
+		MavlinkStream *stream;
+	};
+
+	void push(const Entry &entry);
+	Entry pop();
+
+	Entry *_heap{nullptr};
+	Entry *_due{nullptr};
+	unsigned _capacity{0};
+	unsigned _size{0};
+
+	float _rate_mult{1.f}; ///< current rate multiplier
+	float _rate_mult_min{1.f}; ///< lowest rate multiplier used for the scheduled times
+	unsigned _main_loop_delay{0};
+	bool _valid{false};
+};
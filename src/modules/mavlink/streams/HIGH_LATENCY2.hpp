@@ -77,6 +77,8 @@ public:
 
 	bool const_rate() override { return true; }
 
+	bool update_data_required() override { return true; }
+
 private:
 	explicit MavlinkStreamHighLatency2(Mavlink *mavlink) :
 		MavlinkStream(mavlink),
@@ -75,6 +75,22 @@ public:
 		}
 	}
 
+	bool arePointsInsidePolygonOrCircle(const matrix::Vector2<double> *lat_lon, const float *altitude, bool *inside,
+					    int num_points) override
+	{
+		bool all_inside = true;
+
+		for (int i = 0; i < num_points; ++i) {
+			inside[i] = isInsidePolygonOrCircle(lat_lon[i](0), lat_lon[i](1), altitude[i]);
+			all_inside &= inside[i];
+		}
+
+		return all_inside;
+	}
+
+	// no distance information, the probe functions have to be used
+	float distanceToBoundary(double lat, double lon) override { return 0.f; }
+
 	enum class ProbeFunction {
 		ALL_POINTS_OUTSIDE = 0,
 		LEFT_INSIDE_RIGHT_OUTSIDE,
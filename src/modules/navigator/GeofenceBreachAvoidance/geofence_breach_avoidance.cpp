@@ -107,19 +107,19 @@ GeofenceBreachAvoidance::generateLoiterPointForFixedWing(geofence_violation_type
 		const float bearing_90_right = matrix::wrap_2pi(_test_point_bearing + M_PI_F * 0.5f);
 
 		double loiter_center_lat, loiter_center_lon;
-		double fence_violation_test_point_lat, fence_violation_test_point_lon;
 
-		waypoint_from_heading_and_distance(_current_pos_lat_lon(0), _current_pos_lat_lon(1), bearing_90_left,
-						   _test_point_distance, &fence_violation_test_point_lat, &fence_violation_test_point_lon);
+		// test points on the left and on the right side, checked in one batch
+		const Vector2d test_points[2] {
+			waypointFromBearingAndDistance(_current_pos_lat_lon, bearing_90_left, _test_point_distance),
+			waypointFromBearingAndDistance(_current_pos_lat_lon, bearing_90_right, _test_point_distance)
+		};
+		const float test_point_altitudes[2] {_current_alt_amsl, _current_alt_amsl};
+		bool inside_fence[2];
 
-		const bool left_side_is_inside_fence = geofence->isInsidePolygonOrCircle(fence_violation_test_point_lat,
-						       fence_violation_test_point_lon, _current_alt_amsl);
+		geofence->arePointsInsidePolygonOrCircle(test_points, test_point_altitudes, inside_fence, 2);
 
-		waypoint_from_heading_and_distance(_current_pos_lat_lon(0), _current_pos_lat_lon(1), bearing_90_right,
-						   _test_point_distance, &fence_violation_test_point_lat, &fence_violation_test_point_lon);
-
-		const bool right_side_is_inside_fence = geofence->isInsidePolygonOrCircle(fence_violation_test_point_lat,
-							fence_violation_test_point_lon, _current_alt_amsl);
+		const bool left_side_is_inside_fence = inside_fence[0];
+		const bool right_side_is_inside_fence = inside_fence[1];
 
 		float bearing_to_loiter_point;
 
@@ -152,11 +152,20 @@ GeofenceBreachAvoidance::generateLoiterPointForMultirotor(geofence_violation_typ
 {
 
 	if (violation_type.flags.fence_violation) {
-		float current_distance = _test_point_distance * 0.5f;
 		float current_min = 0.0f;
 		float current_max = _test_point_distance;
 		Vector2d test_point;
 
+		// the fence boundary is not closer than its distance in any direction, which bounds the search from below
+		const float distance_to_boundary = geofence->distanceToBoundary(_current_pos_lat_lon(0), _current_pos_lat_lon(1));
+
+		if (distance_to_boundary > 0.f && PX4_ISFINITE(distance_to_boundary)
+		    && geofence->isInsidePolygonOrCircle(_current_pos_lat_lon(0), _current_pos_lat_lon(1), _current_alt_amsl)) {
+			current_min = math::min(distance_to_boundary, current_max);
+		}
+
+		float current_distance = (current_max + current_min) * 0.5f;
+
 		// binary search for the distance from the drone to the geofence in the given direction
 		while (fabsf(current_max - current_min) > 0.5f) {
 			test_point = waypointFromBearingAndDistance(_current_pos_lat_lon, _test_point_bearing, current_distance);
@@ -0,0 +1,403 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "GeofenceIndex.hpp"
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include <mathlib/mathlib.h>
+
+using matrix::Vector2f;
+
+GeofenceIndex::~GeofenceIndex()
+{
+	for (int i = 0; i < _num_shapes; ++i) {
+		freeIndex(_shapes[i]);
+	}
+
+	delete[] _shapes;
+	delete[] _vertices;
+}
+
+bool GeofenceIndex::reset(int max_shapes, int max_vertices)
+{
+	for (int i = 0; i < _num_shapes; ++i) {
+		freeIndex(_shapes[i]);
+	}
+
+	_num_shapes = 0;
+	_num_vertices = 0;
+
+	if (max_shapes > _max_shapes) {
+		delete[] _shapes;
+		_shapes = new Shape[max_shapes];
+		_max_shapes = _shapes ? max_shapes : 0;
+	}
+
+	if (max_vertices > _max_vertices) {
+		delete[] _vertices;
+		_vertices = new Vector2f[max_vertices];
+		_max_vertices = _vertices ? max_vertices : 0;
+	}
+
+	return max_shapes <= _max_shapes && max_vertices <= _max_vertices;
+}
+
+int GeofenceIndex::addPolygon(const Vector2f *vertices, int num_vertices, bool inclusion)
+{
+	if (_num_shapes >= _max_shapes || num_vertices < 1 || num_vertices > UINT16_MAX
+	    || num_vertices > _max_vertices - _num_vertices) {
+		return -1;
+	}
+
+	Shape &shape = _shapes[_num_shapes];
+	shape.first_vertex = _num_vertices;
+	shape.num_vertices = num_vertices;
+	shape.inclusion = inclusion;
+	shape.min = vertices[0];
+	shape.max = vertices[0];
+
+	for (int i = 0; i < num_vertices; ++i) {
+		_vertices[_num_vertices + i] = vertices[i];
+		shape.min = matrix::min(shape.min, vertices[i]);
+		shape.max = matrix::max(shape.max, vertices[i]);
+	}
+
+	if (!buildIndex(shape)) {
+		return -1;
+	}
+
+	_num_vertices += num_vertices;
+	return _num_shapes++;
+}
+
+int GeofenceIndex::addCircle(const Vector2f &center, float radius, bool inclusion)
+{
+	if (_num_shapes >= _max_shapes) {
+		return -1;
+	}
+
+	Shape &shape = _shapes[_num_shapes];
+	shape.first_vertex = _num_vertices;
+	shape.num_vertices = 0;
+	shape.inclusion = inclusion;
+	shape.center = center;
+	shape.radius = radius;
+	shape.min = center - Vector2f(radius, radius);
+	shape.max = center + Vector2f(radius, radius);
+	shape.band_start = nullptr;
+	shape.band_edges = nullptr;
+	shape.cell_start = nullptr;
+	shape.cell_edges = nullptr;
+
+	return _num_shapes++;
+}
+
+void GeofenceIndex::removeLastShape()
+{
+	if (_num_shapes > 0) {
+		Shape &shape = _shapes[--_num_shapes];
+		_num_vertices -= shape.num_vertices;
+		freeIndex(shape);
+	}
+}
+
+void GeofenceIndex::freeIndex(Shape &shape)
+{
+	delete[] shape.band_start;
+	delete[] shape.band_edges;
+	delete[] shape.cell_start;
+	delete[] shape.cell_edges;
+	shape.band_start = nullptr;
+	shape.band_edges = nullptr;
+	shape.cell_start = nullptr;
+	shape.cell_edges = nullptr;
+}
+
+int GeofenceIndex::band(const Shape &shape, float y) const
+{
+	return math::constrain(static_cast<int>((y - shape.min(1)) / shape.cell_size(1)), 0, shape.grid_size - 1);
+}
+
+int GeofenceIndex::column(const Shape &shape, float x) const
+{
+	return math::constrain(static_cast<int>((x - shape.min(0)) / shape.cell_size(0)), 0, shape.grid_size - 1);
+}
+
+bool GeofenceIndex::buildIndex(Shape &shape)
+{
+	const int n = shape.num_vertices;
+	const Vector2f *vertices = &_vertices[shape.first_vertex];
+	const int grid_size = math::constrain(static_cast<int>(ceilf(sqrtf(n))), 1, MAX_GRID_SIZE);
+	const int num_cells = grid_size * grid_size;
+
+	shape.grid_size = grid_size;
+	shape.cell_size = matrix::max(Vector2f((shape.max - shape.min) / static_cast<float>(grid_size)), 0.01f);
+	shape.band_start = new uint32_t[grid_size + 1];
+	shape.cell_start = new uint32_t[num_cells + 1];
+	shape.band_edges = nullptr;
+	shape.cell_edges = nullptr;
+
+	if (!shape.band_start || !shape.cell_start) {
+		freeIndex(shape);
+		return false;
+	}
+
+	// first pass counts the edges of each band and cell, the second one stores them
+	for (int pass = 0; pass < 2; ++pass) {
+		if (pass == 0) {
+			memset(shape.band_start, 0, (grid_size + 1) * sizeof(uint32_t));
+			memset(shape.cell_start, 0, (num_cells + 1) * sizeof(uint32_t));
+
+		} else {
+			// turn the counts into offsets, then the stored edges advance the offsets back into place
+			for (int i = 0; i < grid_size; ++i) {
+				shape.band_start[i + 1] += shape.band_start[i];
+			}
+
+			for (int i = 0; i < num_cells; ++i) {
+				shape.cell_start[i + 1] += shape.cell_start[i];
+			}
+
+			shape.band_edges = new uint16_t[shape.band_start[grid_size]];
+			shape.cell_edges = new uint16_t[shape.cell_start[num_cells]];
+
+			if (!shape.band_edges || !shape.cell_edges) {
+				freeIndex(shape);
+				return false;
+			}
+
+			memmove(shape.band_start + 1, shape.band_start, grid_size * sizeof(uint32_t));
+			memmove(shape.cell_start + 1, shape.cell_start, num_cells * sizeof(uint32_t));
+			shape.band_start[0] = 0;
+			shape.cell_start[0] = 0;
+		}
+
+		for (int edge = 0; edge < n; ++edge) {
+			const Vector2f &a = vertices[edge];
+			const Vector2f &b = vertices[(edge + 1) % n];
+			const float y_min = math::min(a(1), b(1));
+			const float y_max = math::max(a(1), b(1));
+			const int band_min = band(shape, y_min);
+			const int band_max = band(shape, y_max);
+
+			for (int j = band_min; j <= band_max; ++j) {
+				if (pass == 0) {
+					++shape.band_start[j + 1];
+
+				} else {
+					shape.band_edges[shape.band_start[j + 1]++] = edge;
+				}
+
+				// x range of the edge within the band, padded against rounding
+				float x_min = math::min(a(0), b(0));
+				float x_max = math::max(a(0), b(0));
+
+				if (fabsf(b(1) - a(1)) > FLT_EPSILON) {
+					const float y0 = math::constrain(shape.min(1) + j * shape.cell_size(1), y_min, y_max);
+					const float y1 = math::constrain(shape.min(1) + (j + 1) * shape.cell_size(1), y_min, y_max);
+					const float x0 = a(0) + (y0 - a(1)) * (b(0) - a(0)) / (b(1) - a(1));
+					const float x1 = a(0) + (y1 - a(1)) * (b(0) - a(0)) / (b(1) - a(1));
+					x_min = math::max(math::min(x0, x1), x_min);
+					x_max = math::min(math::max(x0, x1), x_max);
+				}
+
+				const float padding = 0.01f * shape.cell_size(0);
+				const int column_max = column(shape, x_max + padding);
+
+				for (int i = column(shape, x_min - padding); i <= column_max; ++i) {
+					const int cell = j * grid_size + i;
+
+					if (pass == 0) {
+						++shape.cell_start[cell + 1];
+
+					} else {
+						shape.cell_edges[shape.cell_start[cell + 1]++] = edge;
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool GeofenceIndex::insidePolygon(const Shape &shape, const Vector2f &pos) const
+{
+	if (pos(0) < shape.min(0) || pos(0) > shape.max(0) || pos(1) < shape.min(1) || pos(1) > shape.max(1)) {
+		return false;
+	}
+
+	/**
+	 * Adaptation of algorithm originally presented as
+	 * PNPOLY - Point Inclusion in Polygon Test
+	 * W. Randolph Franklin (WRF)
+	 * Only supports non-complex polygons (not self intersecting)
+	 * Only the edges overlapping the band of the position can cross the ray.
+	 */
+	const Vector2f *vertices = &_vertices[shape.first_vertex];
+	const int j = band(shape, pos(1));
+	bool c = false;
+
+	for (uint32_t k = shape.band_start[j]; k < shape.band_start[j + 1]; ++k) {
+		const int edge = shape.band_edges[k];
+		const Vector2f &a = vertices[edge];
+		const Vector2f &b = vertices[(edge + 1) % shape.num_vertices];
+
+		if ((a(1) > pos(1)) != (b(1) > pos(1)) &&
+		    (pos(0) < (b(0) - a(0)) * (pos(1) - a(1)) / (b(1) - a(1)) + a(0))) {
+			c = !c;
+		}
+	}
+
+	return c;
+}
+
+bool GeofenceIndex::insideShape(int shape_index, const Vector2f &pos) const
+{
+	const Shape &shape = _shapes[shape_index];
+
+	if (shape.num_vertices == 0) {
+		return Vector2f(pos - shape.center).norm_squared() < shape.radius * shape.radius;
+	}
+
+	return insidePolygon(shape, pos);
+}
+
+bool GeofenceIndex::inside(const Vector2f &pos) const
+{
+	for (int i = 0; i < _num_shapes; ++i) {
+		if (insideShape(i, pos) != _shapes[i].inclusion) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool GeofenceIndex::inside(const Vector2f *pos, bool *result, int num_points) const
+{
+	for (int k = 0; k < num_points; ++k) {
+		result[k] = true;
+	}
+
+	int num_inside = num_points;
+
+	for (int i = 0; i < _num_shapes && num_inside > 0; ++i) {
+		for (int k = 0; k < num_points; ++k) {
+			if (result[k] && insideShape(i, pos[k]) != _shapes[i].inclusion) {
+				result[k] = false;
+				--num_inside;
+			}
+		}
+	}
+
+	return num_inside == num_points;
+}
+
+float GeofenceIndex::distanceToEdge(const Shape &shape, int edge, const Vector2f &pos) const
+{
+	const Vector2f &a = _vertices[shape.first_vertex + edge];
+	const Vector2f &b = _vertices[shape.first_vertex + (edge + 1) % shape.num_vertices];
+	const Vector2f ab = b - a;
+	const float length_squared = ab.norm_squared();
+	float t = 0.f;
+
+	if (length_squared > FLT_EPSILON) {
+		t = math::constrain(Vector2f(pos - a).dot(ab) / length_squared, 0.f, 1.f);
+	}
+
+	return Vector2f(pos - (a + ab * t)).norm();
+}
+
+float GeofenceIndex::distanceToPolygon(const Shape &shape, const Vector2f &pos, float best) const
+{
+	const int grid_size = shape.grid_size;
+	const int column_pos = column(shape, pos(0));
+	const int band_pos = band(shape, pos(1));
+	const float min_cell_size = math::min(shape.cell_size(0), shape.cell_size(1));
+
+	// distance to the bounding box, 0 if inside
+	const Vector2f outside = matrix::max(matrix::max(Vector2f(shape.min - pos), Vector2f(pos - shape.max)), 0.f);
+	const float distance_to_box = outside.norm();
+
+	// search the cells in growing rings around the cell of the position, until
+	// the ring is further away than the closest edge found so far
+	for (int ring = 0; ring < grid_size; ++ring) {
+		if (math::max(distance_to_box, (ring - 1) * min_cell_size) >= best) {
+			break;
+		}
+
+		const int j_min = math::max(band_pos - ring, 0);
+		const int j_max = math::min(band_pos + ring, grid_size - 1);
+
+		for (int j = j_min; j <= j_max; ++j) {
+			const bool full_row = (j == band_pos - ring) || (j == band_pos + ring);
+			const int step = full_row ? 1 : 2 * ring;
+
+			for (int i = column_pos - ring; i <= column_pos + ring; i += step) {
+				if (i < 0 || i >= grid_size) {
+					continue;
+				}
+
+				const int cell = j * grid_size + i;
+
+				for (uint32_t k = shape.cell_start[cell]; k < shape.cell_start[cell + 1]; ++k) {
+					best = math::min(best, distanceToEdge(shape, shape.cell_edges[k], pos));
+				}
+			}
+		}
+	}
+
+	return best;
+}
+
+float GeofenceIndex::distanceToBoundary(const Vector2f &pos) const
+{
+	float best = INFINITY;
+
+	for (int i = 0; i < _num_shapes; ++i) {
+		const Shape &shape = _shapes[i];
+
+		if (shape.num_vertices == 0) {
+			best = math::min(best, fabsf(Vector2f(pos - shape.center).norm() - shape.radius));
+
+		} else {
+			best = distanceToPolygon(shape, pos, best);
+		}
+	}
+
+	return best;
+}
@@ -0,0 +1,157 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file GeofenceIndex.hpp
+ * RAM-resident geofence in a local frame, with spatial indices for fast
+ * inclusion and distance to boundary queries.
+ *
+ * The polygon edges are sorted into horizontal bands for the inclusion test
+ * (crossing number), and into a grid of cells for the distance query, which
+ * searches the cells in rings around the query point.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <matrix/math.hpp>
+
+class GeofenceIndex
+{
+public:
+	GeofenceIndex() = default;
+	~GeofenceIndex();
+
+	GeofenceIndex(const GeofenceIndex &) = delete;
+	GeofenceIndex &operator=(const GeofenceIndex &) = delete;
+
+	/**
+	 * Remove all shapes and allocate storage
+	 * @param max_shapes maximum number of polygons and circles
+	 * @param max_vertices maximum number of polygon vertices in total
+	 * @return false if the allocation failed
+	 */
+	bool reset(int max_shapes, int max_vertices);
+
+	/**
+	 * Add a polygon (not self intersecting)
+	 * @param vertices local position [m]
+	 * @param inclusion true for an inclusion, false for an exclusion polygon
+	 * @return index of the shape, -1 if the storage is full or the allocation failed
+	 */
+	int addPolygon(const matrix::Vector2f *vertices, int num_vertices, bool inclusion);
+
+	/**
+	 * Add a circle
+	 * @param center local position [m]
+	 * @param inclusion true for an inclusion, false for an exclusion circle
+	 * @return index of the shape, -1 if the storage is full
+	 */
+	int addCircle(const matrix::Vector2f &center, float radius, bool inclusion);
+
+	/**
+	 * Remove the shape that was added last
+	 */
+	void removeLastShape();
+
+	int numShapes() const { return _num_shapes; }
+	int numVertices() const { return _num_vertices; }
+	bool isCircle(int shape) const { return _shapes[shape].num_vertices == 0; }
+	bool isInclusion(int shape) const { return _shapes[shape].inclusion; }
+	int vertexCount(int shape) const { return _shapes[shape].num_vertices; }
+
+	/**
+	 * @return true if the position is inside a single shape, regardless of its inclusion type
+	 */
+	bool insideShape(int shape, const matrix::Vector2f &pos) const;
+
+	/**
+	 * @return true if the position is inside all inclusion shapes and outside all exclusion shapes
+	 */
+	bool inside(const matrix::Vector2f &pos) const;
+
+	/**
+	 * Batched inside(), the shapes are iterated in the outer loop.
+	 * @param result set to inside() for each position
+	 * @return true if all positions are inside
+	 */
+	bool inside(const matrix::Vector2f *pos, bool *result, int num_points) const;
+
+	/**
+	 * @return horizontal distance to the closest shape boundary [m], INFINITY without shapes
+	 */
+	float distanceToBoundary(const matrix::Vector2f &pos) const;
+
+private:
+	static constexpr int MAX_GRID_SIZE = 32;
+
+	struct Shape {
+		matrix::Vector2f min; ///< bounding box
+		matrix::Vector2f max;
+
+		int first_vertex;
+		int num_vertices; ///< 0 for a circle
+		bool inclusion;
+
+		// circle
+		matrix::Vector2f center;
+		float radius;
+
+		// polygon index: edge i goes from vertex i to vertex i + 1 (cyclic)
+		int grid_size; ///< number of bands and of cells per band
+		matrix::Vector2f cell_size;
+		uint32_t *band_start; ///< grid_size + 1 offsets into band_edges
+		uint16_t *band_edges; ///< edges overlapping a band in y
+		uint32_t *cell_start; ///< grid_size * grid_size + 1 offsets into cell_edges
+		uint16_t *cell_edges; ///< edges overlapping a cell
+	};
+
+	bool buildIndex(Shape &shape);
+	static void freeIndex(Shape &shape);
+
+	int band(const Shape &shape, float y) const;
+	int column(const Shape &shape, float x) const;
+
+	bool insidePolygon(const Shape &shape, const matrix::Vector2f &pos) const;
+	/** @return the distance to the polygon boundary if closer than best, best otherwise */
+	float distanceToPolygon(const Shape &shape, const matrix::Vector2f &pos, float best) const;
+	float distanceToEdge(const Shape &shape, int edge, const matrix::Vector2f &pos) const;
+
+	Shape *_shapes{nullptr};
+	int _max_shapes{0};
+	int _num_shapes{0};
+
+	matrix::Vector2f *_vertices{nullptr};
+	int _max_vertices{0};
+	int _num_vertices{0};
+};
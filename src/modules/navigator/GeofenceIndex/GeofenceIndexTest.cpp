@@ -0,0 +1,260 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+
+#include "GeofenceIndex.hpp"
+
+#include <mathlib/mathlib.h>
+
+using matrix::Vector2f;
+
+// brute force reference: PNPOLY over all edges, in the same arithmetic as the index
+static bool insidePolygonReference(const Vector2f *vertices, int n, const Vector2f &pos)
+{
+	bool c = false;
+
+	for (int i = 0, j = n - 1; i < n; j = i++) {
+		const Vector2f &a = vertices[j];
+		const Vector2f &b = vertices[i];
+
+		if ((a(1) > pos(1)) != (b(1) > pos(1)) &&
+		    (pos(0) < (b(0) - a(0)) * (pos(1) - a(1)) / (b(1) - a(1)) + a(0))) {
+			c = !c;
+		}
+	}
+
+	return c;
+}
+
+static float distanceToPolygonReference(const Vector2f *vertices, int n, const Vector2f &pos)
+{
+	float best = INFINITY;
+
+	for (int i = 0; i < n; ++i) {
+		const Vector2f &a = vertices[i];
+		const Vector2f ab = vertices[(i + 1) % n] - a;
+		const float t = math::constrain(Vector2f(pos - a).dot(ab) / ab.norm_squared(), 0.f, 1.f);
+		best = math::min(best, Vector2f(pos - (a + ab * t)).norm());
+	}
+
+	return best;
+}
+
+// star shaped (hence simple) polygon with a random radius per vertex
+static void randomPolygon(std::mt19937 &gen, const Vector2f &center, float radius, Vector2f *vertices, int n)
+{
+	std::uniform_real_distribution<float> radius_dist(0.2f * radius, radius);
+
+	for (int i = 0; i < n; ++i) {
+		const float angle = 2.f * M_PI_F * i / n;
+		const float r = radius_dist(gen);
+		vertices[i] = center + Vector2f(r * cosf(angle), r * sinf(angle));
+	}
+}
+
+TEST(GeofenceIndexTest, EmptyFence)
+{
+	GeofenceIndex index;
+	EXPECT_TRUE(index.inside(Vector2f(1.f, 2.f)));
+	EXPECT_FALSE(PX4_ISFINITE(index.distanceToBoundary(Vector2f(1.f, 2.f))));
+}
+
+TEST(GeofenceIndexTest, PolygonMatchesReference)
+{
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<float> pos_dist(-1200.f, 1200.f);
+
+	for (int n : {3, 4, 7, 50, 500}) {
+		Vector2f vertices[500];
+		randomPolygon(gen, Vector2f(10.f, -20.f), 1000.f, vertices, n);
+
+		GeofenceIndex index;
+		ASSERT_TRUE(index.reset(1, n));
+		ASSERT_EQ(index.addPolygon(vertices, n, true), 0);
+
+		for (int k = 0; k < 2000; ++k) {
+			const Vector2f pos(pos_dist(gen), pos_dist(gen));
+			EXPECT_EQ(index.insideShape(0, pos), insidePolygonReference(vertices, n, pos)) << n << " " << k;
+			EXPECT_NEAR(index.distanceToBoundary(pos), distanceToPolygonReference(vertices, n, pos), 1e-3f) << n << " " << k;
+		}
+
+		// the vertices themselves are on the boundary
+		EXPECT_NEAR(index.distanceToBoundary(vertices[n / 2]), 0.f, 1e-3f);
+	}
+}
+
+TEST(GeofenceIndexTest, DegeneratePolygon)
+{
+	// all vertices on a line: nothing is inside, but the distance is defined
+	const Vector2f vertices[] = {{0.f, 0.f}, {10.f, 0.f}, {20.f, 0.f}};
+	GeofenceIndex index;
+	ASSERT_TRUE(index.reset(1, 3));
+	ASSERT_EQ(index.addPolygon(vertices, 3, true), 0);
+
+	EXPECT_FALSE(index.inside(Vector2f(5.f, 0.f)));
+	EXPECT_NEAR(index.distanceToBoundary(Vector2f(5.f, 3.f)), 3.f, 1e-5f);
+	EXPECT_NEAR(index.distanceToBoundary(Vector2f(25.f, 0.f)), 5.f, 1e-5f);
+}
+
+TEST(GeofenceIndexTest, InclusionAndExclusion)
+{
+	// 100 x 100 m inclusion square with an exclusion circle and an exclusion triangle inside
+	const Vector2f square[] = {{0.f, 0.f}, {100.f, 0.f}, {100.f, 100.f}, {0.f, 100.f}};
+	const Vector2f triangle[] = {{60.f, 60.f}, {90.f, 60.f}, {60.f, 90.f}};
+
+	GeofenceIndex index;
+	ASSERT_TRUE(index.reset(3, 7));
+	EXPECT_EQ(index.addPolygon(square, 4, true), 0);
+	EXPECT_EQ(index.addCircle(Vector2f(25.f, 25.f), 10.f, false), 1);
+	EXPECT_EQ(index.addPolygon(triangle, 3, false), 2);
+	EXPECT_EQ(index.numShapes(), 3);
+	EXPECT_EQ(index.numVertices(), 7);
+	EXPECT_TRUE(index.isCircle(1));
+	EXPECT_FALSE(index.isInclusion(2));
+
+	EXPECT_TRUE(index.inside(Vector2f(50.f, 50.f)));
+	EXPECT_FALSE(index.inside(Vector2f(-1.f, 50.f)));
+	EXPECT_FALSE(index.inside(Vector2f(25.f, 30.f)));
+	EXPECT_FALSE(index.inside(Vector2f(65.f, 65.f)));
+	EXPECT_TRUE(index.inside(Vector2f(85.f, 85.f)));
+
+	EXPECT_NEAR(index.distanceToBoundary(Vector2f(50.f, 50.f)), sqrtf(200.f), 1e-4f); // triangle corner
+	EXPECT_NEAR(index.distanceToBoundary(Vector2f(25.f, 30.f)), 5.f, 1e-4f); // circle
+	EXPECT_NEAR(index.distanceToBoundary(Vector2f(-10.f, 50.f)), 10.f, 1e-4f); // square
+	EXPECT_NEAR(index.distanceToBoundary(Vector2f(97.f, 50.f)), 3.f, 1e-4f);
+
+	// the batched query matches the single ones
+	Vector2f points[50];
+	bool result[50];
+	std::mt19937 gen(2);
+	std::uniform_real_distribution<float> pos_dist(-10.f, 110.f);
+
+	for (Vector2f &point : points) {
+		point = Vector2f(pos_dist(gen), pos_dist(gen));
+	}
+
+	bool all_inside = index.inside(points, result, 50);
+	bool expect_all_inside = true;
+
+	for (int k = 0; k < 50; ++k) {
+		EXPECT_EQ(result[k], index.inside(points[k]));
+		expect_all_inside &= result[k];
+	}
+
+	EXPECT_EQ(all_inside, expect_all_inside);
+	EXPECT_TRUE(index.inside(points + 0, result, 0));
+
+	// the discarded triangle does not count anymore
+	index.removeLastShape();
+	EXPECT_EQ(index.numShapes(), 2);
+	EXPECT_EQ(index.numVertices(), 4);
+	EXPECT_TRUE(index.inside(Vector2f(65.f, 65.f)));
+}
+
+TEST(GeofenceIndexTest, Storage)
+{
+	const Vector2f square[] = {{0.f, 0.f}, {1.f, 0.f}, {1.f, 1.f}, {0.f, 1.f}};
+
+	GeofenceIndex index;
+	ASSERT_TRUE(index.reset(2, 6));
+	EXPECT_EQ(index.addPolygon(square, 4, true), 0);
+	EXPECT_EQ(index.addPolygon(square, 4, true), -1); // out of vertices
+	EXPECT_EQ(index.addCircle(Vector2f(), 1.f, true), 1);
+	EXPECT_EQ(index.addCircle(Vector2f(), 1.f, true), -1); // out of shapes
+
+	// reset keeps the larger storage
+	ASSERT_TRUE(index.reset(1, 4));
+	EXPECT_EQ(index.numShapes(), 0);
+	EXPECT_EQ(index.addPolygon(square, 4, true), 0);
+}
+
+TEST(GeofenceIndexTest, Timing)
+{
+	static constexpr int n = 500;
+	static constexpr int num_queries = 10000;
+	Vector2f vertices[n];
+	std::mt19937 gen(3);
+	randomPolygon(gen, Vector2f(), 1000.f, vertices, n);
+
+	GeofenceIndex index;
+	ASSERT_TRUE(index.reset(1, n));
+	ASSERT_EQ(index.addPolygon(vertices, n, true), 0);
+
+	std::uniform_real_distribution<float> pos_dist(-1000.f, 1000.f);
+	Vector2f queries[num_queries];
+
+	for (Vector2f &query : queries) {
+		query = Vector2f(pos_dist(gen), pos_dist(gen));
+	}
+
+	int num_inside = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for (const Vector2f &query : queries) {
+		num_inside += insidePolygonReference(vertices, n, query);
+	}
+
+	const std::chrono::duration<double, std::nano> reference_time = std::chrono::steady_clock::now() - start;
+	start = std::chrono::steady_clock::now();
+
+	for (const Vector2f &query : queries) {
+		num_inside -= index.inside(query);
+	}
+
+	const std::chrono::duration<double, std::nano> index_time = std::chrono::steady_clock::now() - start;
+	float distance_sum = 0.f;
+	start = std::chrono::steady_clock::now();
+
+	for (const Vector2f &query : queries) {
+		distance_sum += distanceToPolygonReference(vertices, n, query);
+	}
+
+	const std::chrono::duration<double, std::nano> reference_distance_time = std::chrono::steady_clock::now() - start;
+	start = std::chrono::steady_clock::now();
+
+	for (const Vector2f &query : queries) {
+		distance_sum -= index.distanceToBoundary(query);
+	}
+
+	const std::chrono::duration<double, std::nano> index_distance_time = std::chrono::steady_clock::now() - start;
+
+	printf("%i vertices, inside: %.0f ns (reference %.0f ns), distance: %.0f ns (reference %.0f ns)\n", n,
+	       index_time.count() / num_queries, reference_time.count() / num_queries,
+	       index_distance_time.count() / num_queries, reference_distance_time.count() / num_queries);
+
+	EXPECT_EQ(num_inside, 0);
+	EXPECT_NEAR(distance_sum / num_queries, 0.f, 1e-3f);
+}
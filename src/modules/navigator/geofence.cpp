@@ -74,6 +74,13 @@ static uint32_t crc32_for_fence_point(const mission_fence_point_s &fence_point,
 	return crc32part(u.raw, sizeof(u), prev_crc32);
 }
 
+static bool is_global_frame(uint8_t frame)
+{
+	// TODO: handle different frames
+	return frame == NAV_FRAME_GLOBAL || frame == NAV_FRAME_GLOBAL_INT || frame == NAV_FRAME_GLOBAL_RELATIVE_ALT
+	       || frame == NAV_FRAME_GLOBAL_RELATIVE_ALT_INT;
+}
+
 Geofence::Geofence(Navigator *navigator) :
 	ModuleParams(navigator),
 	_navigator(navigator)
@@ -85,13 +92,6 @@ Geofence::Geofence(Navigator *navigator) :
 	_geofence_status_pub.advertise();
 }
 
-Geofence::~Geofence()
-{
-	if (_polygons) {
-		delete[](_polygons);
-	}
-}
-
 void Geofence::run()
 {
 	bool success;
@@ -208,15 +208,30 @@ void Geofence::updateFence()
 void Geofence::_updateFence()
 {
 	mission_fence_point_s mission_fence_point;
-	bool is_circle_area = false;
+	const dm_item_t fence_dataman_id{static_cast<dm_item_t>(_stats.dataman_id)};
+
+	// compile the fence into the local frame of the first fence item: every item adds at most one vertex or shape
+	const int num_items = _dataman_cache.size();
+
+	if (!_fence_index.reset(num_items, num_items)) {
+		PX4_ERR("alloc failed");
+		return;
+	}
+
+	matrix::Vector2f *vertices = new matrix::Vector2f[math::max(num_items, 1)];
 
-	// iterate over all polygons and store their starting vertices
-	_num_polygons = 0;
+	if (!vertices) {
+		_fence_index.reset(0, 0);
+		PX4_ERR("alloc failed");
+		return;
+	}
+
+	bool projection_initialized = false;
 	int current_seq = 0;
 
-	while (current_seq < _dataman_cache.size()) {
+	while (current_seq < num_items) {
 
-		bool success = _dataman_cache.loadWait(static_cast<dm_item_t>(_stats.dataman_id), current_seq,
+		bool success = _dataman_cache.loadWait(fence_dataman_id, current_seq,
 						       reinterpret_cast<uint8_t *>(&mission_fence_point),
 						       sizeof(mission_fence_point_s));
 
@@ -225,6 +240,11 @@ void Geofence::_updateFence()
 			break;
 		}
 
+		const bool is_circle_area = (mission_fence_point.nav_cmd == NAV_CMD_FENCE_CIRCLE_INCLUSION
+					     || mission_fence_point.nav_cmd == NAV_CMD_FENCE_CIRCLE_EXCLUSION);
+		const int shape_seq = current_seq;
+		int shape = -1;
+
 		switch (mission_fence_point.nav_cmd) {
 		case NAV_CMD_FENCE_RETURN_POINT:
 			// TODO: do we need to store this?
@@ -233,60 +253,72 @@ void Geofence::_updateFence()
 
 		case NAV_CMD_FENCE_CIRCLE_INCLUSION:
 		case NAV_CMD_FENCE_CIRCLE_EXCLUSION:
-			is_circle_area = true;
-
-		/* FALLTHROUGH */
 		case NAV_CMD_FENCE_POLYGON_VERTEX_EXCLUSION:
 		case NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION:
 			if (!is_circle_area && mission_fence_point.vertex_count == 0) {
 				++current_seq; // avoid endless loop
 				PX4_ERR("Polygon with 0 vertices. Skipping");
+				break;
+			}
+
+			if (!projection_initialized) {
+				_projection_reference.initReference(mission_fence_point.lat, mission_fence_point.lon);
+				projection_initialized = true;
+			}
+
+			if (is_circle_area) {
+				if (is_global_frame(mission_fence_point.frame)) {
+					shape = _fence_index.addCircle(_projection_reference.project(mission_fence_point.lat, mission_fence_point.lon),
+								       mission_fence_point.circle_radius,
+								       mission_fence_point.nav_cmd == NAV_CMD_FENCE_CIRCLE_INCLUSION);
+
+				} else {
+					PX4_ERR("Frame type %i not supported", (int)mission_fence_point.frame);
+				}
+
+				current_seq += 1;
 
 			} else {
-				if (_polygons) {
-					// resize: this is somewhat inefficient, but we do not expect there to be many polygons
-					PolygonInfo *new_polygons = new PolygonInfo[_num_polygons + 1];
+				const int vertex_count = math::min((int)mission_fence_point.vertex_count, num_items - current_seq);
+				int num_vertices = 0;
+
+				for (; num_vertices < vertex_count; ++num_vertices) {
+					mission_fence_point_s vertex;
 
-					if (new_polygons) {
-						memcpy(new_polygons, _polygons, sizeof(PolygonInfo) * _num_polygons);
+					if (!_dataman_cache.loadWait(fence_dataman_id, current_seq + num_vertices,
+								     reinterpret_cast<uint8_t *>(&vertex), sizeof(mission_fence_point_s))) {
+						break;
 					}
 
-					delete[](_polygons);
-					_polygons = new_polygons;
+					if (!is_global_frame(vertex.frame)) {
+						PX4_ERR("Frame type %i not supported", (int)vertex.frame);
+						break;
+					}
 
-				} else {
-					_polygons = new PolygonInfo[1];
+					vertices[num_vertices] = _projection_reference.project(vertex.lat, vertex.lon);
 				}
 
-				if (!_polygons) {
-					_num_polygons = 0;
-					PX4_ERR("alloc failed");
-					return;
+				if (num_vertices == mission_fence_point.vertex_count) {
+					shape = _fence_index.addPolygon(vertices, num_vertices,
+									mission_fence_point.nav_cmd == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION);
 				}
 
-				PolygonInfo &polygon = _polygons[_num_polygons];
-				polygon.dataman_index = current_seq;
-				polygon.fence_type = mission_fence_point.nav_cmd;
+				current_seq += mission_fence_point.vertex_count;
+			}
 
-				if (is_circle_area) {
-					polygon.circle_radius = mission_fence_point.circle_radius;
-					current_seq += 1;
-
-				} else {
-					polygon.vertex_count = mission_fence_point.vertex_count;
-					current_seq += mission_fence_point.vertex_count;
-				}
+			if (shape < 0) {
+				PX4_ERR("Failed to load fence shape, seq: %i", shape_seq);
 
+			} else {
 				// check if requiremetns for Home location are met
-				const bool home_check_okay = checkHomeRequirementsForGeofence(polygon);
+				const bool home_check_okay = checkHomeRequirementsForGeofence(shape);
 
 				// check if current position is inside the fence and vehicle is armed
-				const bool current_position_check_okay = checkCurrentPositionRequirementsForGeofence(polygon);
-
-				// discard the polygon if at least one check fails by not incrementing the counter in that case
-				if (home_check_okay && current_position_check_okay) {
-					++_num_polygons;
+				const bool current_position_check_okay = checkCurrentPositionRequirementsForGeofence(shape);
 
+				// discard the polygon if at least one check fails
+				if (!home_check_okay || !current_position_check_okay) {
+					_fence_index.removeLastShape();
 				}
 			}
 
@@ -298,16 +330,17 @@ void Geofence::_updateFence()
 			break;
 		}
 	}
+
+	delete[] vertices;
 }
 
-bool Geofence::checkHomeRequirementsForGeofence(const PolygonInfo &polygon)
+bool Geofence::checkHomeRequirementsForGeofence(int shape)
 {
 	bool checks_pass = true;
 
 	if (_navigator->home_global_position_valid()) {
-		checks_pass = checkPointAgainstPolygonCircle(polygon, _navigator->get_home_position()->lat,
-				_navigator->get_home_position()->lon,
-				_navigator->get_home_position()->alt);
+		checks_pass = checkPointAgainstPolygonCircle(shape, _navigator->get_home_position()->lat,
+				_navigator->get_home_position()->lon);
 	}
 
 
@@ -320,14 +353,14 @@ bool Geofence::checkHomeRequirementsForGeofence(const PolygonInfo &polygon)
 	return checks_pass;
 }
 
-bool Geofence::checkCurrentPositionRequirementsForGeofence(const PolygonInfo &polygon)
+bool Geofence::checkCurrentPositionRequirementsForGeofence(int shape)
 {
 	bool checks_pass = true;
 
 	// do not allow upload of geofence if vehicle is flying and current geofence would be immediately violated
 	if (getGeofenceAction() != geofence_result_s::GF_ACTION_NONE && !_navigator->get_land_detected()->landed) {
-		checks_pass = checkPointAgainstPolygonCircle(polygon, _navigator->get_global_position()->lat,
-				_navigator->get_global_position()->lon, _navigator->get_global_position()->alt);
+		checks_pass = checkPointAgainstPolygonCircle(shape, _navigator->get_global_position()->lat,
+				_navigator->get_global_position()->lon);
 	}
 
 	if (!checks_pass) {
@@ -347,6 +380,21 @@ bool Geofence::checkPointAgainstAllGeofences(double lat, double lon, float altit
 	return inside_fence;
 }
 
+bool Geofence::checkPointsAgainstAllGeofences(const matrix::Vector2<double> *lat_lon, const float *altitude,
+		bool *inside, int num_points)
+{
+	bool all_inside = arePointsInsidePolygonOrCircle(lat_lon, altitude, inside, num_points);
+
+	for (int i = 0; i < num_points; ++i) {
+		if (inside[i]) {
+			inside[i] = isCloserThanMaxDistToHome(lat_lon[i](0), lat_lon[i](1), altitude[i]) && isBelowMaxAltitude(altitude[i]);
+			all_inside &= inside[i];
+		}
+	}
+
+	return all_inside;
+}
+
 bool Geofence::isCloserThanMaxDistToHome(double lat, double lon, float altitude)
 {
 	bool inside_fence = true;
@@ -392,113 +440,62 @@ bool Geofence::isInsidePolygonOrCircle(double lat, double lon, float altitude)
 		}
 	}
 
-	/* Horizontal check: iterate all polygons & circles */
-	bool checksPass = true;
-
-	for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
-		checksPass &= checkPointAgainstPolygonCircle(_polygons[polygon_index], lat, lon, altitude);
-	}
-
-	return checksPass;
+	/* Horizontal check: all polygons & circles */
+	return _fence_index.inside(_projection_reference.project(lat, lon));
 }
 
-bool Geofence::checkPointAgainstPolygonCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
+bool Geofence::arePointsInsidePolygonOrCircle(const matrix::Vector2<double> *lat_lon, const float *altitude,
+		bool *inside, int num_points)
 {
-	bool checksPass = true;
-
-	if (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION) {
-		checksPass &= insideCircle(polygon, lat, lon, altitude);
-
-	} else if (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION) {
-		checksPass &= !insideCircle(polygon, lat, lon, altitude);
-
-	} else if (polygon.fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION) {
-		checksPass &= insidePolygon(polygon, lat, lon, altitude);
+	if (isEmpty()) {
+		/* Empty fence -> accept all points */
+		for (int i = 0; i < num_points; ++i) {
+			inside[i] = true;
+		}
 
-	} else if (polygon.fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_EXCLUSION) {
-		checksPass &= !insidePolygon(polygon, lat, lon, altitude);
+		return true;
 	}
 
-	return checksPass;
-}
-
-bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude)
-{
-	/**
-	 * Adaptation of algorithm originally presented as
-	 * PNPOLY - Point Inclusion in Polygon Test
-	 * W. Randolph Franklin (WRF)
-	 * Only supports non-complex polygons (not self intersecting)
-	 */
-
-	mission_fence_point_s temp_vertex_i{};
-	mission_fence_point_s temp_vertex_j{};
-	bool c = false;
+	/* Horizontal check: all polygons & circles, projected in chunks */
+	static constexpr int chunk_size = 16;
+	matrix::Vector2f local_position[chunk_size];
 
-	for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
+	for (int start = 0; start < num_points; start += chunk_size) {
+		const int count = math::min(num_points - start, chunk_size);
 
-		dm_item_t fence_dataman_id{static_cast<dm_item_t>(_stats.dataman_id)};
-		bool success = _dataman_cache.loadWait(fence_dataman_id, polygon.dataman_index + i,
-						       reinterpret_cast<uint8_t *>(&temp_vertex_i), sizeof(mission_fence_point_s));
-
-		if (!success) {
-			break;
+		for (int i = 0; i < count; ++i) {
+			local_position[i] = _projection_reference.project(lat_lon[start + i](0), lat_lon[start + i](1));
 		}
 
-		success = _dataman_cache.loadWait(fence_dataman_id, polygon.dataman_index + j,
-						  reinterpret_cast<uint8_t *>(&temp_vertex_j), sizeof(mission_fence_point_s));
+		_fence_index.inside(local_position, &inside[start], count);
+	}
 
-		if (!success) {
-			break;
-		}
+	/* Vertical check */
+	bool all_inside = true;
 
-		if (temp_vertex_i.frame != NAV_FRAME_GLOBAL && temp_vertex_i.frame != NAV_FRAME_GLOBAL_INT
-		    && temp_vertex_i.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
-		    && temp_vertex_i.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-			// TODO: handle different frames
-			PX4_ERR("Frame type %i not supported", (int)temp_vertex_i.frame);
-			break;
+	for (int i = 0; i < num_points; ++i) {
+		if (_altitude_max > _altitude_min) { // only enable vertical check if configured properly
+			inside[i] &= altitude[i] <= _altitude_max && altitude[i] >= _altitude_min;
 		}
 
-		if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-		    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-		     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
-			c = !c;
-		}
+		all_inside &= inside[i];
 	}
 
-	return c;
+	return all_inside;
 }
 
-bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
+float Geofence::distanceToBoundary(double lat, double lon)
 {
-
-	mission_fence_point_s circle_point{};
-	bool success = _dataman_cache.loadWait(static_cast<dm_item_t>(_stats.dataman_id), polygon.dataman_index,
-					       reinterpret_cast<uint8_t *>(&circle_point), sizeof(mission_fence_point_s));
-
-	if (!success) {
-		PX4_ERR("dm_read failed");
-		return false;
-	}
-
-	if (circle_point.frame != NAV_FRAME_GLOBAL && circle_point.frame != NAV_FRAME_GLOBAL_INT
-	    && circle_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
-	    && circle_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-		// TODO: handle different frames
-		PX4_ERR("Frame type %i not supported", (int)circle_point.frame);
-		return false;
+	if (isEmpty()) {
+		return INFINITY;
 	}
 
-	if (!_projection_reference.isInitialized()) {
-		_projection_reference.initReference(lat, lon);
-	}
+	return _fence_index.distanceToBoundary(_projection_reference.project(lat, lon));
+}
 
-	float x1, y1, x2, y2;
-	_projection_reference.project(lat, lon, x1, y1);
-	_projection_reference.project(circle_point.lat, circle_point.lon, x2, y2);
-	float dx = x1 - x2, dy = y1 - y2;
-	return dx * dx + dy * dy < circle_point.circle_radius * circle_point.circle_radius;
+bool Geofence::checkPointAgainstPolygonCircle(int shape, double lat, double lon)
+{
+	return _fence_index.insideShape(shape, _projection_reference.project(lat, lon)) == _fence_index.isInclusion(shape);
 }
 
 bool
@@ -669,30 +666,27 @@ bool Geofence::isHomeRequired()
 
 void Geofence::printStatus()
 {
-	int num_inclusion_polygons = 0, num_exclusion_polygons = 0, total_num_vertices = 0;
+	int num_inclusion_polygons = 0, num_exclusion_polygons = 0;
 	int num_inclusion_circles = 0, num_exclusion_circles = 0;
 
-	for (int i = 0; i < _num_polygons; ++i) {
-		total_num_vertices += _polygons[i].vertex_count;
+	for (int i = 0; i < _fence_index.numShapes(); ++i) {
+		if (_fence_index.isCircle(i)) {
+			if (_fence_index.isInclusion(i)) {
+				++num_inclusion_circles;
 
-		if (_polygons[i].fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION) {
+			} else {
+				++num_exclusion_circles;
+			}
+
+		} else if (_fence_index.isInclusion(i)) {
 			++num_inclusion_polygons;
-		}
 
-		if (_polygons[i].fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_EXCLUSION) {
+		} else {
 			++num_exclusion_polygons;
 		}
-
-		if (_polygons[i].fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION) {
-			++num_inclusion_circles;
-		}
-
-		if (_polygons[i].fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION) {
-			++num_exclusion_circles;
-		}
 	}
 
 	PX4_INFO("Geofence: %i inclusion, %i exclusion polygons, %i inclusion circles, %i exclusion circles, %i total vertices",
 		 num_inclusion_polygons, num_exclusion_polygons, num_inclusion_circles, num_exclusion_circles,
-		 total_num_vertices);
+		 _fence_index.numVertices());
 }
@@ -54,6 +54,8 @@
 #include <uORB/topics/vehicle_global_position.h>
 #include <uORB/topics/sensor_gps.h>
 
+#include "GeofenceIndex/GeofenceIndex.hpp"
+
 #define GEOFENCE_FILENAME PX4_STORAGEDIR"/etc/geofence.txt"
 
 class Navigator;
@@ -64,7 +66,7 @@ public:
 	Geofence(Navigator *navigator);
 	Geofence(const Geofence &) = delete;
 	Geofence &operator=(const Geofence &) = delete;
-	virtual ~Geofence();
+	virtual ~Geofence() = default;
 
 	/* Source, corresponding to the param GF_SOURCE */
 	enum {
@@ -109,6 +111,27 @@ public:
 
 	virtual bool isInsidePolygonOrCircle(double lat, double lon, float altitude);
 
+	/**
+	 * Batched isInsidePolygonOrCircle(), e.g. for the points of a trajectory
+	 * @param inside set for each point
+	 * @return true if all points are inside
+	 */
+	virtual bool arePointsInsidePolygonOrCircle(const matrix::Vector2<double> *lat_lon, const float *altitude,
+			bool *inside, int num_points);
+
+	/**
+	 * Batched checkPointAgainstAllGeofences()
+	 * @param inside set for each point
+	 * @return true if all points pass
+	 */
+	bool checkPointsAgainstAllGeofences(const matrix::Vector2<double> *lat_lon, const float *altitude, bool *inside,
+					    int num_points);
+
+	/**
+	 * @return horizontal distance to the closest polygon or circle boundary [m], INFINITY for an empty fence
+	 */
+	virtual float distanceToBoundary(double lat, double lon);
+
 	bool valid();
 
 	/**
@@ -132,7 +155,7 @@ public:
 	 */
 	int loadFromFile(const char *filename);
 
-	bool isEmpty() { return (!_fence_updated || (_num_polygons == 0)); }
+	bool isEmpty() { return (!_fence_updated || (_fence_index.numShapes() == 0)); }
 
 	int getSource() { return _param_gf_source.get(); }
 	int getGeofenceAction() { return _param_gf_action.get(); }
@@ -157,17 +180,7 @@ private:
 		Error
 	};
 
-	struct PolygonInfo {
-		uint16_t fence_type; ///< one of MAV_CMD_NAV_FENCE_* (can also be a circular region)
-		uint16_t dataman_index;
-		union {
-			uint16_t vertex_count;
-			float circle_radius;
-		};
-	};
-
 	Navigator   *_navigator{nullptr};
-	PolygonInfo *_polygons{nullptr};
 
 	mission_stats_entry_s _stats;
 	DatamanState _dataman_state{DatamanState::UpdateRequestWait};
@@ -178,7 +191,7 @@ private:
 	float _altitude_min{0.0f};
 	float _altitude_max{0.0f};
 
-	int _num_polygons{0};
+	GeofenceIndex _fence_index; ///< polygons and circles in the local frame of _projection_reference
 
 	MapProjection _projection_reference{}; ///< class to convert (lon, lat) to local [m]
 
@@ -195,36 +208,22 @@ private:
 
 
 	/**
-	 * Check if a single point is within a polygon
-	 * @return true if within polygon
-	 */
-	bool insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude);
-
-	/**
-	 * Check if a single point is within a circle
-	 * @param polygon must be a circle!
-	 * @return true if within polygon the circle
+	 * Check if a single point passes a single polygon or circle of _fence_index
+	 * @return true if within an inclusion or outside an exclusion shape
 	 */
-	bool insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude);
-
-	/**
-	 * Check if a single point is within a polygon or circle
-	 * @return true if within polygon or circle
-	 */
-
-	bool checkPointAgainstPolygonCircle(const PolygonInfo &polygon, double lat, double lon, float altitude);
+	bool checkPointAgainstPolygonCircle(int shape, double lat, double lon);
 
 	/**
 	 * Check polygon or circle geofence fullfills the requirements relative to Home.
 	 * @return true if checks pass
 	 */
-	bool checkHomeRequirementsForGeofence(const PolygonInfo &polygon);
+	bool checkHomeRequirementsForGeofence(int shape);
 
 	/**
 	 * Check polygon or circle geofence fullfills the requirements relative to the current vehicle position.
 	 * @return true if checks pass
 	 */
-	bool checkCurrentPositionRequirementsForGeofence(const PolygonInfo &polygon);
+	bool checkCurrentPositionRequirementsForGeofence(int shape);
 
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::GF_ACTION>)         _param_gf_action,
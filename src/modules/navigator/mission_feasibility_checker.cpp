@@ -117,6 +117,12 @@ MissionFeasibilityChecker::checkMissionAgainstGeofence(const mission_s &mission,
 
 	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
 	if (_navigator->get_geofence().valid()) {
+		// the positions are collected and checked in batches
+		matrix::Vector2<double> lat_lon[GEOFENCE_BATCH_SIZE];
+		float altitude[GEOFENCE_BATCH_SIZE];
+		size_t item_index[GEOFENCE_BATCH_SIZE];
+		int num_positions = 0;
+
 		for (size_t i = 0; i < mission.count; i++) {
 			struct mission_item_s missionitem = {};
 
@@ -130,6 +136,11 @@ MissionFeasibilityChecker::checkMissionAgainstGeofence(const mission_s &mission,
 			}
 
 			if (missionitem.altitude_is_relative && !home_valid) {
+				// violations of the previous items take precedence
+				if (!checkPositionsAgainstGeofence(lat_lon, altitude, item_index, num_positions)) {
+					return false;
+				}
+
 				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
 				events::send(events::ID("navigator_mis_geofence_no_home2"), {events::Log::Error, events::LogInternal::Info},
 					     "Geofence requires a valid home position");
@@ -139,17 +150,46 @@ MissionFeasibilityChecker::checkMissionAgainstGeofence(const mission_s &mission,
 			// Geofence function checks against home altitude amsl
 			missionitem.altitude = missionitem.altitude_is_relative ? missionitem.altitude + home_alt : missionitem.altitude;
 
-			if (MissionBlock::item_contains_position(missionitem) && !_navigator->get_geofence().checkPointAgainstAllGeofences(
-				    missionitem.lat, missionitem.lon, missionitem.altitude)) {
+			if (MissionBlock::item_contains_position(missionitem)) {
+				lat_lon[num_positions] = matrix::Vector2<double>(missionitem.lat, missionitem.lon);
+				altitude[num_positions] = missionitem.altitude;
+				item_index[num_positions] = i;
+				++num_positions;
+			}
 
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %zu\t", i + 1);
-				events::send<int16_t>(events::ID("navigator_mis_geofence_violation"), {events::Log::Error, events::LogInternal::Info},
-						      "Geofence violation for waypoint {1}",
-						      i + 1);
-				return false;
+			if (num_positions == GEOFENCE_BATCH_SIZE || i + 1 == mission.count) {
+				if (!checkPositionsAgainstGeofence(lat_lon, altitude, item_index, num_positions)) {
+					return false;
+				}
+
+				num_positions = 0;
 			}
 		}
 	}
 
 	return true;
 }
+
+bool
+MissionFeasibilityChecker::checkPositionsAgainstGeofence(const matrix::Vector2<double> *lat_lon, const float *altitude,
+		const size_t *item_index, int num_positions)
+{
+	bool inside[GEOFENCE_BATCH_SIZE];
+
+	if (num_positions == 0
+	    || _navigator->get_geofence().checkPointsAgainstAllGeofences(lat_lon, altitude, inside, num_positions)) {
+		return true;
+	}
+
+	for (int i = 0; i < num_positions; ++i) {
+		if (!inside[i]) {
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %zu\t", item_index[i] + 1);
+			events::send<int16_t>(events::ID("navigator_mis_geofence_violation"), {events::Log::Error, events::LogInternal::Info},
+					      "Geofence violation for waypoint {1}",
+					      item_index[i] + 1);
+			break;
+		}
+	}
+
+	return false;
+}
@@ -43,6 +43,7 @@
 #pragma once
 
 #include <dataman_client/DatamanClient.hpp>
+#include <matrix/math.hpp>
 #include <uORB/topics/mission.h>
 #include <px4_platform_common/module_params.h>
 #include "MissionFeasibility/FeasibilityChecker.hpp"
@@ -58,6 +59,15 @@ private:
 
 	bool checkMissionAgainstGeofence(const mission_s &mission, float home_alt, bool home_valid);
 
+	static constexpr int GEOFENCE_BATCH_SIZE = 16; ///< number of mission item positions checked at once
+
+	/**
+	 * Check a batch of mission item positions against the geofence, report the first violation
+	 * @return false on a violation
+	 */
+	bool checkPositionsAgainstGeofence(const matrix::Vector2<double> *lat_lon, const float *altitude,
+					   const size_t *item_index, int num_positions);
+
 public:
 	MissionFeasibilityChecker(Navigator *navigator, DatamanClient &dataman_client) :
 		ModuleParams(nullptr),
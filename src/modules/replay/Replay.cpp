@@ -52,8 +52,10 @@
 #include <cstring>
 #include <float.h>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <math.h>
+#include <queue>
 #include <time.h>
 #include <sstream>
 #include <stdio.h>
@@ -237,16 +239,15 @@ Replay::readDynamicParams(const char *filename)
 }
 
 bool
-Replay::readFileHeader(std::ifstream &file)
+Replay::readFileHeader()
 {
-	file.seekg(0);
-	ulog_file_header_s msg_header;
-	file.read((char *)&msg_header, sizeof(msg_header));
-
-	if (!file) {
+	if (_reader.size() < sizeof(ulog_file_header_s)) {
 		return false;
 	}
 
+	ulog_file_header_s msg_header;
+	memcpy(&msg_header, _reader.data(), sizeof(msg_header));
+
 	_file_start_time = msg_header.timestamp;
 	//verify it's an ULog file
 	char magic[8];
@@ -261,76 +262,73 @@ Replay::readFileHeader(std::ifstream &file)
 }
 
 bool
-Replay::readFileDefinitions(std::ifstream &file)
+Replay::readFileDefinitions()
 {
 	PX4_INFO("Applying params from ULog file...");
 
 	ulog_message_header_s message_header;
-	file.seekg(sizeof(ulog_file_header_s));
+	size_t offset = sizeof(ulog_file_header_s);
 
 	while (true) {
-		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
-
-		if (!file) {
+		if (!_reader.messageAt(offset, message_header)) {
 			return false;
 		}
 
+		const uint8_t *message = _reader.payload(offset);
+
 		switch (message_header.msg_type) {
 		case (int)ULogMessageType::FLAG_BITS:
-			if (!readFlagBits(file, message_header.msg_size)) {
+			if (!readFlagBits(message, message_header.msg_size)) {
 				return false;
 			}
 
 			break;
 
 		case (int)ULogMessageType::FORMAT:
-			if (!readFormat(file, message_header.msg_size)) {
+			if (!readFormat(message, message_header.msg_size)) {
 				return false;
 			}
 
 			break;
 
 		case (int)ULogMessageType::PARAMETER:
-			if (!readAndApplyParameter(file, message_header.msg_size)) {
+			if (!readAndApplyParameter(message, message_header.msg_size)) {
 				return false;
 			}
 
 			break;
 
 		case (int)ULogMessageType::ADD_LOGGED_MSG:
-			_data_section_start = file.tellg() - (streamoff)ULOG_MSG_HEADER_LEN;
+			_data_section_start = offset;
 			return true;
 
 		case (int)ULogMessageType::INFO: //skip
 		case (int)ULogMessageType::INFO_MULTIPLE: //skip
 		case (int)ULogMessageType::PARAMETER_DEFAULT:
-			file.seekg(message_header.msg_size, ios::cur);
 			break;
 
 		default:
 			PX4_ERR("unknown log definition type %i, size %i (offset %i)",
-				(int)message_header.msg_type, (int)message_header.msg_size, (int)file.tellg());
-			file.seekg(message_header.msg_size, ios::cur);
+				(int)message_header.msg_type, (int)message_header.msg_size, (int)offset);
 			break;
 		}
+
+		offset += ULOG_MSG_HEADER_LEN + message_header.msg_size;
 	}
 
 	return true;
 }
 
 bool
-Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
+Replay::readFlagBits(const uint8_t *message, uint16_t msg_size)
 {
 	if (msg_size != 40) {
 		PX4_ERR("unsupported message length for FLAG_BITS message (%i)", msg_size);
 		return false;
 	}
 
-	_read_buffer.reserve(msg_size);
-	uint8_t *message = (uint8_t *)_read_buffer.data();
-	file.read((char *)message, msg_size);
-	//uint8_t *compat_flags = message;
-	uint8_t *incompat_flags = message + 8;
+	//const uint8_t *compat_flags = message;
+	const uint8_t *incompat_flags = message + 8;
 
 	// handle & validate the flags
 	bool contains_appended_data = incompat_flags[0] & ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK;
@@ -366,18 +364,9 @@ Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::readFormat(std::ifstream &file, uint16_t msg_size)
+Replay::readFormat(const uint8_t *message, uint16_t msg_size)
 {
-	_read_buffer.reserve(msg_size + 1);
-	char *format = (char *)_read_buffer.data();
-	file.read(format, msg_size);
-	format[msg_size] = 0;
-
-	if (!file) {
-		return false;
-	}
-
-	string str_format(format);
+	string str_format((const char *)message, strnlen((const char *)message, msg_size));
 	size_t pos = str_format.find(':');
 
 	if (pos == string::npos) {
@@ -419,27 +408,20 @@ string Replay::getOrbFields(const orb_metadata *meta)
 }
 
 bool
-Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
+Replay::readAndAddSubscription(const uint8_t *message, uint16_t msg_size)
 {
-	_read_buffer.reserve(msg_size + 1);
-	uint8_t *message = _read_buffer.data();
-	streampos this_message_pos = file.tellg() - (streamoff)ULOG_MSG_HEADER_LEN;
-	file.read((char *)message, msg_size);
-	message[msg_size] = 0;
-
-	if (!file) {
+	if (msg_size < 3) {
 		return false;
 	}
 
-	if (file.tellg() <= _subscription_file_pos) { //already read this subscription
+	uint8_t multi_id = message[0];
+	uint16_t msg_id = ((uint16_t)message[1]) | (((uint16_t)message[2]) << 8);
+	string topic_name((const char *)message + 3, strnlen((const char *)message + 3, msg_size - 3));
+
+	if (msg_id < _subscriptions.size() && _subscriptions[msg_id]) { //already added this subscription
 		return true;
 	}
 
-	_subscription_file_pos = file.tellg();
-
-	uint8_t multi_id = *(uint8_t *)message;
-	uint16_t msg_id = ((uint16_t)message[1]) | (((uint16_t)message[2]) << 8);
-	string topic_name((char *)message + 3);
 	const orb_metadata *orb_meta = findTopic(topic_name);
 
 	if (!orb_meta) {
@@ -545,15 +527,7 @@ Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
 	}
 
 	//find first data message (and the timestamp)
-	streampos cur_pos = file.tellg();
-	subscription->next_read_pos = this_message_pos; //this will be skipped
-
-	if (!nextDataMessage(file, *subscription, msg_id)) {
-		delete subscription;
-		return false;
-	}
-
-	file.seekg(cur_pos);
+	nextDataMessage(*subscription, msg_id);
 
 	if (!subscription->orb_meta) {
 		//no message found. This is not a fatal error
@@ -606,52 +580,45 @@ Replay::findFieldOffset(const string &format, const string &field_name, int &off
 	return false;
 }
 
-bool
-Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position)
+void
+Replay::readAndHandleAdditionalMessages(size_t end_position)
 {
+	const std::vector<size_t> &additional_messages = _reader.additionalMessages();
 	ulog_message_header_s message_header;
 
-	while (file.tellg() < end_position) {
-		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	while (_next_additional_message < additional_messages.size() &&
+	       additional_messages[_next_additional_message] < end_position) {
 
-		if (!file) {
-			return false;
+		const size_t offset = additional_messages[_next_additional_message++];
+
+		if (!_reader.messageAt(offset, message_header)) {
+			continue;
 		}
 
 		switch (message_header.msg_type) {
 		case (int)ULogMessageType::PARAMETER:
-			if (!readAndApplyParameter(file, message_header.msg_size)) {
-				return false;
-			}
-
+			readAndApplyParameter(_reader.payload(offset), message_header.msg_size);
 			break;
 
 		case (int)ULogMessageType::DROPOUT:
-			readDropout(file, message_header.msg_size);
+			readDropout(_reader.payload(offset), message_header.msg_size);
 			break;
 
-		default: //skip all others
-			file.seekg(message_header.msg_size, ios::cur);
+		default: //only the above are indexed
 			break;
 		}
 	}
-
-	return true;
 }
 
 bool
-Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
+Replay::readAndApplyParameter(const uint8_t *message, uint16_t msg_size)
 {
-	_read_buffer.reserve(msg_size);
-	uint8_t *message = (uint8_t *)_read_buffer.data();
-	file.read((char *)message, msg_size);
-
-	if (!file) {
+	if (msg_size < 1 || message[0] + 1 + sizeof(int32_t) > msg_size) {
 		return false;
 	}
 
 	uint8_t key_len = message[0];
-	string key((char *)message + 1, key_len);
+	string key((const char *)message + 1, key_len);
 
 	size_t pos = key.find(' ');
 
@@ -683,99 +650,44 @@ Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::readDropout(std::ifstream &file, uint16_t msg_size)
+Replay::readDropout(const uint8_t *message, uint16_t msg_size)
 {
+	if (msg_size < sizeof(uint16_t)) {
+		return false;
+	}
+
 	uint16_t duration;
-	file.read((char *)&duration, sizeof(duration));
+	memcpy(&duration, message, sizeof(duration));
 
 	PX4_ERR("Dropout in replayed log, %i ms", (int)duration);
-	return file.good();
+	return true;
 }
 
-bool
-Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id)
+void
+Replay::nextDataMessage(Subscription &subscription, uint16_t msg_id)
 {
+	const std::vector<size_t> &data_messages = _reader.dataMessages(msg_id);
 	ulog_message_header_s message_header;
-	file.seekg(subscription.next_read_pos);
-	//ignore the first message (it's data we already read)
-	file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
-
-	if (file) {
-		file.seekg(message_header.msg_size, ios::cur);
-	}
-
-	uint16_t file_msg_id;
-	bool done = false;
-
-	while (file && !done) {
-		streampos cur_pos = file.tellg();
-		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
-
-		if (!file) {
-			break;
-		}
-
-		if (((streamoff)cur_pos) + ULOG_MSG_HEADER_LEN + message_header.msg_size > _read_until_file_position) {
-			file.setstate(std::ios::eofbit);
-			break;
-		}
-
-		switch (message_header.msg_type) {
-		case (int)ULogMessageType::ADD_LOGGED_MSG:
-			readAndAddSubscription(file, message_header.msg_size);
-			break;
 
-		case (int)ULogMessageType::DATA:
-			file.read((char *)&file_msg_id, sizeof(file_msg_id));
-
-			if (file) {
-				if (msg_id == file_msg_id) {
-					if (message_header.msg_size == subscription.orb_meta->o_size_no_padding + 2) {
-						subscription.next_read_pos = cur_pos;
-						file.seekg(subscription.timestamp_offset, ios::cur);
-						file.read((char *)&subscription.next_timestamp, sizeof(subscription.next_timestamp));
-						done = true;
-
-					} else { //sanity check failed!
-						PX4_ERR("data message %s has wrong size %i (expected %i). Skipping",
-							subscription.orb_meta->o_name, message_header.msg_size,
-							subscription.orb_meta->o_size_no_padding + 2);
-						file.seekg(message_header.msg_size - sizeof(file_msg_id), ios::cur);
-					}
-
-				} else { //not the one we are looking for
-					file.seekg(message_header.msg_size - sizeof(file_msg_id), ios::cur);
-				}
-			}
+	while (subscription.next_index < data_messages.size()) {
+		const size_t offset = data_messages[subscription.next_index++];
+		_reader.messageAt(offset, message_header); // indexed messages are always complete
 
-			break;
-
-		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
-		case (int)ULogMessageType::PARAMETER:
-		case (int)ULogMessageType::DROPOUT:
-		case (int)ULogMessageType::INFO:
-		case (int)ULogMessageType::INFO_MULTIPLE:
-		case (int)ULogMessageType::SYNC:
-		case (int)ULogMessageType::LOGGING:
-		case (int)ULogMessageType::PARAMETER_DEFAULT:
-			file.seekg(message_header.msg_size, ios::cur);
-			break;
+		if (message_header.msg_size == subscription.orb_meta->o_size_no_padding + 2) {
+			subscription.next_read_pos = offset;
+			memcpy(&subscription.next_timestamp, _reader.payload(offset) + 2 + subscription.timestamp_offset,
+			       sizeof(subscription.next_timestamp));
+			return;
 
-		default:
-			//this really should not happen
-			PX4_ERR("unknown log message type %i, size %i (offset %i)",
-				(int)message_header.msg_type, (int)message_header.msg_size, (int)file.tellg());
-			file.seekg(message_header.msg_size, ios::cur);
-			break;
+		} else { //sanity check failed!
+			PX4_ERR("data message %s has wrong size %i (expected %i). Skipping",
+				subscription.orb_meta->o_name, message_header.msg_size,
+				subscription.orb_meta->o_size_no_padding + 2);
 		}
 	}
 
-	if (file.eof()) { //no more data messages for this subscription
-		subscription.orb_meta = nullptr;
-		file.clear();
-	}
-
-	return file.good();
+	//no more data messages for this subscription
+	subscription.orb_meta = nullptr;
 }
 
 const orb_metadata *
@@ -851,7 +763,7 @@ Replay::sizeOfFullType(const std::string &type_name_full)
 }
 
 bool
-Replay::readDefinitionsAndApplyParams(std::ifstream &file)
+Replay::readDefinitionsAndApplyParams()
 {
 	// log reader currently assumes little endian
 	int num = 1;
@@ -861,18 +773,18 @@ Replay::readDefinitionsAndApplyParams(std::ifstream &file)
 		return false;
 	}
 
-	if (!file.is_open()) {
+	if (!_reader.open(_replay_file)) {
 		PX4_ERR("Failed to open replay file");
 		return false;
 	}
 
-	if (!readFileHeader(file)) {
+	if (!readFileHeader()) {
 		PX4_ERR("Failed to read file header. Not a valid ULog file");
 		return false;
 	}
 
 	//initialize the formats and apply the parameters from the log file
-	if (!readFileDefinitions(file)) {
+	if (!readFileDefinitions()) {
 		PX4_ERR("Failed to read ULog definitions section. Broken file?");
 		return false;
 	}
@@ -885,9 +797,7 @@ Replay::readDefinitionsAndApplyParams(std::ifstream &file)
 void
 Replay::run()
 {
-	ifstream replay_file(_replay_file, ios::in | ios::binary);
-
-	if (!readDefinitionsAndApplyParams(replay_file)) {
+	if (!readDefinitionsAndApplyParams()) {
 		return;
 	}
 
@@ -900,66 +810,75 @@ Replay::run()
 
 	onEnterMainLoop();
 
+	if (!_reader.buildIndex(_data_section_start, _read_until_file_position)) {
+		PX4_ERR("Failed to index replay file");
+		return;
+	}
+
+	ulog_message_header_s message_header;
+
+	for (size_t offset : _reader.subscriptionMessages()) {
+		_reader.messageAt(offset, message_header);
+
+		if (!readAndAddSubscription(_reader.payload(offset), message_header.msg_size)) {
+			PX4_ERR("Failed to read subscription");
+			return;
+		}
+	}
+
 	_replay_start_time = hrt_absolute_time();
 
 	PX4_INFO("Replay in progress...");
 
-	ulog_message_header_s message_header;
-	replay_file.seekg(_data_section_start);
+	// min-heap of (next timestamp, msg_id): messages from different subscriptions don't need
+	// to be in chronological order in the file. Ties are resolved by the lower msg_id.
+	using NextMessage = std::pair<uint64_t, uint16_t>;
+	std::priority_queue<NextMessage, std::vector<NextMessage>, std::greater<NextMessage>> next_messages;
 
-	//we know the next message must be an ADD_LOGGED_MSG
-	replay_file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	for (size_t i = 0; i < _subscriptions.size(); ++i) {
+		const Subscription *subscription = _subscriptions[i];
 
-	if (!readAndAddSubscription(replay_file, message_header.msg_size)) {
-		PX4_ERR("Failed to read subscription");
-		return;
+		if (subscription && subscription->orb_meta && !subscription->ignored) {
+			next_messages.emplace(subscription->next_timestamp, (uint16_t)i);
+		}
 	}
 
 	const uint64_t timestamp_offset = getTimestampOffset();
 	uint32_t nr_published_messages = 0;
-	streampos last_additional_message_pos = _data_section_start;
 
-	while (!should_exit() && replay_file) {
+	while (!should_exit() && !next_messages.empty()) {
 
-		//Find the next message to publish. Messages from different subscriptions don't need
-		//to be in chronological order, so we need to check all subscriptions
-		uint64_t next_file_time = 0;
-		int next_msg_id = -1;
-		bool first_time = true;
+		const NextMessage next = next_messages.top();
+		next_messages.pop();
 
-		for (size_t i = 0; i < _subscriptions.size(); ++i) {
-			const Subscription *subscription = _subscriptions[i];
-
-			if (!subscription) {
-				continue;
-			}
+		const uint16_t next_msg_id = next.second;
+		Subscription &sub = *_subscriptions[next_msg_id];
 
-			if (subscription->orb_meta && !subscription->ignored) {
-				if (first_time || subscription->next_timestamp < next_file_time) {
-					first_time = false;
-					next_msg_id = (int)i;
-					next_file_time = subscription->next_timestamp;
-				}
-			}
+		if (!sub.orb_meta || sub.ignored) {
+			continue;
 		}
 
-		if (next_msg_id == -1) {
-			break; //no active subscription anymore. We're done.
+		if (sub.next_timestamp != next.first) {
+			// the subscription was advanced outside of the main loop
+			next_messages.emplace(sub.next_timestamp, next_msg_id);
+			continue;
 		}
 
-		Subscription &sub = *_subscriptions[next_msg_id];
+		const uint64_t next_file_time = sub.next_timestamp;
 
 		if (next_file_time == 0 || next_file_time < _file_start_time) {
 			//someone didn't set the timestamp properly. Consider the message invalid
-			nextDataMessage(replay_file, sub, next_msg_id);
+			nextDataMessage(sub, next_msg_id);
+
+			if (sub.orb_meta) {
+				next_messages.emplace(sub.next_timestamp, next_msg_id);
+			}
+
 			continue;
 		}
 
 		//handle additional messages between last and next published data
-		replay_file.seekg(last_additional_message_pos);
-		streampos next_additional_message_pos = sub.next_read_pos;
-		readAndHandleAdditionalMessages(replay_file, next_additional_message_pos);
-		last_additional_message_pos = next_additional_message_pos;
+		readAndHandleAdditionalMessages(sub.next_read_pos);
 
 		// Perform scheduled parameter changes
 		while (_next_param_change < _dynamic_parameter_schedule.size() &&
@@ -975,14 +894,18 @@ Replay::run()
 		const uint64_t publish_timestamp = handleTopicDelay(next_file_time, timestamp_offset);
 
 		// It's time to publish
-		readTopicDataToBuffer(sub, replay_file);
+		readTopicDataToBuffer(sub);
 		memcpy(_read_buffer.data() + sub.timestamp_offset, &publish_timestamp, sizeof(uint64_t)); //adjust the timestamp
 
-		if (handleTopicUpdate(sub, _read_buffer.data(), replay_file)) {
+		if (handleTopicUpdate(sub, _read_buffer.data())) {
 			++nr_published_messages;
 		}
 
-		nextDataMessage(replay_file, sub, next_msg_id);
+		nextDataMessage(sub, next_msg_id);
+
+		if (sub.orb_meta) {
+			next_messages.emplace(sub.next_timestamp, next_msg_id);
+		}
 
 		// TODO: output status (eg. every sec), including total duration...
 	}
@@ -1011,7 +934,7 @@ Replay::run()
 	onExitMainLoop();
 
 	if (!should_exit()) {
-		replay_file.close();
+		_reader.close();
 		px4_shutdown_request();
 		// we need to ensure the shutdown logic gets updated and eventually triggers shutdown
 		hrt_abstime t = hrt_absolute_time();
@@ -1026,17 +949,20 @@ Replay::run()
 }
 
 void
-Replay::readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file)
+Replay::readTopicDataToBuffer(const Subscription &sub)
 {
 	const size_t msg_read_size = sub.orb_meta->o_size_no_padding;
 	const size_t msg_write_size = sub.orb_meta->o_size;
-	_read_buffer.reserve(msg_write_size);
-	replay_file.seekg(sub.next_read_pos + (streamoff)(ULOG_MSG_HEADER_LEN + 2)); //skip header & msg id
-	replay_file.read((char *)_read_buffer.data(), msg_read_size);
+
+	if (_read_buffer.size() < msg_write_size) {
+		_read_buffer.resize(msg_write_size);
+	}
+
+	memcpy(_read_buffer.data(), _reader.payload(sub.next_read_pos) + 2, msg_read_size); //skip msg id
 }
 
 bool
-Replay::handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file)
+Replay::handleTopicUpdate(Subscription &sub, void *data)
 {
 	return publishTopic(sub, data);
 }
@@ -1182,9 +1108,7 @@ Replay::applyParams(bool quiet)
 		return -ENOMEM;
 	}
 
-	ifstream replay_file(_replay_file, ios::in | ios::binary);
-
-	if (!r->readDefinitionsAndApplyParams(replay_file)) {
+	if (!r->readDefinitionsAndApplyParams()) {
 		ret = -1;
 	}
 
@@ -1231,6 +1155,10 @@ the log file to be replayed. The second is the mode, specified via `replay_mode`
 - Generic otherwise: this can be used to replay any module(s), but the replay will be done with the same speed as the
   log was recorded.
 
+In ekf2 mode, the replay prints the innovation test ratio statistics and the run time at the end. If the environment
+variable `replay_summary` is set, they are also appended as a CSV line to that file. This is used by
+`Tools/ecl_ekf/batch_replay_ekf.py` to replay a directory of logs with parallel px4 processes.
+
 The module is typically used together with uORB publisher rules, to specify which messages should be replayed.
 The replay module will just publish all messages that are found in the log. It also applies the parameters from
 the log.
@@ -35,6 +35,11 @@
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/posix.h>
 
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
 #include <lib/parameters/param.h>
 
 // for ekf2 replay
@@ -58,20 +63,32 @@
 namespace px4
 {
 
+const char *const ReplayEkf2::TEST_RATIO_NAMES[NUM_TEST_RATIOS] {
+	"mag", "vel", "pos", "hgt", "tas", "hagl", "beta"
+};
+
 bool
-ReplayEkf2::handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file)
+ReplayEkf2::handleTopicUpdate(Subscription &sub, void *data)
 {
 	if (sub.orb_meta == ORB_ID(ekf2_timestamps)) {
 		ekf2_timestamps_s ekf2_timestamps;
 		memcpy(&ekf2_timestamps, data, sub.orb_meta->o_size);
 
-		if (!publishEkf2Topics(ekf2_timestamps, replay_file)) {
+		if (!publishEkf2Topics(ekf2_timestamps)) {
 			return false;
 		}
 
 		// Wait for modules to process the data
 		px4_lockstep_wait_for_components();
 
+		if (_first_ekf2_timestamp == 0) {
+			_first_ekf2_timestamp = ekf2_timestamps.timestamp;
+		}
+
+		_last_ekf2_timestamp = ekf2_timestamps.timestamp;
+
+		updateTestRatioStatistics();
+
 		return true;
 
 	} else if (sub.orb_meta == ORB_ID(vehicle_status) || sub.orb_meta == ORB_ID(vehicle_land_detected)
@@ -118,13 +135,13 @@ ReplayEkf2::onSubscriptionAdded(Subscription &sub, uint16_t msg_id)
 }
 
 bool
-ReplayEkf2::publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, std::ifstream &replay_file)
+ReplayEkf2::publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps)
 {
 	auto handle_sensor_publication = [&](int16_t timestamp_relative, uint16_t msg_id) {
 		if (timestamp_relative != ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID) {
 			// timestamp_relative is already given in 0.1 ms
 			uint64_t t = timestamp_relative + ekf2_timestamps.timestamp / 100; // in 0.1 ms
-			findTimestampAndPublish(t, msg_id, replay_file);
+			findTimestampAndPublish(t, msg_id);
 		}
 	};
 
@@ -137,7 +154,7 @@ ReplayEkf2::publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, std::ifs
 	handle_sensor_publication(0, _aux_global_position_msg_id);
 
 	// sensor_combined: publish last because ekf2 is polling on this
-	if (!findTimestampAndPublish(ekf2_timestamps.timestamp / 100, _sensor_combined_msg_id, replay_file)) {
+	if (!findTimestampAndPublish(ekf2_timestamps.timestamp / 100, _sensor_combined_msg_id)) {
 		if (_sensor_combined_msg_id == msg_id_invalid) {
 			// subscription not found yet or sensor_combined not contained in log
 			return false;
@@ -147,7 +164,7 @@ ReplayEkf2::publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, std::ifs
 
 		} else {
 			// we should publish a topic, just publish the same again
-			readTopicDataToBuffer(*_subscriptions[_sensor_combined_msg_id], replay_file);
+			readTopicDataToBuffer(*_subscriptions[_sensor_combined_msg_id]);
 			publishTopic(*_subscriptions[_sensor_combined_msg_id], _read_buffer.data());
 		}
 	}
@@ -156,7 +173,7 @@ ReplayEkf2::publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, std::ifs
 }
 
 bool
-ReplayEkf2::findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id, std::ifstream &replay_file)
+ReplayEkf2::findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id)
 {
 	if (msg_id == msg_id_invalid) {
 		// could happen if a topic is not logged
@@ -166,7 +183,7 @@ ReplayEkf2::findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id, std::if
 	Subscription &sub = *_subscriptions[msg_id];
 
 	while (sub.next_timestamp / 100 < timestamp && sub.orb_meta) {
-		nextDataMessage(replay_file, sub, msg_id);
+		nextDataMessage(sub, msg_id);
 	}
 
 	if (!sub.orb_meta) { // no messages anymore
@@ -181,11 +198,75 @@ ReplayEkf2::findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id, std::if
 		return false;
 	}
 
-	readTopicDataToBuffer(sub, replay_file);
+	readTopicDataToBuffer(sub);
 	publishTopic(sub, _read_buffer.data());
 	return true;
 }
 
+void
+ReplayEkf2::updateTestRatioStatistics()
+{
+	estimator_status_s status;
+
+	if (!_estimator_status_sub.update(&status)) {
+		return;
+	}
+
+	const float ratios[NUM_TEST_RATIOS] {
+		status.mag_test_ratio, status.vel_test_ratio, status.pos_test_ratio, status.hgt_test_ratio,
+		status.tas_test_ratio, status.hagl_test_ratio, status.beta_test_ratio
+	};
+
+	for (int i = 0; i < NUM_TEST_RATIOS; ++i) {
+		// a ratio of 0 means the measurement was not fused
+		if (PX4_ISFINITE(ratios[i]) && ratios[i] > 0.f) {
+			TestRatioStatistics &stats = _test_ratios[i];
+			stats.max = fmaxf(stats.max, ratios[i]);
+			stats.sum += (double)ratios[i];
+			++stats.count;
+		}
+	}
+}
+
+void
+ReplayEkf2::writeSummary(float replay_time_s, float log_time_s)
+{
+	const char *summary_file = getenv(replay::ENV_SUMMARY);
+
+	if (!summary_file || !replayFile()) {
+		return;
+	}
+
+	struct stat st;
+	const bool write_header = stat(summary_file, &st) != 0 || st.st_size == 0;
+
+	FILE *f = fopen(summary_file, "a");
+
+	if (!f) {
+		PX4_ERR("failed to open %s", summary_file);
+		return;
+	}
+
+	if (write_header) {
+		fprintf(f, "log,replay_time_s,log_time_s");
+
+		for (int i = 0; i < NUM_TEST_RATIOS; ++i) {
+			fprintf(f, ",%s_test_ratio_mean,%s_test_ratio_max", TEST_RATIO_NAMES[i], TEST_RATIO_NAMES[i]);
+		}
+
+		fprintf(f, "\n");
+	}
+
+	fprintf(f, "%s,%.3f,%.3f", replayFile(), (double)replay_time_s, (double)log_time_s);
+
+	for (int i = 0; i < NUM_TEST_RATIOS; ++i) {
+		fprintf(f, ",%.4f,%.4f", (double)_test_ratios[i].mean(), (double)_test_ratios[i].max);
+	}
+
+	fprintf(f, "\n");
+	fclose(f);
+}
+
 void
 ReplayEkf2::onEnterMainLoop()
 {
@@ -193,6 +274,9 @@ ReplayEkf2::onEnterMainLoop()
 
 	// disable parameter auto save
 	param_control_autosave(false);
+
+	// hrt follows the log time in replay, so measure the run time against the system clock
+	system_clock_gettime(CLOCK_MONOTONIC, &_wall_time_start);
 }
 
 void
@@ -220,6 +304,27 @@ ReplayEkf2::onExitMainLoop()
 	print_sensor_statistics(_vehicle_magnetometer_msg_id, "vehicle_magnetometer");
 	print_sensor_statistics(_vehicle_visual_odometry_msg_id, "vehicle_visual_odometry");
 	print_sensor_statistics(_aux_global_position_msg_id, "aux_global_position");
+
+	PX4_INFO("");
+	PX4_INFO("Innovation test ratio, mean, max:");
+
+	for (int i = 0; i < NUM_TEST_RATIOS; ++i) {
+		if (_test_ratios[i].count > 0) {
+			PX4_INFO("%s: %.3f, %.3f", TEST_RATIO_NAMES[i], (double)_test_ratios[i].mean(), (double)_test_ratios[i].max);
+		}
+	}
+
+	timespec now{};
+	system_clock_gettime(CLOCK_MONOTONIC, &now);
+	const float replay_time_s = (float)(now.tv_sec - _wall_time_start.tv_sec)
+				    + (float)(now.tv_nsec - _wall_time_start.tv_nsec) * 1e-9f;
+	const float log_time_s = (float)(_last_ekf2_timestamp - _first_ekf2_timestamp) * 1e-6f;
+
+	PX4_INFO("");
+	PX4_INFO("Replayed %.1f s of log in %.3f s (%.1fx)", (double)log_time_s, (double)replay_time_s,
+		 (double)(replay_time_s > 0.f ? log_time_s / replay_time_s : 0.f));
+
+	writeSummary(replay_time_s, log_time_s);
 }
 
 } // namespace px4
@@ -35,6 +35,11 @@
 
 #include "Replay.hpp"
 
+#include <time.h>
+
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/estimator_status.h>
+
 namespace px4
 {
 
@@ -54,10 +59,9 @@ protected:
 	 * handle ekf2 topic publication in ekf2 replay mode
 	 * @param sub
 	 * @param data
-	 * @param replay_file file currently replayed (file seek position should be considered arbitrary after this call)
 	 * @return true if published, false otherwise
 	 */
-	bool handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file) override;
+	bool handleTopicUpdate(Subscription &sub, void *data) override;
 
 	void onSubscriptionAdded(Subscription &sub, uint16_t msg_id) override;
 
@@ -68,19 +72,47 @@ protected:
 	}
 private:
 
-	bool publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, std::ifstream &replay_file);
+	bool publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps);
 
 	/**
 	 * find the next message for a subscription that matches a given timestamp and publish it
 	 * @param timestamp in 0.1 ms
 	 * @param msg_id
-	 * @param replay_file file currently replayed (file seek position should be considered arbitrary after this call)
 	 * @return true if timestamp found and published
 	 */
-	bool findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id, std::ifstream &replay_file);
+	bool findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id);
+
+	/**
+	 * update the innovation test ratio statistics from the latest estimator_status
+	 */
+	void updateTestRatioStatistics();
+
+	/**
+	 * append the replay summary as a CSV line to the file given via ENV_SUMMARY
+	 */
+	void writeSummary(float replay_time_s, float log_time_s);
 
 	static constexpr uint16_t msg_id_invalid = 0xffff;
 
+	struct TestRatioStatistics {
+		float max{0.f};
+		double sum{0.};
+		uint32_t count{0};
+
+		float mean() const { return count > 0 ? (float)(sum / count) : 0.f; }
+	};
+
+	static constexpr int NUM_TEST_RATIOS = 7;
+	static const char *const TEST_RATIO_NAMES[NUM_TEST_RATIOS];
+
+	TestRatioStatistics _test_ratios[NUM_TEST_RATIOS] {};
+
+	uORB::Subscription _estimator_status_sub{ORB_ID(estimator_status)};
+
+	uint64_t _first_ekf2_timestamp{0};
+	uint64_t _last_ekf2_timestamp{0};
+	timespec _wall_time_start{};
+
 	uint16_t _airspeed_msg_id = msg_id_invalid;
 	uint16_t _distance_sensor_msg_id = msg_id_invalid;
 	uint16_t _optical_flow_msg_id = msg_id_invalid;
@@ -0,0 +1,179 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "ULogReader.hpp"
+
+#include <px4_platform_common/log.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace px4
+{
+
+ULogReader::~ULogReader()
+{
+	close();
+}
+
+bool
+ULogReader::open(const char *file_name)
+{
+	close();
+
+	int fd = ::open(file_name, O_RDONLY);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat st;
+
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// the mapping stays valid after closing the file descriptor
+	::close(fd);
+
+	if (data == MAP_FAILED) {
+		PX4_ERR("mmap failed (%i)", errno);
+		return false;
+	}
+
+	_data = (const uint8_t *)data;
+	_size = st.st_size;
+	return true;
+}
+
+void
+ULogReader::close()
+{
+	if (_data) {
+		munmap((void *)_data, _size);
+		_data = nullptr;
+		_size = 0;
+	}
+
+	_data_messages.clear();
+	_subscription_messages.clear();
+	_additional_messages.clear();
+}
+
+bool
+ULogReader::messageAt(size_t offset, ulog_message_header_s &header) const
+{
+	if (offset + ULOG_MSG_HEADER_LEN > _size) {
+		return false;
+	}
+
+	memcpy(&header, _data + offset, ULOG_MSG_HEADER_LEN);
+
+	return offset + ULOG_MSG_HEADER_LEN + header.msg_size <= _size;
+}
+
+bool
+ULogReader::buildIndex(size_t data_section_start, uint64_t read_until)
+{
+	_data_messages.clear();
+	_subscription_messages.clear();
+	_additional_messages.clear();
+
+	if (!_data) {
+		return false;
+	}
+
+	ulog_message_header_s header;
+	size_t offset = data_section_start;
+
+	while (messageAt(offset, header)) {
+		const size_t next_offset = offset + ULOG_MSG_HEADER_LEN + header.msg_size;
+
+		if (next_offset > read_until) {
+			break;
+		}
+
+		switch (header.msg_type) {
+		case (int)ULogMessageType::DATA:
+			if (header.msg_size >= sizeof(uint16_t)) {
+				uint16_t msg_id;
+				memcpy(&msg_id, payload(offset), sizeof(msg_id));
+
+				if (_data_messages.size() <= msg_id) {
+					_data_messages.resize(msg_id + 1);
+				}
+
+				_data_messages[msg_id].push_back(offset);
+			}
+
+			break;
+
+		case (int)ULogMessageType::ADD_LOGGED_MSG:
+			_subscription_messages.push_back(offset);
+			break;
+
+		case (int)ULogMessageType::PARAMETER:
+		case (int)ULogMessageType::DROPOUT:
+			_additional_messages.push_back(offset);
+			break;
+
+		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
+		case (int)ULogMessageType::INFO:
+		case (int)ULogMessageType::INFO_MULTIPLE:
+		case (int)ULogMessageType::SYNC:
+		case (int)ULogMessageType::LOGGING:
+		case (int)ULogMessageType::LOGGING_TAGGED:
+		case (int)ULogMessageType::PARAMETER_DEFAULT:
+			break;
+
+		default:
+			//this really should not happen
+			PX4_ERR("unknown log message type %i, size %i (offset %i)",
+				(int)header.msg_type, (int)header.msg_size, (int)offset);
+			break;
+		}
+
+		offset = next_offset;
+	}
+
+	return true;
+}
+
+} //namespace px4
@@ -0,0 +1,117 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <logger/messages.h>
+
+namespace px4
+{
+
+/**
+ * @class ULogReader
+ * Read-only, memory-mapped access to an ULog file.
+ *
+ * The data section is scanned once (buildIndex()), recording the file offset of every data
+ * message per msg_id, as well as the offsets of the subscription and the additional (parameter
+ * and dropout) messages. Replay then only touches the messages it actually needs, instead of
+ * walking the whole file once per subscription.
+ */
+class ULogReader
+{
+public:
+	ULogReader() = default;
+	~ULogReader();
+
+	ULogReader(const ULogReader &) = delete;
+	ULogReader &operator=(const ULogReader &) = delete;
+
+	/**
+	 * Map a file into memory
+	 * @return true on success
+	 */
+	bool open(const char *file_name);
+
+	void close();
+
+	bool isOpen() const { return _data != nullptr; }
+
+	size_t size() const { return _size; }
+
+	/**
+	 * Get the header of the message starting at a file offset.
+	 * @return false if the message (including its payload) is not fully contained in the file
+	 */
+	bool messageAt(size_t offset, ulog_message_header_s &header) const;
+
+	/** payload of the message starting at offset. Only valid if messageAt() succeeded for offset. */
+	const uint8_t *payload(size_t offset) const { return _data + offset + ULOG_MSG_HEADER_LEN; }
+
+	const uint8_t *data() const { return _data; }
+
+	/**
+	 * Scan the data section and build the message index.
+	 * @param data_section_start offset of the first message in the data section
+	 * @param read_until messages ending after this offset are ignored (used if the log contains appended data)
+	 * @return true on success
+	 */
+	bool buildIndex(size_t data_section_start, uint64_t read_until);
+
+	/** offsets of all data messages with a given msg_id, in file order */
+	const std::vector<size_t> &dataMessages(uint16_t msg_id) const
+	{
+		return msg_id < _data_messages.size() ? _data_messages[msg_id] : _empty;
+	}
+
+	/** offsets of all ADD_LOGGED_MSG messages in the data section */
+	const std::vector<size_t> &subscriptionMessages() const { return _subscription_messages; }
+
+	/** offsets of all PARAMETER and DROPOUT messages in the data section */
+	const std::vector<size_t> &additionalMessages() const { return _additional_messages; }
+
+private:
+	const uint8_t *_data{nullptr};
+	size_t _size{0};
+
+	std::vector<std::vector<size_t>> _data_messages;
+	std::vector<size_t> _subscription_messages;
+	std::vector<size_t> _additional_messages;
+
+	const std::vector<size_t> _empty;
+};
+
+} //namespace px4
@@ -496,6 +496,18 @@ void VehicleAngularVelocity::ParametersUpdate(bool force)
 		}
 
 #endif // !CONSTRAINED_FLASH
+
+		// notch filter bank: general notch filters 0 & 1, FFT peaks and ESC RPM harmonics per axis
+		int notch_filter_stages_max = 2;
+#if !defined(CONSTRAINED_FLASH)
+		notch_filter_stages_max += MAX_NUM_FFT_PEAKS + _esc_rpm_harmonics * MAX_NUM_ESCS;
+#endif // !CONSTRAINED_FLASH
+
+		if (_notch_filter_bank.maxStages() < notch_filter_stages_max) {
+			if (!_notch_filter_bank.reserve(notch_filter_stages_max)) {
+				PX4_ERR("notch filter bank allocation failed");
+			}
+		}
 	}
 }
 
@@ -722,42 +734,96 @@ void VehicleAngularVelocity::UpdateDynamicNotchFFT(const hrt_abstime &time_now_u
 #endif // !CONSTRAINED_FLASH
 }
 
-float VehicleAngularVelocity::FilterAngularVelocity(int axis, float data[], int N)
+bool VehicleAngularVelocity::NotchFilterAngularVelocity(float *data[3], int N)
 {
+	_notch_filter_bank.clear();
+
+	for (int axis = 0; axis < 3; axis++) {
+		bool added = true;
+
 #if !defined(CONSTRAINED_FLASH)
 
-	// Apply dynamic notch filter from ESC RPM
-	if (_dynamic_notch_filter_esc_rpm) {
-		for (int esc = 0; esc < MAX_NUM_ESCS; esc++) {
-			if (_esc_available[esc]) {
-				for (int harmonic = 0; harmonic < _esc_rpm_harmonics; harmonic++) {
-					if (_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].getNotchFreq() > 0.f) {
-						_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].applyArray(data, N);
+		// dynamic notch filter from ESC RPM
+		if (_dynamic_notch_filter_esc_rpm) {
+			for (int esc = 0; esc < MAX_NUM_ESCS; esc++) {
+				if (_esc_available[esc]) {
+					for (int harmonic = 0; harmonic < _esc_rpm_harmonics; harmonic++) {
+						if (_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].getNotchFreq() > 0.f) {
+							added = added && _notch_filter_bank.add(axis, _dynamic_notch_filter_esc_rpm[harmonic][axis][esc]);
+						}
 					}
 				}
 			}
 		}
-	}
 
-	// Apply dynamic notch filter from FFT
-	if (_dynamic_notch_fft_available) {
-		for (int peak = MAX_NUM_FFT_PEAKS - 1; peak >= 0; peak--) {
-			if (_dynamic_notch_filter_fft[axis][peak].getNotchFreq() > 0.f) {
-				_dynamic_notch_filter_fft[axis][peak].applyArray(data, N);
+		// dynamic notch filter from FFT
+		if (_dynamic_notch_fft_available) {
+			for (int peak = MAX_NUM_FFT_PEAKS - 1; peak >= 0; peak--) {
+				if (_dynamic_notch_filter_fft[axis][peak].getNotchFreq() > 0.f) {
+					added = added && _notch_filter_bank.add(axis, _dynamic_notch_filter_fft[axis][peak]);
+				}
 			}
 		}
-	}
 
 #endif // !CONSTRAINED_FLASH
 
-	// Apply general notch filter 0 (IMU_GYRO_NF0_FRQ)
-	if (_notch_filter0_velocity[axis].getNotchFreq() > 0.f) {
-		_notch_filter0_velocity[axis].applyArray(data, N);
+		// general notch filter 0 (IMU_GYRO_NF0_FRQ) and 1 (IMU_GYRO_NF1_FRQ)
+		if (_notch_filter0_velocity[axis].getNotchFreq() > 0.f) {
+			added = added && _notch_filter_bank.add(axis, _notch_filter0_velocity[axis]);
+		}
+
+		if (_notch_filter1_velocity[axis].getNotchFreq() > 0.f) {
+			added = added && _notch_filter_bank.add(axis, _notch_filter1_velocity[axis]);
+		}
+
+		if (!added) {
+			// bank too small, fall back to filtering each axis separately
+			return false;
+		}
 	}
 
-	// Apply general notch filter 1 (IMU_GYRO_NF1_FRQ)
-	if (_notch_filter1_velocity[axis].getNotchFreq() > 0.f) {
-		_notch_filter1_velocity[axis].applyArray(data, N);
+	_notch_filter_bank.applyArray(data, N);
+	return true;
+}
+
+float VehicleAngularVelocity::FilterAngularVelocity(int axis, float data[], int N, bool notch_filtered)
+{
+	if (!notch_filtered) {
+#if !defined(CONSTRAINED_FLASH)
+
+		// Apply dynamic notch filter from ESC RPM
+		if (_dynamic_notch_filter_esc_rpm) {
+			for (int esc = 0; esc < MAX_NUM_ESCS; esc++) {
+				if (_esc_available[esc]) {
+					for (int harmonic = 0; harmonic < _esc_rpm_harmonics; harmonic++) {
+						if (_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].getNotchFreq() > 0.f) {
+							_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].applyArray(data, N);
+						}
+					}
+				}
+			}
+		}
+
+		// Apply dynamic notch filter from FFT
+		if (_dynamic_notch_fft_available) {
+			for (int peak = MAX_NUM_FFT_PEAKS - 1; peak >= 0; peak--) {
+				if (_dynamic_notch_filter_fft[axis][peak].getNotchFreq() > 0.f) {
+					_dynamic_notch_filter_fft[axis][peak].applyArray(data, N);
+				}
+			}
+		}
+
+#endif // !CONSTRAINED_FLASH
+
+		// Apply general notch filter 0 (IMU_GYRO_NF0_FRQ)
+		if (_notch_filter0_velocity[axis].getNotchFreq() > 0.f) {
+			_notch_filter0_velocity[axis].applyArray(data, N);
+		}
+
+		// Apply general notch filter 1 (IMU_GYRO_NF1_FRQ)
+		if (_notch_filter1_velocity[axis].getNotchFreq() > 0.f) {
+			_notch_filter1_velocity[axis].applyArray(data, N);
+		}
 	}
 
 	// Apply general low-pass filter (IMU_GYRO_CUTOFF)
@@ -838,17 +904,23 @@ void VehicleAngularVelocity::Run()
 
 				int16_t *raw_data_array[] {sensor_fifo_data.x, sensor_fifo_data.y, sensor_fifo_data.z};
 
-				for (int axis = 0; axis < 3; axis++) {
-					// copy raw int16 sensor samples to float array for filtering
-					float data[FIFO_SIZE_MAX];
+				// copy raw int16 sensor samples to float arrays for filtering
+				float data[3][FIFO_SIZE_MAX];
+				float *data_array[] {data[0], data[1], data[2]};
 
+				for (int axis = 0; axis < 3; axis++) {
 					for (int n = 0; n < N; n++) {
-						data[n] = sensor_fifo_data.scale * raw_data_array[axis][n];
+						data[axis][n] = sensor_fifo_data.scale * raw_data_array[axis][n];
 					}
+				}
 
+				// notch filter all axes at once
+				const bool notch_filtered = NotchFilterAngularVelocity(data_array, N);
+
+				for (int axis = 0; axis < 3; axis++) {
 					// save last filtered sample
-					angular_velocity_uncalibrated(axis) = FilterAngularVelocity(axis, data, N);
-					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data, N);
+					angular_velocity_uncalibrated(axis) = FilterAngularVelocity(axis, data[axis], N, notch_filtered);
+					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data[axis], N);
 				}
 
 				// Publish
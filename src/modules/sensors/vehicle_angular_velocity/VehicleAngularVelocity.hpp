@@ -40,6 +40,7 @@
 #include <lib/mathlib/math/filter/AlphaFilter.hpp>
 #include <lib/mathlib/math/filter/LowPassFilter2p.hpp>
 #include <lib/mathlib/math/filter/NotchFilter.hpp>
+#include <lib/mathlib/math/filter/NotchFilterBank.hpp>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/px4_config.h>
@@ -78,7 +79,8 @@ private:
 	bool CalibrateAndPublish(const hrt_abstime &timestamp_sample, const matrix::Vector3f &angular_velocity_uncalibrated,
 				 const matrix::Vector3f &angular_acceleration_uncalibrated);
 
-	inline float FilterAngularVelocity(int axis, float data[], int N = 1);
+	inline float FilterAngularVelocity(int axis, float data[], int N = 1, bool notch_filtered = false);
+	inline bool NotchFilterAngularVelocity(float *data[3], int N);
 	inline float FilterAngularAcceleration(int axis, float inverse_dt_s, float data[], int N = 1);
 
 	void DisableDynamicNotchEscRpm();
@@ -133,6 +135,9 @@ private:
 	math::NotchFilter<float> _notch_filter0_velocity[3] {};
 	math::NotchFilter<float> _notch_filter1_velocity[3] {};
 
+	// all active notch filters of the 3 axes, applied together to FIFO samples
+	math::NotchFilterBank _notch_filter_bank{};
+
 #if !defined(CONSTRAINED_FLASH)
 
 	enum DynamicNotch {
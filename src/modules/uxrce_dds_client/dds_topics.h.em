@@ -21,6 +21,7 @@ import os
 #include <uxr/client/client.h>
 #include <ucdr/microcdr.h>
 
+#include <drivers/drv_hrt.h>
 #include <mathlib/mathlib.h>
 #include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
@@ -62,14 +63,34 @@ struct SendTopicsSubs {
 
 	px4_pollfd_struct_t fds[@(len(publications))] {};
 
+	// Estimated protocol overhead (excluding the transport framing): message header (session id,
+	// stream id, sequence number, client key) and WRITE_DATA submessage header (submessage header,
+	// request id, object id). Submessages are 4 byte aligned.
+	static constexpr uint32_t message_overhead = 8;
+	static constexpr uint32_t submessage_overhead = 8;
+
 	uint32_t num_payload_sent{};
+	uint32_t num_packets_sent{};
+	uint32_t num_bytes_sent{}; ///< payload and estimated protocol overhead
+
+	uint32_t max_packet_size{};  ///< samples are packed into a single packet up to this size
+	hrt_abstime max_flush_delay{}; ///< samples are held back at most for this long to fill a packet
 
-	void init();
+	uint32_t pending_bytes{}; ///< bytes in the best-effort output stream, not flushed yet
+	hrt_abstime pending_since{};
+
+	void init(uint32_t packet_size, hrt_abstime flush_delay);
 	void update(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId best_effort_stream_id, uxrObjectId participant_id, const char *client_namespace);
+	void flush(uxrSession *session);
+	bool hold_output(hrt_abstime now) const;
+	int flush_timeout_ms(hrt_abstime now, int timeout_ms) const;
 	void reset();
 };
 
-void SendTopicsSubs::init() {
+void SendTopicsSubs::init(uint32_t packet_size, hrt_abstime flush_delay) {
+	max_packet_size = packet_size;
+	max_flush_delay = flush_delay;
+
 	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
 		fds[idx].fd = orb_subscribe(send_subscriptions[idx].orb_meta);
 		fds[idx].events = POLLIN;
@@ -79,11 +100,41 @@ void SendTopicsSubs::init() {
 
 void SendTopicsSubs::reset() {
 	num_payload_sent = 0;
+	num_packets_sent = 0;
+	num_bytes_sent = 0;
+	pending_bytes = 0;
 	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
 		send_subscriptions[idx].data_writer = uxr_object_id(0, UXR_INVALID_ID);
 	}
 };
 
+void SendTopicsSubs::flush(uxrSession *session)
+{
+	uxr_flash_output_streams(session);
+
+	if (pending_bytes > 0) {
+		num_packets_sent++;
+		num_bytes_sent += pending_bytes;
+		pending_bytes = 0;
+	}
+}
+
+bool SendTopicsSubs::hold_output(hrt_abstime now) const
+{
+	return (pending_bytes > 0) && (pending_bytes < max_packet_size) && (now < pending_since + max_flush_delay);
+}
+
+int SendTopicsSubs::flush_timeout_ms(hrt_abstime now, int timeout_ms) const
+{
+	if (hold_output(now)) {
+		// round up, so that the deadline has passed when the poll times out
+		const int remaining_ms = static_cast<int>((pending_since + max_flush_delay - now + 999) / 1000);
+		return math::min(timeout_ms, remaining_ms);
+	}
+
+	return timeout_ms;
+}
+
 void SendTopicsSubs::update(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId best_effort_stream_id, uxrObjectId participant_id, const char *client_namespace)
 {
 	int64_t time_offset_us = session->time_offset / 1000; // ns -> us
@@ -102,12 +153,32 @@ void SendTopicsSubs::update(uxrSession *session, uxrStreamId reliable_out_stream
 
 			if (send_subscriptions[idx].data_writer.id != UXR_INVALID_ID) {
 
-				ucdrBuffer ub;
 				uint32_t topic_size = send_subscriptions[idx].topic_size;
-				if (uxr_prepare_output_stream(session, best_effort_stream_id, send_subscriptions[idx].data_writer, &ub, topic_size) != UXR_INVALID_REQUEST_ID) {
+				const uint32_t submessage_size = submessage_overhead + ((topic_size + 3) & ~3u);
+
+				// fill up the MTU, flush before the sample would exceed it
+				if (pending_bytes > 0 && pending_bytes + submessage_size > max_packet_size) {
+					flush(session);
+				}
+
+				ucdrBuffer ub;
+				bool prepared = (uxr_prepare_output_stream(session, best_effort_stream_id, send_subscriptions[idx].data_writer, &ub, topic_size) != UXR_INVALID_REQUEST_ID);
+
+				if (!prepared && pending_bytes > 0) {
+					// the overhead estimate was too low: the stream buffer is full
+					flush(session);
+					prepared = (uxr_prepare_output_stream(session, best_effort_stream_id, send_subscriptions[idx].data_writer, &ub, topic_size) != UXR_INVALID_REQUEST_ID);
+				}
+
+				if (prepared) {
 					send_subscriptions[idx].ucdr_serialize_method(&topic_data, ub, time_offset_us);
-					// TODO: fill up the MTU and then flush, which reduces the packet overhead
-					uxr_flash_output_streams(session);
+
+					if (pending_bytes == 0) {
+						pending_bytes = message_overhead;
+						pending_since = hrt_absolute_time();
+					}
+
+					pending_bytes += submessage_size;
 					num_payload_sent += topic_size;
 
 				} else {
@@ -513,9 +513,13 @@ void UxrceddsClient::run()
 		bool had_ping_reply = false;
 		uint32_t last_num_payload_sent{};
 		uint32_t last_num_payload_received{};
+		uint32_t last_num_packets_sent{};
+		uint32_t last_num_bytes_sent{};
 		int poll_error_counter = 0;
 
-		_subs->init();
+		// pack the samples into packets of up to the transport MTU
+		const uint32_t max_packet_size = math::min((uint32_t)_comm->mtu, (uint32_t)sizeof(output_data_stream_buffer));
+		_subs->init(max_packet_size, _param_uxrce_dds_flush.get() * 1_ms);
 
 		while (!should_exit() && _connected) {
 
@@ -532,7 +536,8 @@ void UxrceddsClient::run()
 				}
 			}
 
-			/* Wait for topic updates for max 10 ms */
+			/* Wait for topic updates for max 10 ms, or until the pending output needs to be sent */
+			orb_poll_timeout_ms = _subs->flush_timeout_ms(hrt_absolute_time(), orb_poll_timeout_ms);
 			int poll = px4_poll(_subs->fds, (sizeof(_subs->fds) / sizeof(_subs->fds[0])), orb_poll_timeout_ms);
 
 			/* Handle the poll results */
@@ -551,6 +556,15 @@ void UxrceddsClient::run()
 				}
 			}
 
+			// Hold back the output until the packet is full or the flush deadline expires,
+			// unless there is input to process (running the session flushes the output streams).
+			if (bytes_available == 0 && _subs->hold_output(hrt_absolute_time())) {
+				perf_end(_loop_perf);
+				continue;
+			}
+
+			_subs->flush(&session);
+
 			// run session with 0 timeout (non-blocking)
 			uxr_run_session_timeout(&session, 0);
 
@@ -593,8 +607,13 @@ void UxrceddsClient::run()
 				float dt = (now - last_status_update) / 1e6f;
 				_last_payload_tx_rate = (_subs->num_payload_sent - last_num_payload_sent) / dt;
 				_last_payload_rx_rate = (_pubs->num_payload_received - last_num_payload_received) / dt;
+				_last_packet_tx_rate = (_subs->num_packets_sent - last_num_packets_sent) / dt;
+				const uint32_t bytes_sent = _subs->num_bytes_sent - last_num_bytes_sent;
+				_last_payload_tx_efficiency = (bytes_sent > 0) ? (float)(_subs->num_payload_sent - last_num_payload_sent) / bytes_sent : 0.f;
 				last_num_payload_sent = _subs->num_payload_sent;
 				last_num_payload_received = _pubs->num_payload_received;
+				last_num_packets_sent = _subs->num_packets_sent;
+				last_num_bytes_sent = _subs->num_bytes_sent;
 				last_status_update = now;
 			}
 
@@ -636,7 +655,9 @@ void UxrceddsClient::run()
 
 		uxr_delete_session_retries(&session, _connected ? 1 : 0);
 		_last_payload_tx_rate = 0;
-		_last_payload_tx_rate = 0;
+		_last_payload_rx_rate = 0;
+		_last_packet_tx_rate = 0;
+		_last_payload_tx_efficiency = 0.f;
 		_subs->reset();
 		_timesync.reset_filter();
 	}
@@ -865,6 +886,9 @@ int UxrceddsClient::print_status()
 	if (_connected) {
 		PX4_INFO("Payload tx:          %i B/s", _last_payload_tx_rate);
 		PX4_INFO("Payload rx:          %i B/s", _last_payload_rx_rate);
+		PX4_INFO("Packets tx:          %i /s", _last_packet_tx_rate);
+		PX4_INFO("Payload efficiency:  %.1f %% (tx, excluding transport framing)", (double)(_last_payload_tx_efficiency * 100.f));
+		PX4_INFO("Flush deadline:      %i ms", (int)_param_uxrce_dds_flush.get());
 	}
 
 	PX4_INFO("timesync converged: %s", _timesync.sync_converged() ? "true" : "false");
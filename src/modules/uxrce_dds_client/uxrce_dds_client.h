@@ -167,6 +167,8 @@ private:
 
 	int _last_payload_tx_rate{}; ///< in B/s
 	int _last_payload_rx_rate{}; ///< in B/s
+	int _last_packet_tx_rate{}; ///< in packets/s
+	float _last_payload_tx_efficiency{}; ///< payload bytes / sent bytes
 	bool _connected{false};
 
 	bool _timesync_converged{false};
@@ -178,6 +180,7 @@ private:
 
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::UXRCE_DDS_DOM_ID>) _param_uxrce_dds_dom_id,
+		(ParamInt<px4::params::UXRCE_DDS_FLUSH>) _param_uxrce_dds_flush,
 		(ParamInt<px4::params::UXRCE_DDS_KEY>) _param_uxrce_key,
 		(ParamInt<px4::params::UXRCE_DDS_PTCFG>) _param_uxrce_dds_ptcfg,
 		(ParamInt<px4::params::UXRCE_DDS_SYNCC>) _param_uxrce_dds_syncc,
@@ -42,18 +42,17 @@
 #pragma once
 
 #include "zenoh_publisher.hpp"
+#include <uorb_cdr.hpp>
 #include <uORB/Subscription.hpp>
 #include <dds_serializer.h>
 
-#define CDR_SAFETY_MARGIN 12
-
 class uORB_Zenoh_Publisher : public Zenoh_Publisher
 {
 public:
-	uORB_Zenoh_Publisher(const orb_metadata *meta, const uint32_t *ops) :
+	uORB_Zenoh_Publisher(const orb_metadata *meta, const UorbCdrSerializer &cdr) :
 		Zenoh_Publisher(true),
 		_uorb_meta{meta},
-		_cdr_ops(ops)
+		_cdr(cdr)
 	{
 		_uorb_sub = orb_subscribe(meta);
 	};
@@ -66,24 +65,12 @@ public:
 		uint8_t data[_uorb_meta->o_size];
 		orb_copy(_uorb_meta, _uorb_sub, data);
 
-		uint8_t buf[_uorb_meta->o_size + 4 + CDR_SAFETY_MARGIN];
+		// the generated serializer copies the fields in contiguous runs, no interpreter needed
+		uint8_t buf[sizeof(ros2_header) + _cdr.size];
 		memcpy(buf, ros2_header, sizeof(ros2_header));
+		const uint32_t len = _cdr.serialize(data, buf + sizeof(ros2_header));
 
-		dds_ostream_t os;
-		os.m_buffer = buf;
-		os.m_index = (uint32_t)sizeof(ros2_header);
-		os.m_size = (uint32_t)sizeof(ros2_header) + _uorb_meta->o_size + CDR_SAFETY_MARGIN;
-		os.m_xcdr_version = DDSI_RTPS_CDR_ENC_VERSION_2;
-
-		if (dds_stream_write(&os,
-				     &dds_allocator,
-				     (const char *)&data,
-				     _cdr_ops)) {
-			return publish((const uint8_t *)buf, os.m_size);
-
-		} else {
-			return _Z_ERR_MESSAGE_SERIALIZATION_FAILED;
-		}
+		return publish((const uint8_t *)buf, sizeof(ros2_header) + len);
 	};
 
 	void setPollFD(px4_pollfd_struct_t *pfd)
@@ -101,5 +88,5 @@ public:
 private:
 	const orb_metadata *_uorb_meta;
 	int _uorb_sub;
-	const uint32_t *_cdr_ops;
+	const UorbCdrSerializer _cdr;
 };
@@ -42,6 +42,7 @@
 #pragma once
 
 #include "zenoh_subscriber.hpp"
+#include <uorb_cdr.hpp>
 #include <uORB/topics/input_rc.h>
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/topics/actuator_outputs.h>
@@ -49,10 +50,10 @@
 class uORB_Zenoh_Subscriber : public Zenoh_Subscriber
 {
 public:
-	uORB_Zenoh_Subscriber(const orb_metadata *meta, const uint32_t *ops) :
+	uORB_Zenoh_Subscriber(const orb_metadata *meta, const UorbCdrSerializer &cdr) :
 		Zenoh_Subscriber(true),
 		_uorb_meta{meta},
-		_cdr_ops(ops)
+		_cdr(cdr)
 	{
 		int instance = 0;
 		_uorb_pub_handle = orb_advertise_multi(_uorb_meta, nullptr, &instance);
@@ -64,11 +65,13 @@ public:
 	void data_handler(const z_sample_t *sample)
 	{
 		char data[_uorb_meta->o_size];
+		memset(data, 0, sizeof(data));
 
-		dds_istream_t is = {.m_buffer = (unsigned char *)(sample->payload.start), .m_size = static_cast<int>(sample->payload.len),
-				    .m_index = 4, .m_xcdr_version = DDSI_RTPS_CDR_ENC_VERSION_2
-				   };
-		dds_stream_read(&is, data, &dds_allocator, _cdr_ops);
+		// skip the 4 byte encapsulation header
+		if (sample->payload.len < 4
+		    || !_cdr.deserialize((const uint8_t *)sample->payload.start + 4, sample->payload.len - 4, data)) {
+			return;
+		}
 
 		// As long as we don't have timesynchronization between Zenoh nodes
 		// we've to manually set the timestamp
@@ -103,5 +106,5 @@ protected:
 private:
 	const orb_metadata *_uorb_meta;
 	orb_advert_t _uorb_pub_handle;
-	const uint32_t *_cdr_ops;
+	const UorbCdrSerializer _cdr;
 };
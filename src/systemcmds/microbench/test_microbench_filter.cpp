@@ -0,0 +1,173 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_microbench_filter.cpp
+ * Microbenchmarks for the gyro notch filter cascade.
+ */
+
+#include <unit_test.h>
+
+#include <stdlib.h>
+
+#include <drivers/drv_hrt.h>
+#include <lib/mathlib/math/filter/NotchFilter.hpp>
+#include <lib/mathlib/math/filter/NotchFilterBank.hpp>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+namespace MicroBenchFilter
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			lock(); \
+			perf_begin(p); \
+			for (int i = 0; i < (count)/10; i++) { \
+				op; \
+			} \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		perf_print_counter(p); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchFilter : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_notch_filter_cascade();
+
+	void reset();
+
+	void applySeparately(int stages);
+	void applyBank(int stages);
+
+	// 8 ESCs x 3 harmonics, 3 FFT peaks and the 2 static notch filters, as in VehicleAngularVelocity
+	static constexpr int STAGES_MAX = 8 * 3 + 3 + 2;
+	static constexpr int SAMPLES = 8; // 8 kHz gyro FIFO read at 1 kHz
+
+	math::NotchFilter<float> _filters[3][STAGES_MAX] {};
+	math::NotchFilterBank _bank{};
+
+	float _data[3][SAMPLES] {};
+	float *_data_array[3] {_data[0], _data[1], _data[2]};
+};
+
+bool MicroBenchFilter::run_tests()
+{
+	_bank.reserve(STAGES_MAX);
+
+	for (int axis = 0; axis < 3; axis++) {
+		for (int stage = 0; stage < STAGES_MAX; stage++) {
+			_filters[axis][stage].setParameters(8000.f, 80.f + stage * 40.f + axis, 20.f);
+		}
+	}
+
+	ut_run_test(time_notch_filter_cascade);
+
+	return (_tests_failed == 0);
+}
+
+void MicroBenchFilter::reset()
+{
+	for (int axis = 0; axis < 3; axis++) {
+		for (int n = 0; n < SAMPLES; n++) {
+			_data[axis][n] = (rand() / (float)RAND_MAX - 0.5f) * 10.f;
+		}
+	}
+}
+
+void MicroBenchFilter::applySeparately(int stages)
+{
+	for (int axis = 0; axis < 3; axis++) {
+		for (int stage = 0; stage < stages; stage++) {
+			_filters[axis][stage].applyArray(_data[axis], SAMPLES);
+		}
+	}
+}
+
+void MicroBenchFilter::applyBank(int stages)
+{
+	_bank.clear();
+
+	for (int axis = 0; axis < 3; axis++) {
+		for (int stage = 0; stage < stages; stage++) {
+			_bank.add(axis, _filters[axis][stage]);
+		}
+	}
+
+	_bank.applyArray(_data_array, SAMPLES);
+}
+
+ut_declare_test_c(test_microbench_filter, MicroBenchFilter)
+
+bool MicroBenchFilter::time_notch_filter_cascade()
+{
+	PERF("notch 3x2 stages x 8 samples, separate (1k ops)", applySeparately(2), 1000);
+	PERF("notch 3x2 stages x 8 samples, bank (1k ops)", applyBank(2), 1000);
+
+	PERF("notch 3x29 stages x 8 samples, separate (1k ops)", applySeparately(STAGES_MAX), 1000);
+	PERF("notch 3x29 stages x 8 samples, bank (1k ops)", applyBank(STAGES_MAX), 1000);
+
+	return true;
+}
+
+} // namespace MicroBenchFilter
@@ -99,6 +99,9 @@ private:
 	bool time_matrix_quaternion();
 	bool time_matrix_dcm();
 	bool time_matrix_pseduo_inverse();
+	bool time_matrix_multiply();
+	bool time_matrix_transpose();
+	bool time_matrix_inverse();
 
 	void reset();
 
@@ -108,6 +111,18 @@ private:
 	matrix::Matrix<float, 16, 6> A16;
 	matrix::Matrix<float, 6, 16> B16;
 	matrix::Matrix<float, 6, 16> B16_4;
+
+	matrix::SquareMatrix<float, 3> M3;
+	matrix::SquareMatrix<float, 4> M4;
+	matrix::SquareMatrix<float, 6> M6;
+	matrix::SquareMatrix<float, 24> M24;
+	matrix::Matrix<float, 24, 6> M24_6;
+	matrix::SquareMatrix<float, 3> R3;
+	matrix::SquareMatrix<float, 4> R4;
+	matrix::SquareMatrix<float, 6> R6;
+	matrix::SquareMatrix<float, 24> R24;
+	matrix::Matrix<float, 24, 6> R24_6;
+	matrix::Matrix<float, 6, 24> R6_24;
 };
 
 bool MicroBenchMatrix::run_tests()
@@ -116,6 +131,9 @@ bool MicroBenchMatrix::run_tests()
 	ut_run_test(time_matrix_quaternion);
 	ut_run_test(time_matrix_dcm);
 	ut_run_test(time_matrix_pseduo_inverse);
+	ut_run_test(time_matrix_multiply);
+	ut_run_test(time_matrix_transpose);
+	ut_run_test(time_matrix_inverse);
 
 	return (_tests_failed == 0);
 }
@@ -145,6 +163,29 @@ void MicroBenchMatrix::reset()
 			B16_4(j, i) = random(-10.0, 10.0);
 		}
 	}
+
+	// diagonally dominant square matrices, so that they can be inverted
+	for (size_t i = 0; i < 24; i++) {
+		for (size_t j = 0; j < 24; j++) {
+			M24(i, j) = random(-1.0, 1.0) + ((i == j) ? 24.0 : 0.0);
+
+			if (i < 3 && j < 3) {
+				M3(i, j) = M24(i, j);
+			}
+
+			if (i < 4 && j < 4) {
+				M4(i, j) = M24(i, j);
+			}
+
+			if (i < 6 && j < 6) {
+				M6(i, j) = M24(i, j);
+			}
+
+			if (j < 6) {
+				M24_6(i, j) = random(-1.0, 1.0);
+			}
+		}
+	}
 }
 
 bool MicroBenchMatrix::time_matrix_euler()
@@ -175,6 +216,36 @@ bool MicroBenchMatrix::time_matrix_pseduo_inverse()
 	return true;
 }
 
+bool MicroBenchMatrix::time_matrix_multiply()
+{
+	PERF("matrix 3x3 * 3x3", R3 = M3 * M3, 1000);
+	PERF("matrix 4x4 * 4x4", R4 = M4 * M4, 1000);
+	PERF("matrix 6x6 * 6x6", R6 = M6 * M6, 1000);
+	PERF("matrix 24x24 * 24x24", R24 = M24 * M24, 1000);
+	PERF("matrix 24x24 * 24x6", R24_6 = M24 * M24_6, 1000);
+	PERF("matrix 24x24 * (24x24)^T", R24 = M24.multiplyByTranspose(M24), 1000);
+	return true;
+}
+
+bool MicroBenchMatrix::time_matrix_transpose()
+{
+	PERF("matrix 3x3 transpose", R3 = M3.transpose(), 1000);
+	PERF("matrix 4x4 transpose", R4 = M4.transpose(), 1000);
+	PERF("matrix 6x6 transpose", R6 = M6.transpose(), 1000);
+	PERF("matrix 24x24 transpose", R24 = M24.transpose(), 1000);
+	PERF("matrix 24x6 transpose", R6_24 = M24_6.transpose(), 1000);
+	return true;
+}
+
+bool MicroBenchMatrix::time_matrix_inverse()
+{
+	PERF("matrix 3x3 inverse", matrix::inv(M3, R3), 1000);
+	PERF("matrix 4x4 inverse", matrix::inv(M4, R4), 1000);
+	PERF("matrix 6x6 inverse", matrix::inv(M6, R6), 1000);
+	PERF("matrix 24x24 inverse", matrix::inv(M24, R24), 100);
+	return true;
+}
+
 ut_declare_test_c(test_microbench_matrix, MicroBenchMatrix)
 
 } // namespace MicroBenchMatrix
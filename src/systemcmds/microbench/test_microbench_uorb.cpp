@@ -47,12 +47,21 @@
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/micro_hal.h>
 
+#include <px4_platform_common/atomic.h>
+
+#include <uORB/PublicationMulti.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/topics/uORBTopics.hpp>
 #include <uORB/topics/sensor_accel.h>
 #include <uORB/topics/sensor_gyro.h>
 #include <uORB/topics/sensor_gyro_fifo.h>
 #include <uORB/topics/vehicle_local_position.h>
 #include <uORB/topics/failsafe_flags.h>
+#include <uORB/topics/orb_test_medium.h>
+
+#if defined(__PX4_POSIX)
+#include <pthread.h>
+#endif
 
 namespace MicroBenchORB
 {
@@ -102,6 +111,8 @@ private:
 
 	bool time_px4_uorb();
 	bool time_px4_uorb_direct();
+	bool time_px4_uorb_lookup();
+	bool time_px4_uorb_contention();
 
 	void reset();
 
@@ -115,6 +126,8 @@ bool MicroBenchORB::run_tests()
 {
 	ut_run_test(time_px4_uorb);
 	ut_run_test(time_px4_uorb_direct);
+	ut_run_test(time_px4_uorb_lookup);
+	ut_run_test(time_px4_uorb_contention);
 
 	return (_tests_failed == 0);
 }
@@ -246,4 +259,136 @@ bool MicroBenchORB::time_px4_uorb_direct()
 	return true;
 }
 
+bool MicroBenchORB::time_px4_uorb_lookup()
+{
+	// node lookup cost (advertise, subscribe, orb_exists) against the number of topics in use
+	const orb_metadata *const *topics = orb_get_topics();
+	static constexpr size_t topic_counts[] {8, 32, 128, ORB_TOPICS_COUNT};
+
+	for (size_t count : topic_counts) {
+		if (count > ORB_TOPICS_COUNT) {
+			continue;
+		}
+
+		char name_subscribe[48];
+		char name_exists[48];
+		char name_sub_direct[48];
+		snprintf(name_subscribe, sizeof(name_subscribe), "orb_subscribe %zu topics", count);
+		snprintf(name_exists, sizeof(name_exists), "orb_exists %zu topics", count);
+		snprintf(name_sub_direct, sizeof(name_sub_direct), "uORB::Subscription subscribe %zu topics", count);
+
+		perf_counter_t p_subscribe = perf_alloc(PC_ELAPSED, name_subscribe);
+		perf_counter_t p_exists = perf_alloc(PC_ELAPSED, name_exists);
+		perf_counter_t p_sub_direct = perf_alloc(PC_ELAPSED, name_sub_direct);
+
+		for (size_t i = 0; i < count; i++) {
+			// orb_subscribe goes through DeviceMaster::advertise() and creates the node if necessary
+			lock();
+			perf_begin(p_subscribe);
+			int fd = orb_subscribe(topics[i]);
+			perf_end(p_subscribe);
+			unlock();
+
+			lock();
+			perf_begin(p_exists);
+			orb_exists(topics[i], 0);
+			perf_end(p_exists);
+			unlock();
+
+			uORB::Subscription sub{topics[i]};
+			lock();
+			perf_begin(p_sub_direct);
+			sub.subscribe();
+			perf_end(p_sub_direct);
+			unlock();
+
+			sub.unsubscribe();
+
+			if (fd >= 0) {
+				orb_unsubscribe(fd);
+			}
+		}
+
+		perf_print_counter(p_subscribe);
+		perf_print_counter(p_exists);
+		perf_print_counter(p_sub_direct);
+		printf("\n");
+
+		perf_free(p_subscribe);
+		perf_free(p_exists);
+		perf_free(p_sub_direct);
+	}
+
+	return true;
+}
+
+#if defined(__PX4_POSIX)
+struct ContentionReader {
+	pthread_t thread;
+	px4::atomic<bool> *running;
+	uint8_t instance;
+	unsigned copies;
+};
+
+static void *contention_reader_run(void *arg)
+{
+	ContentionReader *reader = static_cast<ContentionReader *>(arg);
+	uORB::Subscription sub{ORB_ID(orb_test_medium_multi), reader->instance};
+	orb_test_medium_s data{};
+
+	while (reader->running->load()) {
+		if (sub.copy(&data)) {
+			reader->copies++;
+		}
+	}
+
+	return nullptr;
+}
+#endif // __PX4_POSIX
+
+bool MicroBenchORB::time_px4_uorb_contention()
+{
+#if defined(__PX4_POSIX)
+	// publication latency with an increasing number of readers continuously copying the same topic
+	uORB::PublicationMulti<orb_test_medium_s> pub{ORB_ID(orb_test_medium_multi)};
+	orb_test_medium_s data{};
+	pub.publish(data);
+
+	const int instance = pub.get_instance();
+	ut_assert_true(instance >= 0);
+
+	static constexpr int reader_counts[] {1, 2, 4, 8, 16};
+	ContentionReader readers[16] {};
+
+	for (int num_readers : reader_counts) {
+		px4::atomic<bool> running{true};
+
+		for (int i = 0; i < num_readers; i++) {
+			readers[i].running = &running;
+			readers[i].instance = instance;
+			readers[i].copies = 0;
+			pthread_create(&readers[i].thread, nullptr, contention_reader_run, &readers[i]);
+		}
+
+		char name[48];
+		snprintf(name, sizeof(name), "uORB publish %d readers", num_readers);
+		PERF(name, data.val++; pub.publish(data), 1000);
+
+		running.store(false);
+
+		unsigned copies = 0;
+
+		for (int i = 0; i < num_readers; i++) {
+			pthread_join(readers[i].thread, nullptr);
+			copies += readers[i].copies;
+		}
+
+		printf("%d readers: %u copies\n\n", num_readers, copies);
+	}
+
+#endif // __PX4_POSIX
+
+	return true;
+}
+
 } // namespace MicroBenchORB
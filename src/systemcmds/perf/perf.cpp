@@ -48,6 +48,7 @@ static void print_usage()
 	PRINT_MODULE_USAGE_NAME_SIMPLE("perf", "command");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("reset", "Reset all counters");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("latency", "Print HRT timer latency histogram");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("histogram", "Print the buckets of all histogram counters");
 
 	PRINT_MODULE_USAGE_PARAM_COMMENT("Prints all performance counters if no arguments given");
 }
@@ -63,6 +64,11 @@ extern "C" __EXPORT int perf_main(int argc, char *argv[])
 			perf_print_latency();
 			fflush(stdout);
 			return 0;
+
+		} else if (strcmp(argv[1], "histogram") == 0) {
+			perf_iterate_all([](perf_counter_t handle, void *user) { perf_print_histogram(handle); }, nullptr);
+			fflush(stdout);
+			return 0;
 		}
 
 		print_usage();
@@ -52,6 +52,7 @@ public:
 	bool test_push_duplicate();
 	bool test_remove();
 	bool test_reinsert();
+	bool test_insert_sorted();
 
 };
 
@@ -62,6 +63,7 @@ bool IntrusiveQueueTest::run_tests()
 	ut_run_test(test_push_duplicate);
 	ut_run_test(test_remove);
 	ut_run_test(test_reinsert);
+	ut_run_test(test_insert_sorted);
 
 	return (_tests_failed == 0);
 }
@@ -383,4 +385,45 @@ bool IntrusiveQueueTest::test_reinsert()
 	return true;
 }
 
+bool IntrusiveQueueTest::test_insert_sorted()
+{
+	IntrusiveQueue<testContainer *> q1;
+
+	auto after = [](const testContainer * a, const testContainer * b) { return a->i > b->i; };
+
+	// insert 0, 10, 20, ... 90 in reverse order, then 5, 15, ... 95 (twice each)
+	for (int i = 9; i >= 0; i--) {
+		testContainer *t = new testContainer();
+		t->i = i * 10;
+		ut_assert_true(q1.insert_sorted(t, after));
+	}
+
+	for (int k = 0; k < 2; k++) {
+		for (int i = 0; i < 10; i++) {
+			testContainer *t = new testContainer();
+			t->i = i * 10 + 5;
+			ut_assert_true(q1.insert_sorted(t, after));
+
+			// already queued
+			ut_assert_false(q1.insert_sorted(t, after));
+		}
+	}
+
+	ut_compare("size 30", q1.size(), 30);
+
+	// verify ascending order
+	int last = -1;
+
+	while (!q1.empty()) {
+		auto t = q1.pop();
+		ut_assert_true(t->i >= last);
+		last = t->i;
+		delete t;
+	}
+
+	ut_assert_true(q1.empty());
+
+	return true;
+}
+
 ut_declare_test_c(test_IntrusiveQueue, IntrusiveQueueTest)
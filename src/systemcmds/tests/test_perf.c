@@ -69,5 +69,28 @@ test_perf(int argc, char *argv[])
 	perf_free(cc);
 	perf_free(ec);
 
+	perf_counter_t hc = perf_alloc(PC_HISTOGRAM, "test_histogram");
+
+	if (hc == NULL) {
+		printf("perf: histogram alloc failed\n");
+		return 1;
+	}
+
+	for (int i = 0; i < 1000; i++) {
+		perf_set_elapsed(hc, (i < 990) ? 100 : 5000);
+	}
+
+	if (perf_event_count(hc) != 1000) {
+		printf("perf: histogram count %u, expected 1000\n", (unsigned)perf_event_count(hc));
+		perf_free(hc);
+		return 1;
+	}
+
+	printf("perf: expect p50 ~100us, p99.9 and max 5000us\n");
+	perf_print_counter(hc);
+	perf_print_histogram(hc);
+
+	perf_free(hc);
+
 	return OK;
 }
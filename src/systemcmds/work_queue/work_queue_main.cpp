@@ -34,8 +34,12 @@
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
 #include <px4_platform_common/px4_work_queue/WorkQueueManager.hpp>
 
+#include <stdint.h>
+#include <stdlib.h>
+
 static void	usage();
 
 extern "C" {
@@ -45,11 +49,28 @@ extern "C" {
 int
 work_queue_main(int argc, char *argv[])
 {
-	if (argc != 2) {
+	if (argc < 2) {
 		usage();
 		return 1;
 	}
 
+	if (!strcmp(argv[1], "affinity")) {
+		if (argc != 4) {
+			usage();
+			return 1;
+		}
+
+		char *end = nullptr;
+		const unsigned long cpu_mask = strtoul(argv[3], &end, 0);
+
+		if ((end == argv[3]) || (*end != '\0') || (cpu_mask > UINT32_MAX)) {
+			PX4_ERR("invalid CPU mask %s", argv[3]);
+			return 1;
+		}
+
+		return (px4::WorkQueueManagerSetAffinity(argv[2], cpu_mask) == PX4_OK) ? 0 : 1;
+	}
+
 	if (!strcmp(argv[1], "start")) {
 		px4::WorkQueueManagerStart();
 		return 0;
@@ -78,9 +99,17 @@ usage()
 
 Command-line tool to show work queue status.
 
+On Linux the status includes the CPU core each work queue thread last ran on and the number of migrations
+between cores. The work queue threads can be pinned to a set of cores, for example to move the rate
+controller onto an isolated core:
+$ work_queue affinity wq:rate_ctrl 0x8
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("work_queue", "system");
 	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("affinity", "Pin a work queue to CPU cores (Linux only)");
+	PRINT_MODULE_USAGE_ARG("<wq>", "Work queue name (eg wq:rate_ctrl)", false);
+	PRINT_MODULE_USAGE_ARG("<mask>", "Bitmask of CPU cores, 0 to restore the default", false);
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 }